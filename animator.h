@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Animated floats, moved toward their targets by elapsed time
+//
+// Ease closes a fixed fraction of the gap per second. Its rate is given as
+// the fraction closed per 60 Hz frame, the way the app's fades were tuned
+// when they stepped once per frame, so they look the same as before at
+// 60 Hz and take the same time at any other refresh rate. Spring is a
+// critically damped spring that carries velocity, for motion that should
+// pick up speed from rest; its rate is the angular frequency in 1/s. Both
+// are stepped exactly, so a long frame lands where several short ones
+// would.
+//
+// Values live in parallel arrays and Update() steps them all in one
+// branch-free pass; an ease is a spring whose velocity is never fed in.
+// A value closer to its target than its settle distance snaps to it.
+// Settled() is true once nothing is moving, so the caller can stop drawing.
+class Animator {
+public:
+    using Handle = uint32_t;
+    enum class Curve { Ease, Spring };
+
+private:
+    std::vector<float> values;
+    std::vector<float> targets;
+    std::vector<float> velocities;
+    std::vector<float> decays;    // 1/s: the ease rate, or the spring's frequency
+    std::vector<float> springs;   // 1 for springs, 0 for eases
+    std::vector<float> settles;   // snap distance
+    bool moving{ false };
+
+public:
+    // Ease rate from the fraction of the gap one 60 Hz frame closed
+    static float EaseRate(float fractionPer60HzFrame) {
+        return -logf(1.0f - fractionPer60HzFrame) * 60.0f;
+    }
+
+    Handle Add(float value, Curve curve, float rate, float settle = 1.0f / 512.0f) {
+        values.push_back(value);
+        targets.push_back(value);
+        velocities.push_back(0.0f);
+        decays.push_back(curve == Curve::Ease ? EaseRate(rate) : rate);
+        springs.push_back(curve == Curve::Spring ? 1.0f : 0.0f);
+        settles.push_back(settle);
+        return (Handle)(values.size() - 1);
+    }
+
+    void SetTarget(Handle handle, float target) {
+        targets[handle] = target;
+        moving |= values[handle] != target;
+    }
+
+    // Jumps to value and stops there
+    void Set(Handle handle, float value) {
+        values[handle] = targets[handle] = value;
+        velocities[handle] = 0.0f;
+    }
+
+    float Value(Handle handle) const { return values[handle]; }
+    float Target(Handle handle) const { return targets[handle]; }
+
+    // Sets the target and returns where the value is this frame
+    float Toward(Handle handle, float target) {
+        SetTarget(handle, target);
+        return values[handle];
+    }
+
+    // Steps every value dt seconds; true while any is still moving
+    bool Update(float dt) {
+        if (!moving) return false;
+        const size_t count = values.size();
+        float* value = values.data();
+        float* velocity = velocities.data();
+        const float* target = targets.data();
+        const float* decay = decays.data();
+        const float* spring = springs.data();
+        const float* settle = settles.data();
+
+        int active = 0;
+        for (size_t i = 0; i < count; i++) {
+            const float x = value[i] - target[i];
+            const float v = velocity[i];
+            const float w = decay[i];
+            const float e = expf(-w * dt);
+            const float carried = spring[i] * (v + w * x) * dt;
+            const float x1 = (x + carried) * e;
+            const float v1 = (v - w * carried) * e;
+            const bool done = fabsf(x1) < settle[i] && fabsf(v1) * dt < settle[i];
+            value[i] = done ? target[i] : target[i] + x1;
+            velocity[i] = done ? 0.0f : v1;
+            active += !done;
+        }
+        moving = active > 0;
+        return moving;
+    }
+
+    bool Settled() const { return !moving; }
+    size_t Size() const { return values.size(); }
+};
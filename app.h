@@ -0,0 +1,1501 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "imgui.h"
+#include "animator.h"
+#include "frame_scheduler.h"
+#include "image_cache.h"
+#include "platform.h"
+#include "sim_clock.h"
+#include "texture_loader.h"
+#include "texture_registry.h"
+#include "thread_pool.h"
+
+// Color palette
+namespace Colors {
+    constexpr ImVec4 Background{ 0.0f, 0.0f, 0.0f, 1.0f };
+    constexpr ImVec4 Primary{ 1.0f, 1.0f, 1.0f, 1.0f };
+    constexpr ImVec4 Secondary{ 0.55f, 0.55f, 0.55f, 1.0f };
+    constexpr ImVec4 Red{ 0.90f, 0.20f, 0.20f, 1.0f };
+
+    constexpr ImVec4 ButtonBg{ 14.0f / 255.0f, 14.0f / 255.0f, 14.0f / 255.0f, 1.0f };
+    constexpr ImVec4 ButtonBorder{ 21.0f / 255.0f, 21.0f / 255.0f, 21.0f / 255.0f, 1.0f };
+    constexpr ImVec4 ButtonText{ 1.0f, 1.0f, 1.0f, 1.0f };
+    constexpr ImVec4 ButtonHover{ 16.0f / 255.0f, 16.0f / 255.0f, 16.0f / 255.0f, 1.0f };
+
+    constexpr ImVec4 InputBg{ 11.0f / 255.0f, 11.0f / 255.0f, 11.0f / 255.0f, 1.0f };
+    constexpr ImVec4 InputBorder{ 18.0f / 255.0f, 18.0f / 255.0f, 18.0f / 255.0f, 1.0f };
+    constexpr ImVec4 InputBorderActive{ 25.0f / 255.0f, 25.0f / 255.0f, 25.0f / 255.0f, 1.0f };
+
+    constexpr ImVec4 LinkText{ 0.60f, 0.60f, 0.60f, 1.0f };
+    constexpr ImVec4 LinkHover{ 0.80f, 0.80f, 0.80f, 1.0f };
+}
+
+// Main application: the login, loading and menu pages. Everything OS or
+// GPU specific goes through IPlatform and IRenderer.
+class ImGuiApp {
+public:
+    // The menu page's window; no page is larger
+    static constexpr int LargestWindowWidth = 600;
+    static constexpr int LargestWindowHeight = 400;
+
+private:
+    static constexpr uint64_t ImageCacheBudget = 64ull << 20;
+    // GPU memory textures nothing references may keep before the oldest go
+    static constexpr uint64_t TextureBudget = 64ull << 20;
+    // Largest area the background is drawn over (the 600x400 main window)
+    static constexpr int BackgroundCoverWidth = 600;
+    static constexpr int BackgroundCoverHeight = 400;
+    // Drawn where the background goes until it has loaded
+    static constexpr ImU32 BackgroundPlaceholder = IM_COL32(14, 14, 14, 255);
+    // Pre-blurred copies for frosted panels, light to heavy, in pixels of the
+    // covered size
+    static constexpr float BackgroundBlurSigmas[] = { 4.0f, 12.0f };
+    // Redraws a focused text field often enough for its caret to blink
+    static constexpr double CaretBlinkInterval = 0.2;
+    // ImGui asserts on a zero step, which a Manual clock can take
+    static constexpr float MinimumDeltaTime = 1e-6f;
+    // Loading page: the spinner shows after the delay, the menu after the duration
+    static constexpr double LoadingContentDelay = 0.3;
+    static constexpr double LoadingDuration = 2.5;
+    // Launch notification: each stage fades in, holds and fades out
+    static constexpr int InjectionStageCount = 4;
+    static constexpr double InjectionStageDuration = 1.5;
+    static constexpr double InjectionFadeDuration = 0.2;
+
+    IPlatform& platform;
+    IRenderer& renderer;
+    ThreadPool workerPool;
+    ImageCache imageCache;
+    AsyncTextureLoader textureLoader{ workerPool, &imageCache };
+    TextureRegistry textures{ TextureBudget, [this](void* texture) { renderer.ReleaseTexture(texture); } };
+    FrameScheduler scheduler;
+    SimClock clock;
+    // Fades and slides, at the fraction per 60 Hz frame they were tuned at
+    Animator animator;
+    const Animator::Handle forgotPasswordHover{ animator.Add(0.0f, Animator::Curve::Ease, 0.10f) };
+    const Animator::Handle loginButtonHover{ animator.Add(0.0f, Animator::Curve::Ease, 0.10f) };
+    const Animator::Handle loadingContentFade{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    const Animator::Handle logoutHover{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    const Animator::Handle productsHover{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    const Animator::Handle updatesHover{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    const Animator::Handle viewButton1Hover{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    const Animator::Handle viewButton2Hover{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    const Animator::Handle launchButtonHover{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    const Animator::Handle backButtonHover{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    const Animator::Handle notificationSlide{ animator.Add(0.0f, Animator::Curve::Ease, 0.15f) };
+    // whole pixels are all the window can show, so it settles within half of one
+    const Animator::Handle windowWidth{ animator.Add(400.0f, Animator::Curve::Ease, 0.08f, 0.5f) };
+    std::array<char, 256> username{};
+    std::array<char, 256> password{};
+    bool isDragging{ false };
+    ScreenPoint dragOffset{};
+    ImFont* boldFont{ nullptr };
+    ImFont* mediumFont{ nullptr };
+    ImFont* iconFont{ nullptr };
+    ImFont* exitIconFont{ nullptr };
+    ImFont* interMedium{ nullptr };
+    bool isLoading{ false };
+    bool showMenu{ false };
+    float loadingRotation{ 0.0f };
+    float targetWindowWidth{ 400.0f };
+    double loadingStartTime{ 0.0 };
+    float menuFadeAlpha{ 0.0f };
+    int selectedMenuItem{ 0 };
+    TextureHandle bgHandle{ 0 };
+    TextureRef bgTexture;
+    std::array<TextureRef, std::size(BackgroundBlurSigmas)> bgBlurred;
+    int bgWidth{ 0 };
+    int bgHeight{ 0 };
+    int selectedProductIndex{ -1 };
+    bool showLaunchNotification{ false };
+    float launchNotificationAlpha{ 0.0f };
+    double launchNotificationStartTime{ 0.0 };
+    int injectionStage{ 0 };
+    int previousInjectionStage{ -1 };
+    double stageStartTime{ 0.0 };
+
+    void DrawTexture(ImDrawList* drawList, const TextureRef& texture, const ImVec2& min, const ImVec2& max, const ImVec2& uvMin, const ImVec2& uvMax,
+        float alpha = 1.0f) {
+        if (texture.Premultiplied()) {
+            renderer.AddImagePremultiplied(drawList, texture.Get(), min, max, uvMin, uvMax, alpha);
+        }
+        else {
+            drawList->AddImage(texture.Get(), min, max, uvMin, uvMax, IM_COL32(255, 255, 255, (int)(255 * alpha)));
+        }
+    }
+
+    void DrawBackgroundImage(ImDrawList* drawList, const ImVec2& min, const ImVec2& max, const ImVec2& uvMin, const ImVec2& uvMax, float alpha = 1.0f) {
+        DrawTexture(drawList, bgTexture, min, max, uvMin, uvMax, alpha);
+    }
+
+    // Crossfades from the light blur to the heavy one by frost, keeping the
+    // panel's coverage at alpha: the heavy layer goes over the light one with
+    // alpha * frost, and the light one is raised to make up what it hides.
+    // Variants still loading draw the sharp background instead.
+    void DrawFrostedBackground(ImDrawList* drawList, const ImVec2& min, const ImVec2& max, const ImVec2& uvMin, const ImVec2& uvMax,
+        float alpha, float frost) {
+        const TextureRef& light = bgBlurred.front() ? bgBlurred.front() : bgTexture;
+        const TextureRef& heavy = bgBlurred.back() ? bgBlurred.back() : light;
+        const float heavyAlpha = alpha * frost;
+        const float lightAlpha = heavyAlpha < 1.0f ? alpha * (1.0f - frost) / (1.0f - heavyAlpha) : 0.0f;
+        if (lightAlpha > 0.0f) DrawTexture(drawList, light, min, max, uvMin, uvMax, lightAlpha);
+        if (heavyAlpha > 0.0f) DrawTexture(drawList, heavy, min, max, uvMin, uvMax, heavyAlpha);
+    }
+
+    void DrawBackgroundPlaceholder(ImDrawList* drawList, const ImVec2& min, const ImVec2& max, float alpha = 1.0f) {
+        const AsyncTextureLoader::Info* info = textureLoader.Find(bgHandle);
+        const ImU32 color = info ? info->placeholderColor : BackgroundPlaceholder;
+        const int a = (int)(((color >> IM_COL32_A_SHIFT) & 0xFF) * alpha);
+        drawList->AddRectFilled(min, max, (color & ~IM_COL32_A_MASK) | ((ImU32)a << IM_COL32_A_SHIFT));
+    }
+
+    void ApplyStyle() {
+        ImGuiStyle& style = ImGui::GetStyle();
+
+        style.WindowRounding = 0.0f;
+        style.FrameRounding = 5.0f;
+        style.ScrollbarRounding = 0.0f;
+        style.GrabRounding = 4.0f;
+
+        style.FramePadding = ImVec2(14.0f, 10.0f);
+        style.ItemSpacing = ImVec2(8.0f, 8.0f);
+        style.WindowPadding = ImVec2(0.0f, 0.0f);
+
+        style.WindowBorderSize = 0.0f;
+        style.FrameBorderSize = 1.0f;
+
+        ImVec4* colors = style.Colors;
+        colors[ImGuiCol_WindowBg] = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+        colors[ImGuiCol_FrameBg] = Colors::InputBg;
+        colors[ImGuiCol_FrameBgHovered] = Colors::InputBg;
+        colors[ImGuiCol_FrameBgActive] = Colors::InputBg;
+        colors[ImGuiCol_Border] = Colors::InputBorder;
+        colors[ImGuiCol_BorderShadow] = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+        colors[ImGuiCol_Text] = Colors::Primary;
+        colors[ImGuiCol_TextSelectedBg] = Colors::InputBg;
+        colors[ImGuiCol_TextDisabled] = Colors::Secondary;
+        colors[ImGuiCol_Button] = Colors::ButtonBg;
+        colors[ImGuiCol_ButtonHovered] = Colors::ButtonHover;
+        colors[ImGuiCol_ButtonActive] = Colors::ButtonBg;
+    }
+
+public:
+    // Animations and timers run on a SimClock; Real follows the platform's time
+    ImGuiApp(IPlatform& platform, IRenderer& renderer, SimClock::Options clockOptions = {})
+        : platform(platform), renderer(renderer), clock(clockOptions) {}
+
+    bool Initialize() {
+        IMGUI_CHECKVERSION();
+        ImGui::CreateContext();
+        if (!platform.Initialize("MEHDIFFER", 400, 400) || !renderer.Initialize(platform)) {
+            Cleanup();
+            return false;
+        }
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+        io.IniFilename = nullptr;
+
+        io.Fonts->AddFontFromFileTTF(platform.SystemFontPath("segoeui.ttf").c_str(), 16.0f);
+        mediumFont = io.Fonts->AddFontFromFileTTF(platform.SystemFontPath("segoeuib.ttf").c_str(), 21.0f);
+        boldFont = io.Fonts->AddFontFromFileTTF(platform.SystemFontPath("segoeuib.ttf").c_str(), 38.0f);
+
+        std::string iconPath = platform.AssetPath("icons.ttf");
+        ImFontConfig config;
+        config.MergeMode = false;
+        config.GlyphMinAdvanceX = 13.0f;
+        iconFont = io.Fonts->AddFontFromFileTTF(iconPath.c_str(), 13.0f, &config, NULL);
+        if (iconFont) {
+            platform.Log("Drip Icons (menu) loaded\n");
+        }
+        else {
+            platform.Log("Failed to load Drip Icons (menu)\n");
+        }
+
+        ImFontConfig exitConfig;
+        exitConfig.MergeMode = false;
+        exitConfig.GlyphMinAdvanceX = 18.0f;
+        exitIconFont = io.Fonts->AddFontFromFileTTF(iconPath.c_str(), 18.0f, &exitConfig, NULL);
+        if (exitIconFont) {
+            platform.Log("Drip Icons (exit) loaded\n");
+        }
+        else {
+            platform.Log("Failed to load Drip Icons (exit)\n");
+        }
+
+        std::string interPath = platform.AssetPath("Inter-Medium.ttf");
+        interMedium = io.Fonts->AddFontFromFileTTF(interPath.c_str(), 15.0f);
+        if (interMedium) {
+            platform.Log("Inter Medium loaded\n");
+        }
+        else {
+            platform.Log("Failed to load Inter Medium\n");
+        }
+
+        ApplyStyle();
+
+        ImGuiStyle& style = ImGui::GetStyle();
+        style.Colors[ImGuiCol_Text] = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+
+        // a finished load wakes Run() so the frame that uploads it gets drawn
+        textureLoader.SetNotify([this] { platform.Wake(); });
+
+        if (!imageCache.Open(platform.AssetPath("imagecache"), ImageCacheBudget, false)) {
+            platform.Log("Image cache unavailable, decoding directly\n");
+        }
+
+        // Prepared on a worker and uploaded by Run() when it lands; a pre-packed
+        // container (tools/texture_pack) is preferred over decoding the PNG
+        TextureLoader::Options bgOptions;
+        bgOptions.coverWidth = BackgroundCoverWidth;
+        bgOptions.coverHeight = BackgroundCoverHeight;
+        bgOptions.premultiply = true;
+        bgOptions.allowBC7 = renderer.SupportsBC7();
+        bgHandle = textureLoader.Request({ platform.AssetPath("background.ktx2"), platform.AssetPath("background.dds"), platform.AssetPath("background.png") },
+            bgOptions, BackgroundPlaceholder, [this, bgOptions](TextureHandle, const AsyncTextureLoader::Info& info) {
+                char message[512];
+                if (info.state == AsyncTextureLoader::State::Ready) {
+                    bgTexture = textures.Insert("background", info.texture, info.bytes, info.width, info.height, info.premultiplied);
+                    bgWidth = info.width;
+                    bgHeight = info.height;
+                    snprintf(message, sizeof(message), "%s: %dx%d %s (%.2f ms)\n", info.path.c_str(), info.width, info.height,
+                        info.fromCache ? "cached" : "prepared", info.prepareMs);
+                }
+                else {
+                    snprintf(message, sizeof(message), "Failed to load background: %s (%s)\n", info.path.c_str(), info.failureReason);
+                }
+                platform.Log(message);
+                RequestBlurredBackgrounds(bgOptions);
+            });
+
+        return true;
+    }
+
+    // Blurring needs decoded pixels, so these only come from the PNG;
+    // without one the panels frost with the sharp background. Requested
+    // once the sharp background has landed, so a PNG it came from is in
+    // the image cache and isn't decoded again, and all the blurs share a
+    // single decode.
+    void RequestBlurredBackgrounds(const TextureLoader::Options& bgOptions) {
+        std::vector<TextureLoader::Options> variants;
+        std::vector<AsyncTextureLoader::Callback> callbacks;
+        for (size_t i = 0; i < bgBlurred.size(); i++) {
+            variants.push_back(bgOptions);
+            variants.back().blurSigma = BackgroundBlurSigmas[i];
+            callbacks.push_back([this, i](TextureHandle, const AsyncTextureLoader::Info& info) {
+                if (info.state != AsyncTextureLoader::State::Ready) return;
+                const std::string id = "background.blur" + std::to_string((int)BackgroundBlurSigmas[i]);
+                bgBlurred[i] = textures.Insert(id, info.texture, info.bytes, info.width, info.height, info.premultiplied);
+                char message[128];
+                snprintf(message, sizeof(message), "%s: %dx%d (%.2f ms)\n", id.c_str(), info.width, info.height, info.prepareMs);
+                platform.Log(message);
+            });
+        }
+        textureLoader.RequestVariants(platform.AssetPath("background.png"), std::move(variants), BackgroundPlaceholder, std::move(callbacks));
+    }
+
+    // One iteration of the main loop: sleeps until a frame is due or an
+    // event arrives, and draws if one is due; false once the app should quit
+    bool Step() {
+        const double wait = scheduler.WaitTime(platform.Time());
+        if (wait > 0.0) platform.WaitEvents(wait);
+        if (!PumpEvents()) return false;
+        if (scheduler.FrameDue(platform.Time())) DrawFrame();
+        return true;
+    }
+
+    // Handles events and draws a frame whether or not one is due; false once
+    // the app should quit
+    bool Frame() {
+        if (!PumpEvents()) return false;
+        DrawFrame();
+        return true;
+    }
+
+    void Run() {
+        while (Step()) {}
+    }
+
+    const FrameScheduler& Scheduler() const { return scheduler; }
+    SimClock& Clock() { return clock; }
+    size_t PendingTextures() const { return textureLoader.PendingCount(); }
+
+    // The page on screen, by the names input scripts expect
+    const char* PageName() const {
+        if (isLoading) return "loading";
+        if (!showMenu) return "login";
+        if (selectedMenuItem == 1) return "updates";
+        return selectedProductIndex >= 0 ? "product" : "products";
+    }
+
+    bool PumpEvents() {
+        bool received = false;
+        if (!platform.PumpEvents(received)) return false;
+        if (received) scheduler.OnInput();
+        return true;
+    }
+
+    void DrawFrame() {
+        scheduler.BeginFrame(platform.Time());
+        textureLoader.ProcessCompletions([this](const TextureLoader::Prepared& prepared) { return renderer.CreateTexture(prepared); });
+
+        renderer.NewFrame();
+        platform.NewFrame();
+        clock.Tick(platform.Time());
+        ImGui::GetIO().DeltaTime = std::max((float)clock.Delta(), MinimumDeltaTime);
+        animator.Update((float)clock.Delta());
+        ImGui::NewFrame();
+
+        RenderUI();
+        if (!animator.Settled()) scheduler.RequestAnimationFrame();
+        if (isDragging) scheduler.RequestAnimationFrame();
+        if (ImGui::GetIO().WantTextInput) scheduler.RequestFrameAt(platform.Time() + CaretBlinkInterval);
+
+        ImGui::Render();
+        renderer.Render(Colors::Background);
+    }
+
+    void RenderUI() {
+        // Window animation
+        if (isLoading && targetWindowWidth == 400.0f) {
+            targetWindowWidth = 600.0f;
+        }
+
+        if (showMenu && targetWindowWidth != 600.0f) {
+            targetWindowWidth = 600.0f;
+        }
+
+        if (!isLoading && !showMenu && targetWindowWidth == 600.0f) {
+            targetWindowWidth = 400.0f;
+        }
+
+        const WindowRect rect = platform.GetWindowRect();
+        const int newWidth = (int)animator.Toward(windowWidth, targetWindowWidth);
+        if (newWidth != rect.width) {
+            const int centerX = rect.x + rect.width / 2;
+            platform.SetWindowRect({ centerX - newWidth / 2, rect.y, newWidth, 400 });
+
+            renderer.Resize(newWidth, 400);
+        }
+
+        constexpr ImGuiWindowFlags flags =
+            ImGuiWindowFlags_NoTitleBar |
+            ImGuiWindowFlags_NoResize |
+            ImGuiWindowFlags_NoMove |
+            ImGuiWindowFlags_NoScrollbar;
+
+        // Menu page
+        if (showMenu) {
+            RenderMenu(flags);
+        }
+        // Login page
+        else if (!isLoading) {
+            ImGui::SetNextWindowPos(ImVec2(0, 0));
+            ImGui::SetNextWindowSize(ImVec2(400.0f, 400.0f));
+
+            ImGui::Begin("Login", nullptr, flags);
+
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+            const ImVec2 windowPos = ImGui::GetWindowPos();
+            const ImVec2 actualWindowSize = ImGui::GetWindowSize();
+
+            if (bgTexture) {
+                const float windowAspect = actualWindowSize.x / actualWindowSize.y;
+                const float imageAspect = (float)bgWidth / (float)bgHeight;
+
+                float uvMinX = 0.0f, uvMinY = 0.0f, uvMaxX = 1.0f, uvMaxY = 1.0f;
+
+                if (windowAspect > imageAspect) {
+                    const float scale = actualWindowSize.x / bgWidth;
+                    const float scaledHeight = bgHeight * scale;
+                    const float heightRatio = actualWindowSize.y / scaledHeight;
+                    uvMinY = (1.0f - heightRatio) * 0.5f;
+                    uvMaxY = 1.0f - uvMinY;
+                }
+                else {
+                    const float scale = actualWindowSize.y / bgHeight;
+                    const float scaledWidth = bgWidth * scale;
+                    const float widthRatio = actualWindowSize.x / scaledWidth;
+                    uvMinX = (1.0f - widthRatio) * 0.5f;
+                    uvMaxX = 1.0f - uvMinX;
+                }
+
+                DrawBackgroundImage(drawList, windowPos, ImVec2(windowPos.x + actualWindowSize.x, windowPos.y + actualWindowSize.y),
+                    ImVec2(uvMinX, uvMinY), ImVec2(uvMaxX, uvMaxY));
+            }
+            else {
+                DrawBackgroundPlaceholder(drawList, windowPos, ImVec2(windowPos.x + actualWindowSize.x, windowPos.y + actualWindowSize.y));
+            }
+
+            const ImVec2 titleBarMin(windowPos.x, windowPos.y);
+            const ImVec2 titleBarMax(windowPos.x + actualWindowSize.x, windowPos.y + 35);
+
+            if (ImGui::IsMouseHoveringRect(titleBarMin, titleBarMax)) {
+                if (ImGui::IsMouseClicked(0)) {
+                    isDragging = true;
+                    const ScreenPoint cursorPos = platform.GetCursorPos();
+                    const WindowRect windowRect = platform.GetWindowRect();
+                    dragOffset.x = cursorPos.x - windowRect.x;
+                    dragOffset.y = cursorPos.y - windowRect.y;
+                }
+            }
+
+            if (isDragging) {
+                if (ImGui::IsMouseDown(0)) {
+                    const ScreenPoint cursorPos = platform.GetCursorPos();
+                    platform.MoveWindow(cursorPos.x - dragOffset.x, cursorPos.y - dragOffset.y);
+                }
+                else {
+                    isDragging = false;
+                }
+            }
+
+            constexpr float logoY = 60.0f;
+            ImGui::SetCursorPosY(logoY);
+
+            if (boldFont) {
+                ImGui::PushFont(boldFont);
+            }
+
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Red);
+            const float redWidth = ImGui::CalcTextSize("MEH").x;
+            const float engineWidth = ImGui::CalcTextSize("DIFFER").x;
+            const float totalWidth = redWidth + engineWidth;
+            const float centerX = (actualWindowSize.x - totalWidth) * 0.5f;
+
+            ImGui::SetCursorPosX(centerX);
+            ImGui::Text("MEH");
+            ImGui::SameLine(0, 0);
+            ImGui::PopStyleColor();
+
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+            ImGui::Text("DIFFER");
+            ImGui::PopStyleColor();
+
+            if (boldFont) {
+                ImGui::PopFont();
+            }
+
+            constexpr float authY = logoY + 31.0f;
+            ImGui::SetCursorPosY(authY);
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            const float authWidth = ImGui::CalcTextSize("Authentication Portal").x;
+            ImGui::SetCursorPosX((actualWindowSize.x - authWidth) * 0.5f);
+            ImGui::Text("Authentication Portal");
+            ImGui::PopStyleColor();
+
+            const float contentWidth = 320.0f;
+            const float contentX = (actualWindowSize.x - contentWidth) * 0.5f;
+            constexpr float contentStartY = 150.0f;
+
+            constexpr float usernameLabelY = contentStartY;
+            ImGui::SetCursorPos(ImVec2(contentX, usernameLabelY));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            ImGui::Text("Username");
+            ImGui::PopStyleColor();
+
+            constexpr float usernameInputY = usernameLabelY + 23.0f;
+            ImGui::SetCursorPos(ImVec2(contentX, usernameInputY));
+            ImGui::PushItemWidth(contentWidth);
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+            bool enterPressed = ImGui::InputTextWithHint("##username", "user123", username.data(), 33, ImGuiInputTextFlags_EnterReturnsTrue);
+            ImGui::PopStyleColor();
+
+            if (ImGui::IsItemActive()) {
+                ImVec2 min = ImGui::GetItemRectMin();
+                ImVec2 max = ImGui::GetItemRectMax();
+                drawList->AddRect(min, max, ImGui::ColorConvertFloat4ToU32(Colors::InputBorderActive), 5.0f, 0, 1.0f);
+            }
+
+            constexpr float passwordLabelY = usernameInputY + 50.0f;
+            ImGui::SetCursorPos(ImVec2(contentX, passwordLabelY));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            ImGui::Text("Password");
+            ImGui::PopStyleColor();
+
+            const float forgotWidth = ImGui::CalcTextSize("Forgot Password?").x;
+            ImGui::SetCursorPos(ImVec2(contentX + contentWidth - forgotWidth, passwordLabelY));
+
+            const bool forgotHovered = ImGui::IsMouseHoveringRect(
+                ImVec2(windowPos.x + contentX + contentWidth - forgotWidth, windowPos.y + passwordLabelY),
+                ImVec2(windowPos.x + contentX + contentWidth, windowPos.y + passwordLabelY + ImGui::GetTextLineHeight())
+            );
+
+            const float forgotPasswordAlpha = animator.Toward(forgotPasswordHover, forgotHovered ? 1.0f : 0.0f);
+            const ImVec4 forgotColor = ImVec4(
+                Colors::LinkText.x + (Colors::LinkHover.x - Colors::LinkText.x) * forgotPasswordAlpha,
+                Colors::LinkText.y + (Colors::LinkHover.y - Colors::LinkText.y) * forgotPasswordAlpha,
+                Colors::LinkText.z + (Colors::LinkHover.z - Colors::LinkText.z) * forgotPasswordAlpha,
+                1.0f
+            );
+
+            ImGui::PushStyleColor(ImGuiCol_Text, forgotColor);
+            ImGui::Text("Forgot Password?");
+            if (forgotHovered && ImGui::IsMouseClicked(0)) {
+            }
+            ImGui::PopStyleColor();
+
+            constexpr float passwordInputY = passwordLabelY + 23.0f;
+            ImGui::SetCursorPos(ImVec2(contentX, passwordInputY));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+            enterPressed |= ImGui::InputTextWithHint("##password", "**********", password.data(), 63, ImGuiInputTextFlags_Password | ImGuiInputTextFlags_EnterReturnsTrue);
+            ImGui::PopStyleColor();
+
+            if (ImGui::IsItemActive()) {
+                ImVec2 min = ImGui::GetItemRectMin();
+                ImVec2 max = ImGui::GetItemRectMax();
+                drawList->AddRect(min, max, ImGui::ColorConvertFloat4ToU32(Colors::InputBorderActive), 5.0f, 0, 1.0f);
+            }
+
+            constexpr float buttonY = passwordInputY + 58.0f;
+            ImGui::SetCursorPos(ImVec2(contentX, buttonY));
+
+            const bool buttonHovered = ImGui::IsMouseHoveringRect(
+                ImVec2(windowPos.x + contentX, windowPos.y + buttonY),
+                ImVec2(windowPos.x + contentX + contentWidth, windowPos.y + buttonY + 42)
+            );
+
+            const float buttonHoverAlpha = animator.Toward(loginButtonHover, buttonHovered ? 1.0f : 0.0f);
+            const ImVec4 buttonColor = ImVec4(
+                Colors::ButtonBg.x + (Colors::ButtonHover.x - Colors::ButtonBg.x) * buttonHoverAlpha,
+                Colors::ButtonBg.y + (Colors::ButtonHover.y - Colors::ButtonBg.y) * buttonHoverAlpha,
+                Colors::ButtonBg.z + (Colors::ButtonHover.z - Colors::ButtonBg.z) * buttonHoverAlpha,
+                1.0f
+            );
+
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::ButtonText);
+            ImGui::PushStyleColor(ImGuiCol_Border, Colors::ButtonBorder);
+            ImGui::PushStyleColor(ImGuiCol_Button, buttonColor);
+            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, buttonColor);
+            ImGui::PushStyleColor(ImGuiCol_ButtonActive, buttonColor);
+            ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 5.0f);
+            if (ImGui::Button("Login", ImVec2(contentWidth, 42)) || enterPressed) {
+                if (strcmp(username.data(), "admin") == 0 && strcmp(password.data(), "123") == 0) {
+                    isLoading = true;
+                    targetWindowWidth = 600.0f;
+                    animator.Set(loadingContentFade, 0.0f);
+                    loadingStartTime = clock.Now();
+                }
+            }
+            ImGui::PopStyleVar();
+            ImGui::PopStyleColor(5);
+
+            ImGui::PopItemWidth();
+
+            ImGui::End();
+        }
+        // Loading screen
+        else {
+            ImGui::SetNextWindowPos(ImVec2(0, 0));
+            ImGui::SetNextWindowSize(ImVec2(600.0f, 400.0f));
+
+            ImGui::Begin("Loading", nullptr, flags);
+
+            const ImVec2 windowPos = ImGui::GetWindowPos();
+            const ImVec2 windowSize = ImGui::GetWindowSize();
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+            if (bgTexture) {
+                const float windowAspect = windowSize.x / windowSize.y;
+                const float imageAspect = (float)bgWidth / (float)bgHeight;
+
+                float uvMinX = 0.0f, uvMinY = 0.0f, uvMaxX = 1.0f, uvMaxY = 1.0f;
+
+                if (windowAspect > imageAspect) {
+                    const float scale = windowSize.x / bgWidth;
+                    const float scaledHeight = bgHeight * scale;
+                    const float heightRatio = windowSize.y / scaledHeight;
+                    uvMinY = (1.0f - heightRatio) * 0.5f;
+                    uvMaxY = 1.0f - uvMinY;
+                }
+                else {
+                    const float scale = windowSize.y / bgHeight;
+                    const float scaledWidth = bgWidth * scale;
+                    const float widthRatio = windowSize.x / scaledWidth;
+                    uvMinX = (1.0f - widthRatio) * 0.5f;
+                    uvMaxX = 1.0f - uvMinX;
+                }
+
+                DrawBackgroundImage(drawList, windowPos, ImVec2(windowPos.x + windowSize.x, windowPos.y + windowSize.y),
+                    ImVec2(uvMinX, uvMinY), ImVec2(uvMaxX, uvMaxY));
+            }
+            else {
+                DrawBackgroundPlaceholder(drawList, windowPos, ImVec2(windowPos.x + windowSize.x, windowPos.y + windowSize.y));
+            }
+
+            const ImVec2 titleBarMin(windowPos.x, windowPos.y);
+            const ImVec2 titleBarMax(windowPos.x + windowSize.x, windowPos.y + 35);
+
+            if (ImGui::IsMouseHoveringRect(titleBarMin, titleBarMax)) {
+                if (ImGui::IsMouseClicked(0)) {
+                    isDragging = true;
+                    const ScreenPoint cursorPos = platform.GetCursorPos();
+                    const WindowRect windowRect = platform.GetWindowRect();
+                    dragOffset.x = cursorPos.x - windowRect.x;
+                    dragOffset.y = cursorPos.y - windowRect.y;
+                }
+            }
+
+            if (isDragging) {
+                if (ImGui::IsMouseDown(0)) {
+                    const ScreenPoint cursorPos = platform.GetCursorPos();
+                    platform.MoveWindow(cursorPos.x - dragOffset.x, cursorPos.y - dragOffset.y);
+                }
+                else {
+                    isDragging = false;
+                }
+            }
+
+            const ImVec2 center(
+                windowPos.x + windowSize.x * 0.5f,
+                windowPos.y + windowSize.y * 0.5f
+            );
+
+            // the spinner turns until the menu replaces it
+            loadingRotation += (float)clock.Delta() * 3.0f;
+            scheduler.RequestAnimationFrame();
+
+            const double elapsedTime = clock.Now() - loadingStartTime;
+            const bool showContent = (elapsedTime >= LoadingContentDelay);
+
+            if (elapsedTime >= LoadingDuration) {
+                isLoading = false;
+                showMenu = true;
+                targetWindowWidth = 600.0f;
+            }
+
+            if (showContent) {
+                const float loadingContentAlpha = animator.Toward(loadingContentFade, 1.0f);
+
+                const float radius = 18.0f;
+                const float thickness = 3.0f;
+                const int segments = 36;
+                const float arcLength = 4.71238898f;
+
+                for (int i = 0; i < segments; i++) {
+                    const float t = i / (float)segments;
+                    const float a1 = loadingRotation + t * arcLength;
+                    const float a2 = loadingRotation + ((i + 1) / (float)segments) * arcLength;
+
+                    const ImVec2 p1(
+                        center.x + cosf(a1) * radius,
+                        center.y - 20.0f + sinf(a1) * radius
+                    );
+                    const ImVec2 p2(
+                        center.x + cosf(a2) * radius,
+                        center.y - 20.0f + sinf(a2) * radius
+                    );
+
+                    const ImU32 spinnerColor = ImGui::ColorConvertFloat4ToU32(ImVec4(
+                        Colors::Secondary.x,
+                        Colors::Secondary.y,
+                        Colors::Secondary.z,
+                        loadingContentAlpha
+                    ));
+                    drawList->AddLine(p1, p2, spinnerColor, thickness);
+                }
+
+                const char* loadingText = "Verifying credentials";
+                const ImVec2 textSize = ImGui::CalcTextSize(loadingText);
+
+                ImGui::SetCursorPosX((windowSize.x - textSize.x) * 0.5f);
+                ImGui::SetCursorPosY(windowSize.y * 0.5f + 20.0f);
+
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(
+                    Colors::Secondary.x,
+                    Colors::Secondary.y,
+                    Colors::Secondary.z,
+                    loadingContentAlpha
+                ));
+                ImGui::Text("%s", loadingText);
+                ImGui::PopStyleColor();
+            }
+
+            ImGui::End();
+        }
+    }
+
+    // Menu rendering
+    void RenderMenu(ImGuiWindowFlags flags) {
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(600.0f, 400.0f));
+
+        ImGui::Begin("Menu", nullptr, flags);
+
+        const ImVec2 windowPos = ImGui::GetWindowPos();
+        const ImVec2 windowSize = ImGui::GetWindowSize();
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        if (bgTexture) {
+            const float windowAspect = windowSize.x / windowSize.y;
+            const float imageAspect = (float)bgWidth / (float)bgHeight;
+
+            float uvMinX = 0.0f, uvMinY = 0.0f, uvMaxX = 1.0f, uvMaxY = 1.0f;
+
+            if (windowAspect > imageAspect) {
+                const float scale = windowSize.x / bgWidth;
+                const float scaledHeight = bgHeight * scale;
+                const float heightRatio = windowSize.y / scaledHeight;
+                uvMinY = (1.0f - heightRatio) * 0.5f;
+                uvMaxY = 1.0f - uvMinY;
+            }
+            else {
+                const float scale = windowSize.y / bgHeight;
+                const float scaledWidth = bgWidth * scale;
+                const float widthRatio = windowSize.x / scaledWidth;
+                uvMinX = (1.0f - widthRatio) * 0.5f;
+                uvMaxX = 1.0f - uvMinX;
+            }
+
+            DrawBackgroundImage(drawList, windowPos, ImVec2(windowPos.x + windowSize.x, windowPos.y + windowSize.y),
+                ImVec2(uvMinX, uvMinY), ImVec2(uvMaxX, uvMaxY));
+        }
+        else {
+            DrawBackgroundPlaceholder(drawList, windowPos, ImVec2(windowPos.x + windowSize.x, windowPos.y + windowSize.y));
+        }
+
+        const ImVec2 titleBarMin(windowPos.x, windowPos.y);
+        const ImVec2 titleBarMax(windowPos.x + windowSize.x, windowPos.y + 35);
+
+        if (ImGui::IsMouseHoveringRect(titleBarMin, titleBarMax)) {
+            if (ImGui::IsMouseClicked(0)) {
+                isDragging = true;
+                const ScreenPoint cursorPos = platform.GetCursorPos();
+                const WindowRect windowRect = platform.GetWindowRect();
+                dragOffset.x = cursorPos.x - windowRect.x;
+                dragOffset.y = cursorPos.y - windowRect.y;
+            }
+        }
+
+        if (isDragging) {
+            if (ImGui::IsMouseDown(0)) {
+                const ScreenPoint cursorPos = platform.GetCursorPos();
+                platform.MoveWindow(cursorPos.x - dragOffset.x, cursorPos.y - dragOffset.y);
+            }
+            else {
+                isDragging = false;
+            }
+        }
+
+        ImGui::SetCursorPos(ImVec2(14.5f, 12.0f));
+
+        if (mediumFont) ImGui::PushFont(mediumFont);
+
+        ImGui::PushStyleColor(ImGuiCol_Text, Colors::Red);
+        ImGui::Text("MEH");
+        ImGui::SameLine(0, 0);
+        ImGui::PopStyleColor();
+
+        ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+        ImGui::Text("DIFFER");
+        ImGui::PopStyleColor();
+
+        if (mediumFont) ImGui::PopFont();
+
+        if (exitIconFont) ImGui::PushFont(exitIconFont);
+        const ImVec2 logoutSize = ImGui::CalcTextSize("=");
+        const float logoutX = windowSize.x - logoutSize.x - 14.5f;
+        const float logoutY = 15.5f;
+
+        const ImVec2 logoutMin(windowPos.x + logoutX - 5.0f, windowPos.y + logoutY - 5.0f);
+        const ImVec2 logoutMax(windowPos.x + logoutX + logoutSize.x + 5.0f, windowPos.y + logoutY + logoutSize.y + 5.0f);
+        bool logoutHovered = ImGui::IsMouseHoveringRect(logoutMin, logoutMax);
+
+        ImGui::SetCursorPos(ImVec2(logoutX, logoutY));
+
+        ImVec4 baseColor = ImVec4(216.0f / 255.0f, 20.0f / 255.0f, 59.0f / 255.0f, 1.0f);
+        ImVec4 hoverColor = ImVec4(186.0f / 255.0f, 15.0f / 255.0f, 49.0f / 255.0f, 1.0f);
+
+        const float hoverAlpha = animator.Toward(logoutHover, logoutHovered ? 1.0f : 0.0f);
+
+        ImVec4 logoutColor = ImVec4(
+            baseColor.x + (hoverColor.x - baseColor.x) * hoverAlpha,
+            baseColor.y + (hoverColor.y - baseColor.y) * hoverAlpha,
+            baseColor.z + (hoverColor.z - baseColor.z) * hoverAlpha,
+            1.0f
+        );
+
+        ImGui::PushStyleColor(ImGuiCol_Text, logoutColor);
+        ImGui::Text("=");
+        ImGui::PopStyleColor();
+
+        if (logoutHovered && ImGui::IsMouseClicked(0)) {
+            platform.RequestQuit();
+        }
+
+        if (exitIconFont) ImGui::PopFont();
+
+        const float separatorY = 47.0f;
+        drawList->AddLine(
+            ImVec2(windowPos.x, windowPos.y + separatorY),
+            ImVec2(windowPos.x + windowSize.x, windowPos.y + separatorY),
+            IM_COL32(14, 14, 14, 255), 1.0f
+        );
+
+        if (mediumFont) ImGui::PushFont(mediumFont);
+        const float mehdifferWidth = ImGui::CalcTextSize("MEHDIFFER").x;
+        if (mediumFont) ImGui::PopFont();
+        const float verticalSeparatorX = 14.5f + mehdifferWidth + 13.5f;
+        drawList->AddLine(
+            ImVec2(windowPos.x + verticalSeparatorX, windowPos.y + separatorY),
+            ImVec2(windowPos.x + verticalSeparatorX, windowPos.y + windowSize.y),
+            IM_COL32(14, 14, 14, 255), 1.0f
+        );
+
+        const float menuStartY = 66.0f;
+        const float menuItemHeight = 32.0f;
+        const float menuItemX = 23.0f;
+        const float iconTextSpacing = 8.0f;
+
+        const ImVec2 productsMin(windowPos.x + menuItemX, windowPos.y + menuStartY - 5.0f);
+        const ImVec2 productsMax(windowPos.x + verticalSeparatorX, windowPos.y + menuStartY + menuItemHeight - 5.0f);
+        bool productsHovered = ImGui::IsMouseHoveringRect(productsMin, productsMax);
+
+        if (productsHovered && ImGui::IsMouseClicked(0)) {
+            selectedMenuItem = 0;
+        }
+
+        const float productsHoverAlpha = animator.Toward(productsHover, productsHovered ? 1.0f : 0.0f);
+
+        ImVec4 productsBaseColor = selectedMenuItem == 0 ? Colors::Primary : Colors::Secondary;
+        ImVec4 productsHoverColor = Colors::Primary;
+        ImVec4 productsTextColor = ImVec4(
+            productsBaseColor.x + (productsHoverColor.x - productsBaseColor.x) * productsHoverAlpha * 0.5f,
+            productsBaseColor.y + (productsHoverColor.y - productsBaseColor.y) * productsHoverAlpha * 0.5f,
+            productsBaseColor.z + (productsHoverColor.z - productsBaseColor.z) * productsHoverAlpha * 0.5f,
+            1.0f
+        );
+
+        ImGui::PushStyleColor(ImGuiCol_Text, productsTextColor);
+
+        ImGui::SetCursorPos(ImVec2(menuItemX, menuStartY - 3.0f));
+        if (iconFont) ImGui::PushFont(iconFont);
+        const float iconWidth = ImGui::CalcTextSize(reinterpret_cast<const char*>(u8"\ue05b")).x;
+        ImGui::Text("%s", reinterpret_cast<const char*>(u8"\ue05b"));
+        if (iconFont) ImGui::PopFont();
+
+        ImGui::SetCursorPos(ImVec2(menuItemX + iconWidth + iconTextSpacing, menuStartY - 5.0f));
+        if (interMedium) ImGui::PushFont(interMedium);
+        ImGui::Text("Products");
+        if (interMedium) ImGui::PopFont();
+        ImGui::PopStyleColor();
+
+        const ImVec2 updatesMin(windowPos.x + menuItemX, windowPos.y + menuStartY + menuItemHeight - 8.0f);
+        const ImVec2 updatesMax(windowPos.x + verticalSeparatorX, windowPos.y + menuStartY + 2 * menuItemHeight - 8.0f);
+        bool updatesHovered = ImGui::IsMouseHoveringRect(updatesMin, updatesMax);
+
+        if (updatesHovered && ImGui::IsMouseClicked(0)) {
+            selectedMenuItem = 1;
+        }
+
+        const float updatesHoverAlpha = animator.Toward(updatesHover, updatesHovered ? 1.0f : 0.0f);
+
+        ImVec4 updatesBaseColor = selectedMenuItem == 1 ? Colors::Primary : Colors::Secondary;
+        ImVec4 updatesHoverColor = Colors::Primary;
+        ImVec4 updatesTextColor = ImVec4(
+            updatesBaseColor.x + (updatesHoverColor.x - updatesBaseColor.x) * updatesHoverAlpha * 0.5f,
+            updatesBaseColor.y + (updatesHoverColor.y - updatesBaseColor.y) * updatesHoverAlpha * 0.5f,
+            updatesBaseColor.z + (updatesHoverColor.z - updatesBaseColor.z) * updatesHoverAlpha * 0.5f,
+            1.0f
+        );
+
+        ImGui::PushStyleColor(ImGuiCol_Text, updatesTextColor);
+
+        ImGui::SetCursorPos(ImVec2(menuItemX, menuStartY + menuItemHeight - 6.0f));
+        if (iconFont) ImGui::PushFont(iconFont);
+        const float iconWidth2 = ImGui::CalcTextSize("x").x;
+        ImGui::Text("x");
+        if (iconFont) ImGui::PopFont();
+
+        ImGui::SetCursorPos(ImVec2(menuItemX + iconWidth2 + iconTextSpacing, menuStartY + menuItemHeight - 8.0f));
+        if (interMedium) ImGui::PushFont(interMedium);
+        ImGui::Text("Updates");
+        if (interMedium) ImGui::PopFont();
+        ImGui::PopStyleColor();
+
+        // Products page
+        if (selectedMenuItem == 0) {
+            const float contentX = verticalSeparatorX + 20.0f;
+            const float contentY = separatorY + 20.0f;
+            const float contentWidth = windowSize.x - verticalSeparatorX - 40.0f;
+
+            // Product detail view
+            if (selectedProductIndex >= 0) {
+                const char* productNames[] = { "TK - Toolkit", "DM - Device Modifier" };
+                const char* productStatuses[] = { "Undetected", "USE AT OWN RISK" };
+                ImVec4 statusColors[] = { ImVec4(0.0f, 0.8f, 0.0f, 1.0f), ImVec4(1.0f, 0.6f, 0.0f, 1.0f) };
+
+                const float titleCardY = contentY - 4.0f;
+                const float titleCardHeight = 70.0f;
+                const float titleCardX = contentX - 1.0f;
+                const ImVec2 titleCardMin(windowPos.x + titleCardX - 4.0f, windowPos.y + titleCardY);
+                const ImVec2 titleCardMax(windowPos.x + titleCardX + contentWidth + 6.0f, windowPos.y + titleCardY + titleCardHeight);
+                drawList->AddRect(titleCardMin, titleCardMax, IM_COL32(14, 14, 14, 255), 5.0f, 0, 1.0f);
+
+                const char* productName = productNames[selectedProductIndex];
+                if (mediumFont) ImGui::PushFont(mediumFont);
+                const ImVec2 titleSize = ImGui::CalcTextSize(productName);
+                if (mediumFont) ImGui::PopFont();
+
+                const float titleX = contentX + (contentWidth - titleSize.x) * 0.5f;
+                const float titleY = titleCardY + 15.0f;
+
+                ImGui::SetCursorPos(ImVec2(titleX, titleY));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                if (mediumFont) ImGui::PushFont(mediumFont);
+                ImGui::Text("%s", productName);
+                if (mediumFont) ImGui::PopFont();
+                ImGui::PopStyleColor();
+
+                const ImVec2 versionSize = ImGui::CalcTextSize("v1.2.3");
+                const float versionX = contentX + (contentWidth - versionSize.x) * 0.5f;
+                const float versionY = titleY + titleSize.y + 5.0f;
+
+                ImGui::SetCursorPos(ImVec2(versionX, versionY));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+                ImGui::Text("v1.2.3");
+                ImGui::PopStyleColor();
+
+                const float cardY = titleCardY + titleCardHeight + 8.0f;
+                const float cardWidth = (contentWidth - 4.0f) * 0.5f;
+                const float cardHeight = 60.0f;
+                const float cardPadding = 15.0f;
+
+                const float cardsOffsetX = contentX - 1.0f;
+                const ImVec2 subCardMin(windowPos.x + cardsOffsetX - 4.0f, windowPos.y + cardY);
+                const ImVec2 subCardMax(windowPos.x + cardsOffsetX + cardWidth, windowPos.y + cardY + cardHeight);
+                drawList->AddRect(subCardMin, subCardMax, IM_COL32(14, 14, 14, 255), 5.0f, 0, 1.0f);
+
+                const float labelHeight = 18.0f;
+                const float dateHeight = 18.0f;
+                const float textSpacing = 4.0f;
+                const float totalTextHeight = labelHeight + textSpacing + dateHeight;
+                const float verticalPadding = (cardHeight - totalTextHeight) * 0.5f;
+
+                ImGui::SetCursorPos(ImVec2(cardsOffsetX + cardPadding, cardY + verticalPadding));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+                ImGui::Text("Subscription");
+                ImGui::PopStyleColor();
+
+                ImGui::SetCursorPos(ImVec2(cardsOffsetX + cardPadding, cardY + verticalPadding + labelHeight + textSpacing));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                ImGui::Text("2025-11-01");
+                ImGui::PopStyleColor();
+
+                const float expCardX = cardsOffsetX + cardWidth + 10.0f;
+                const ImVec2 expCardMin(windowPos.x + expCardX - 4.0f, windowPos.y + cardY);
+                const ImVec2 expCardMax(windowPos.x + expCardX + cardWidth, windowPos.y + cardY + cardHeight);
+                drawList->AddRect(expCardMin, expCardMax, IM_COL32(14, 14, 14, 255), 5.0f, 0, 1.0f);
+
+                ImGui::SetCursorPos(ImVec2(expCardX + cardPadding, cardY + verticalPadding));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+                ImGui::Text("Expiration");
+                ImGui::PopStyleColor();
+
+                ImGui::SetCursorPos(ImVec2(expCardX + cardPadding, cardY + verticalPadding + labelHeight + textSpacing));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                ImGui::Text("2026-11-01");
+                ImGui::PopStyleColor();
+
+                const float featuresCardY = cardY + cardHeight + 8.0f;
+                const float featuresCardHeight = 110.0f;
+                const float featuresCardPadding = 15.0f;
+                const float featuresCardX = contentX - 1.0f;
+
+                const ImVec2 featuresCardMin(windowPos.x + featuresCardX - 4.0f, windowPos.y + featuresCardY);
+                const ImVec2 featuresCardMax(windowPos.x + featuresCardX + contentWidth + 6.0f, windowPos.y + featuresCardY + featuresCardHeight);
+                drawList->AddRect(featuresCardMin, featuresCardMax, IM_COL32(14, 14, 14, 255), 5.0f, 0, 1.0f);
+
+                ImGui::SetCursorPos(ImVec2(featuresCardX + featuresCardPadding, featuresCardY + featuresCardPadding));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                ImGui::Text("Features");
+                ImGui::PopStyleColor();
+
+                const float featureStartY = featuresCardY + featuresCardPadding + 25.0f;
+                ImGui::SetCursorPos(ImVec2(featuresCardX + featuresCardPadding, featureStartY));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+
+                if (selectedProductIndex == 0) {
+                    ImGui::Text("• Advanced Module");
+                    ImGui::SetCursorPos(ImVec2(featuresCardX + featuresCardPadding, featureStartY + 20.0f));
+                    ImGui::Text("• Auto-update system");
+                    ImGui::SetCursorPos(ImVec2(featuresCardX + featuresCardPadding, featureStartY + 40.0f));
+                    ImGui::Text("• 24/7 support");
+                } else {
+                    ImGui::Text("• Hardware ID spoofing");
+                    ImGui::SetCursorPos(ImVec2(featuresCardX + featuresCardPadding, featureStartY + 20.0f));
+                    ImGui::Text("• Registry protection");
+                    ImGui::SetCursorPos(ImVec2(featuresCardX + featuresCardPadding, featureStartY + 40.0f));
+                    ImGui::Text("• HWID cleaner");
+                }
+
+                ImGui::PopStyleColor();
+
+                const float bottomY = windowPos.y + windowSize.y - 50.0f;
+                const float btnWidth = 100.0f;
+                const float btnHeight = 35.0f;
+                const float launchBtnX = windowSize.x - btnWidth - 15.0f;
+
+                const float detailSeparatorY = bottomY - 16.0f;
+                drawList->AddLine(
+                    ImVec2(windowPos.x + verticalSeparatorX, detailSeparatorY),
+                    ImVec2(windowPos.x + windowSize.x, detailSeparatorY),
+                    IM_COL32(14, 14, 14, 255), 1.0f
+                );
+
+                const ImVec2 launchBtnMin(windowPos.x + launchBtnX, bottomY);
+                const ImVec2 launchBtnMax(windowPos.x + launchBtnX + btnWidth, bottomY + btnHeight);
+
+                bool launchHovered = ImGui::IsMouseHoveringRect(launchBtnMin, launchBtnMax);
+                const float launchButtonHoverAlpha = animator.Toward(launchButtonHover, launchHovered ? 1.0f : 0.0f);
+                
+                const int baseColor = 14;
+                const int hoverColor = 16;
+                const int currentColor = baseColor + (int)((hoverColor - baseColor) * launchButtonHoverAlpha);
+                drawList->AddRectFilled(
+                    launchBtnMin,
+                    launchBtnMax,
+                    IM_COL32(currentColor, currentColor, currentColor, 255),
+                    5.0f
+                );
+
+                drawList->AddRect(launchBtnMin, launchBtnMax, IM_COL32(20, 20, 20, 255), 5.0f, 0, 1.0f);
+
+                const ImVec2 launchTextSize = ImGui::CalcTextSize("Inject");
+                ImGui::SetCursorPos(ImVec2(launchBtnX + (btnWidth - launchTextSize.x) * 0.5f, bottomY - windowPos.y + (btnHeight - launchTextSize.y) * 0.5f));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                ImGui::Text("Inject");
+                ImGui::PopStyleColor();
+
+                if (launchHovered && ImGui::IsMouseClicked(0)) {
+                    showLaunchNotification = true;
+                    launchNotificationAlpha = 0.0f;
+                    animator.Set(notificationSlide, 0.0f);
+                    launchNotificationStartTime = clock.Now();
+                    injectionStage = 0;
+                    previousInjectionStage = -1;
+                    stageStartTime = clock.Now();
+                }
+
+                const ImVec2 statusTextSize = ImGui::CalcTextSize(productStatuses[selectedProductIndex]);
+                const float statusX = launchBtnX - statusTextSize.x - 20.0f;
+                ImGui::SetCursorPos(ImVec2(statusX, bottomY - windowPos.y + (btnHeight - statusTextSize.y) * 0.5f));
+                ImGui::PushStyleColor(ImGuiCol_Text, statusColors[selectedProductIndex]);
+                ImGui::Text("%s", productStatuses[selectedProductIndex]);
+                ImGui::PopStyleColor();
+
+                const char* goBackIcon = "l";
+                const char* goBackText = " Go Back";
+
+                if (iconFont) ImGui::PushFont(iconFont);
+                const ImVec2 iconSize = ImGui::CalcTextSize(goBackIcon);
+                if (iconFont) ImGui::PopFont();
+                const ImVec2 textSize = ImGui::CalcTextSize(goBackText);
+                const ImVec2 totalSize(iconSize.x + textSize.x, btnHeight);
+
+                const ImVec2 goBackMin(windowPos.x + contentX - 5.0f, bottomY);
+                const ImVec2 goBackMax(windowPos.x + contentX - 5.0f + totalSize.x, bottomY + btnHeight);
+                bool backHovered = ImGui::IsMouseHoveringRect(goBackMin, goBackMax);
+
+                const float backButtonHoverAlpha = animator.Toward(backButtonHover, backHovered ? 1.0f : 0.0f);
+                ImVec4 backBaseColor = Colors::Secondary;
+                ImVec4 backHoverColor = Colors::Primary;
+                ImVec4 backTextColor = ImVec4(
+                    backBaseColor.x + (backHoverColor.x - backBaseColor.x) * backButtonHoverAlpha,
+                    backBaseColor.y + (backHoverColor.y - backBaseColor.y) * backButtonHoverAlpha,
+                    backBaseColor.z + (backHoverColor.z - backBaseColor.z) * backButtonHoverAlpha,
+                    1.0f
+                );
+
+                ImGui::SetCursorPos(ImVec2(contentX - 5.0f, bottomY - windowPos.y + (btnHeight - iconSize.y) * 0.5f));
+                if (iconFont) ImGui::PushFont(iconFont);
+                ImGui::PushStyleColor(ImGuiCol_Text, backTextColor);
+                ImGui::Text("%s", goBackIcon);
+                ImGui::PopStyleColor();
+                if (iconFont) ImGui::PopFont();
+
+                ImGui::SetCursorPos(ImVec2(contentX - 5.0f + iconSize.x, bottomY - windowPos.y + (btnHeight - textSize.y) * 0.5f));
+                ImGui::PushStyleColor(ImGuiCol_Text, backTextColor);
+                ImGui::Text("%s", goBackText);
+                ImGui::PopStyleColor();
+
+                if (backHovered && ImGui::IsMouseClicked(0)) {
+                    selectedProductIndex = -1;
+                }
+            }
+            // Product list
+            else {
+                const float cardY = contentY;
+                const float cardHeight = 100.0f;
+                const float cardPadding = 15.0f;
+
+                const ImVec2 card1Min(windowPos.x + contentX, windowPos.y + cardY);
+                const ImVec2 card1Max(windowPos.x + contentX + contentWidth, windowPos.y + cardY + cardHeight);
+
+                drawList->AddRect(card1Min, card1Max, IM_COL32(14, 14, 14, 255), 8.0f, 0, 1.0f);
+
+                ImGui::SetCursorPos(ImVec2(contentX + cardPadding, cardY + cardPadding));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                if (interMedium) ImGui::PushFont(interMedium);
+                ImGui::Text("TK – Toolkit");
+                if (interMedium) ImGui::PopFont();
+                ImGui::PopStyleColor();
+
+                ImGui::SetCursorPos(ImVec2(contentX + cardPadding, cardY + cardPadding + 25.0f));
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 0.8f, 0.0f, 1.0f));
+                ImGui::Text("Working / Undetected");
+                ImGui::PopStyleColor();
+
+                const float separatorY = cardY + cardHeight - 30.0f;
+                drawList->AddLine(
+                    ImVec2(card1Min.x, windowPos.y + separatorY),
+                    ImVec2(card1Max.x, windowPos.y + separatorY),
+                    IM_COL32(14, 14, 14, 255), 1.0f
+                );
+
+                const char* lastUpdatedLabel = "Last Updated:";
+                const char* lastUpdatedDate1 = " 2025-11-25T09:46:13";
+                const ImVec2 labelSize = ImGui::CalcTextSize(lastUpdatedLabel);
+                const float verticalCenterY = cardY + cardHeight - 15.0f - (labelSize.y * 0.5f) - 1.0f;
+
+                ImGui::SetCursorPos(ImVec2(contentX + cardPadding, verticalCenterY));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                ImGui::Text("%s", lastUpdatedLabel);
+                ImGui::PopStyleColor();
+
+                ImGui::SameLine(0, 0);
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+                ImGui::Text("%s", lastUpdatedDate1);
+                ImGui::PopStyleColor();
+
+                const float viewBtnWidth = 60.0f;
+                const float viewBtnHeight = 30.0f;
+                const ImVec2 viewBtnMin(card1Max.x - viewBtnWidth - cardPadding, card1Min.y + cardPadding);
+                const ImVec2 viewBtnMax(card1Max.x - cardPadding, card1Min.y + cardPadding + viewBtnHeight);
+
+                bool viewHovered = ImGui::IsMouseHoveringRect(viewBtnMin, viewBtnMax);
+
+                const float viewButton1HoverAlpha = animator.Toward(viewButton1Hover, viewHovered ? 1.0f : 0.0f);
+                const int viewBaseColor = 14;
+                const int viewHoverColor = 16;
+                const int viewCurrentColor = viewBaseColor + (int)((viewHoverColor - viewBaseColor) * viewButton1HoverAlpha);
+                ImU32 viewBtnBg = IM_COL32(viewCurrentColor, viewCurrentColor, viewCurrentColor, 255);
+
+                drawList->AddRectFilled(viewBtnMin, viewBtnMax, viewBtnBg, 5.0f);
+                drawList->AddRect(viewBtnMin, viewBtnMax, IM_COL32(20, 20, 20, 255), 5.0f, 0, 1.0f);
+
+                const ImVec2 viewTextSize = ImGui::CalcTextSize("View");
+                ImGui::SetCursorPos(ImVec2(contentX + contentWidth - cardPadding - viewBtnWidth + (viewBtnWidth - viewTextSize.x) * 0.5f,
+                    cardY + cardPadding + (viewBtnHeight - viewTextSize.y) * 0.5f));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                ImGui::Text("View");
+                ImGui::PopStyleColor();
+
+                if (viewHovered && ImGui::IsMouseClicked(0)) {
+                    selectedProductIndex = 0;
+                }
+
+                const float card2Y = cardY + cardHeight + 15.0f;
+                const ImVec2 card2Min(windowPos.x + contentX, windowPos.y + card2Y);
+                const ImVec2 card2Max(windowPos.x + contentX + contentWidth, windowPos.y + card2Y + cardHeight);
+
+                drawList->AddRect(card2Min, card2Max, IM_COL32(14, 14, 14, 255), 8.0f, 0, 1.0f);
+
+                ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card2Y + cardPadding));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                if (interMedium) ImGui::PushFont(interMedium);
+                ImGui::Text("DM – Device Modifier");
+                if (interMedium) ImGui::PopFont();
+                ImGui::PopStyleColor();
+
+                ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card2Y + cardPadding + 25.0f));
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.6f, 0.0f, 1.0f));
+                ImGui::Text("USE AT OWN RISK");
+                ImGui::PopStyleColor();
+
+                const float separator2Y = card2Y + cardHeight - 30.0f;
+                drawList->AddLine(
+                    ImVec2(card2Min.x, windowPos.y + separator2Y),
+                    ImVec2(card2Max.x, windowPos.y + separator2Y),
+                    IM_COL32(14, 14, 14, 255), 1.0f
+                );
+
+                const char* lastUpdatedDate2 = " 2025-11-28T15:32:47";
+                const float verticalCenterY2 = card2Y + cardHeight - 15.0f - (labelSize.y * 0.5f) - 1.0f;
+
+                ImGui::SetCursorPos(ImVec2(contentX + cardPadding, verticalCenterY2));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                ImGui::Text("%s", lastUpdatedLabel);
+                ImGui::PopStyleColor();
+
+                ImGui::SameLine(0, 0);
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+                ImGui::Text("%s", lastUpdatedDate2);
+                ImGui::PopStyleColor();
+
+                const ImVec2 view2BtnMin(card2Max.x - viewBtnWidth - cardPadding, card2Min.y + cardPadding);
+                const ImVec2 view2BtnMax(card2Max.x - cardPadding, card2Min.y + cardPadding + viewBtnHeight);
+
+                bool view2Hovered = ImGui::IsMouseHoveringRect(view2BtnMin, view2BtnMax);
+
+                const float viewButton2HoverAlpha = animator.Toward(viewButton2Hover, view2Hovered ? 1.0f : 0.0f);
+                const int view2BaseColor = 14;
+                const int view2HoverColor = 16;
+                const int view2CurrentColor = view2BaseColor + (int)((view2HoverColor - view2BaseColor) * viewButton2HoverAlpha);
+                ImU32 view2BtnBg = IM_COL32(view2CurrentColor, view2CurrentColor, view2CurrentColor, 255);
+
+                drawList->AddRectFilled(view2BtnMin, view2BtnMax, view2BtnBg, 5.0f);
+                drawList->AddRect(view2BtnMin, view2BtnMax, IM_COL32(20, 20, 20, 255), 5.0f, 0, 1.0f);
+
+                const ImVec2 view2TextSize = ImGui::CalcTextSize("View");
+                ImGui::SetCursorPos(ImVec2(contentX + contentWidth - cardPadding - viewBtnWidth + (viewBtnWidth - view2TextSize.x) * 0.5f,
+                    card2Y + cardPadding + (viewBtnHeight - view2TextSize.y) * 0.5f));
+                ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+                ImGui::Text("View");
+                ImGui::PopStyleColor();
+
+                if (view2Hovered && ImGui::IsMouseClicked(0)) {
+                    selectedProductIndex = 1;
+                }
+            }
+        }
+        // Updates page
+        else if (selectedMenuItem == 1) {
+            const float contentX = verticalSeparatorX + 20.0f;
+            const float contentY = separatorY + 20.0f;
+            const float contentWidth = windowSize.x - verticalSeparatorX - 40.0f;
+
+            const float cardHeight = 135.0f;
+            const float cardPadding = 15.0f;
+
+            const float card1Y = contentY;
+            const ImVec2 updateCard1Min(windowPos.x + contentX, windowPos.y + card1Y);
+            const ImVec2 updateCard1Max(windowPos.x + contentX + contentWidth, windowPos.y + card1Y + cardHeight);
+
+            drawList->AddRect(updateCard1Min, updateCard1Max, IM_COL32(14, 14, 14, 255), 8.0f, 0, 1.0f);
+
+            const char* latestBadge = "LATEST";
+            const ImVec2 badgeSize = ImGui::CalcTextSize(latestBadge);
+            const float badgePadX = 10.0f;
+            const float badgePadY = 5.0f;
+            const ImVec2 badgeMin(updateCard1Max.x - badgeSize.x - badgePadX * 2 - cardPadding, updateCard1Min.y + cardPadding);
+            const ImVec2 badgeMax(updateCard1Max.x - cardPadding, updateCard1Min.y + cardPadding + badgeSize.y + badgePadY * 2);
+
+            drawList->AddRect(badgeMin, badgeMax, IM_COL32(14, 14, 14, 255), 4.0f, 0, 1.0f);
+
+            ImGui::SetCursorPos(ImVec2(contentX + contentWidth - badgeSize.x - badgePadX - cardPadding, card1Y + cardPadding + badgePadY));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            ImGui::Text("%s", latestBadge);
+            ImGui::PopStyleColor();
+
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card1Y + cardPadding));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+            if (interMedium) ImGui::PushFont(interMedium);
+            ImGui::Text("v2.3.1");
+            if (interMedium) ImGui::PopFont();
+            ImGui::PopStyleColor();
+
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding + 60.0f, card1Y + cardPadding));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            ImGui::Text("November 28, 2025");
+            ImGui::PopStyleColor();
+
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card1Y + cardPadding + 30.0f));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+            ImGui::Text("Performance Improvements & Bug Fixes");
+            ImGui::PopStyleColor();
+
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card1Y + cardPadding + 52.0f));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            ImGui::Text("- Optimized rendering engine for 30%% faster performance");
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card1Y + cardPadding + 70.0f));
+            ImGui::Text("- Fixed memory leak in authentication module");
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card1Y + cardPadding + 88.0f));
+            ImGui::Text("- Enhanced security protocols");
+            ImGui::PopStyleColor();
+
+            const float card2Y = card1Y + cardHeight + 15.0f;
+            const ImVec2 updateCard2Min(windowPos.x + contentX, windowPos.y + card2Y);
+            const ImVec2 updateCard2Max(windowPos.x + contentX + contentWidth, windowPos.y + card2Y + cardHeight);
+
+            drawList->AddRect(updateCard2Min, updateCard2Max, IM_COL32(14, 14, 14, 255), 8.0f, 0, 1.0f);
+
+            const char* stableBadge = "STABLE";
+            const ImVec2 stableBadgeSize = ImGui::CalcTextSize(stableBadge);
+            const ImVec2 stableBadgeMin(updateCard2Max.x - stableBadgeSize.x - badgePadX * 2 - cardPadding, updateCard2Min.y + cardPadding);
+            const ImVec2 stableBadgeMax(updateCard2Max.x - cardPadding, updateCard2Min.y + cardPadding + stableBadgeSize.y + badgePadY * 2);
+
+            drawList->AddRect(stableBadgeMin, stableBadgeMax, IM_COL32(14, 14, 14, 255), 4.0f, 0, 1.0f);
+
+            ImGui::SetCursorPos(ImVec2(contentX + contentWidth - stableBadgeSize.x - badgePadX - cardPadding, card2Y + cardPadding + badgePadY));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            ImGui::Text("%s", stableBadge);
+            ImGui::PopStyleColor();
+
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card2Y + cardPadding));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+            if (interMedium) ImGui::PushFont(interMedium);
+            ImGui::Text("v2.2.0");
+            if (interMedium) ImGui::PopFont();
+            ImGui::PopStyleColor();
+
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding + 60.0f, card2Y + cardPadding));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            ImGui::Text("November 15, 2025");
+            ImGui::PopStyleColor();
+
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card2Y + cardPadding + 30.0f));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Primary);
+            ImGui::Text("New Feature Release");
+            ImGui::PopStyleColor();
+
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card2Y + cardPadding + 52.0f));
+            ImGui::PushStyleColor(ImGuiCol_Text, Colors::Secondary);
+            ImGui::Text("- Added dark mode support across all components");
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card2Y + cardPadding + 70.0f));
+            ImGui::Text("- Implemented auto-update functionality");
+            ImGui::SetCursorPos(ImVec2(contentX + cardPadding, card2Y + cardPadding + 88.0f));
+            ImGui::Text("- New dashboard analytics");
+            ImGui::PopStyleColor();
+        }
+
+        // Injection notification
+        if (showLaunchNotification) {
+            scheduler.RequestAnimationFrame();
+            const double elapsedTime = clock.Now() - launchNotificationStartTime;
+            const int stage = (int)(elapsedTime / InjectionStageDuration);
+
+            if (stage < InjectionStageCount) {
+                injectionStage = stage;
+            } else {
+                showLaunchNotification = false;
+            }
+
+            if (injectionStage != previousInjectionStage) {
+                previousInjectionStage = injectionStage;
+                launchNotificationAlpha = 0.0f;
+                animator.Set(notificationSlide, 0.0f);
+                stageStartTime = clock.Now();
+            }
+
+            if (showLaunchNotification) {
+                const double stageElapsed = clock.Now() - stageStartTime;
+
+                if (stageElapsed < InjectionFadeDuration) {
+                    launchNotificationAlpha = (float)(stageElapsed / InjectionFadeDuration);
+                } else if (stageElapsed < InjectionStageDuration - InjectionFadeDuration) {
+                    launchNotificationAlpha = 1.0f;
+                } else if (stageElapsed < InjectionStageDuration) {
+                    launchNotificationAlpha = (float)((InjectionStageDuration - stageElapsed) / InjectionFadeDuration);
+                }
+
+                const float targetY = 20.0f;
+                const float launchNotificationY = animator.Toward(notificationSlide, targetY);
+
+                const char* notifText;
+                const char* notifIcon;
+                switch (injectionStage) {
+                    case 0:
+                        notifText = "Connecting..";
+                        notifIcon = reinterpret_cast<const char*>(u8"\ue064");
+                        break;
+                    case 1:
+                        notifText = "Resolving imports..";
+                        notifIcon = reinterpret_cast<const char*>(u8"\ue007");
+                        break;
+                    case 2:
+                        notifText = "Resolved imports [100%]";
+                        notifIcon = "S";
+                        break;
+                    case 3:
+                        notifText = "Injected successfully!";
+                        notifIcon = "S";
+                        break;
+                    default:
+                        notifText = "Injecting..";
+                        notifIcon = reinterpret_cast<const char*>(u8"\ue009");
+                        break;
+                }
+
+                const ImVec2 iconSize = ImGui::CalcTextSize(notifIcon);
+                const ImVec2 textSize = ImGui::CalcTextSize(notifText);
+                const float leftPadding = 15.0f;
+                const float iconTextSpacing = 8.0f;
+                const float rightPadding = 15.0f;
+                const float notifWidth = leftPadding + iconSize.x + iconTextSpacing + textSize.x + rightPadding;
+                const float notifHeight = 50.0f;
+                const float notifX = 5.0f;
+                const float notifY = windowSize.y - notifHeight + 15.0f - launchNotificationY;
+
+                const ImVec2 notifMin(windowPos.x + notifX, windowPos.y + notifY);
+                const ImVec2 notifMax(windowPos.x + notifX + notifWidth, windowPos.y + notifY + notifHeight);
+
+                if (bgTexture) {
+                    const float uvMinX = notifX / windowSize.x;
+                    const float uvMinY = notifY / windowSize.y;
+                    const float uvMaxX = (notifX + notifWidth) / windowSize.x;
+                    const float uvMaxY = (notifY + notifHeight) / windowSize.y;
+
+                    // the frost deepens as the panel fades in
+                    DrawFrostedBackground(drawList, notifMin, notifMax,
+                        ImVec2(uvMinX, uvMinY), ImVec2(uvMaxX, uvMaxY), launchNotificationAlpha, launchNotificationAlpha);
+                }
+                else {
+                    DrawBackgroundPlaceholder(drawList, notifMin, notifMax, launchNotificationAlpha);
+                }
+
+                const ImU32 notifBorder = IM_COL32(14, 14, 14, (int)(255 * launchNotificationAlpha));
+                drawList->AddRect(notifMin, notifMax, notifBorder, 8.0f, 0, 1.0f);
+
+                if (iconFont) ImGui::PushFont(iconFont);
+                const float iconX = notifX + leftPadding;
+                const float iconY = notifY + (notifHeight - iconSize.y) * 0.5f;
+
+                ImGui::SetCursorPos(ImVec2(iconX, iconY));
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(
+                    Colors::Primary.x,
+                    Colors::Primary.y,
+                    Colors::Primary.z,
+                    launchNotificationAlpha
+                ));
+                ImGui::Text("%s", notifIcon);
+                ImGui::PopStyleColor();
+                if (iconFont) ImGui::PopFont();
+
+                const float extraSpacing = (injectionStage == 2 || injectionStage == 3) ? 2.0f : 0.0f;
+                const float textX = iconX + iconSize.x + iconTextSpacing + extraSpacing;
+                const float textY = notifY + (notifHeight - textSize.y) * 0.5f - 2.0f;
+
+                ImGui::SetCursorPos(ImVec2(textX, textY));
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(
+                    Colors::Primary.x,
+                    Colors::Primary.y,
+                    Colors::Primary.z,
+                    launchNotificationAlpha
+                ));
+                ImGui::Text("%s", notifText);
+                ImGui::PopStyleColor();
+            }
+        }
+
+        ImGui::End();
+    }
+
+    void Cleanup() {
+        // releases everything once nothing references it
+        bgTexture.Reset();
+        for (TextureRef& blurred : bgBlurred) blurred.Reset();
+        textures.SetBudget(0);
+
+        renderer.Shutdown();
+        platform.Shutdown();
+        if (ImGui::GetCurrentContext()) ImGui::DestroyContext();
+    }
+};
@@ -0,0 +1,510 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BC_ENCODER_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "thread_pool.h"
+
+// CPU block compression of RGBA8 images
+//
+// BC1 for opaque images, BC3 or BC7 (mode 6) when alpha matters. Endpoints
+// start on the principal axis of each 4x4 block and get one least-squares
+// refinement; index selection tests every palette entry, four pixels at a
+// time with SSE2. Rows of blocks are spread across a ThreadPool.
+namespace BcEncoder {
+    enum class Format { BC1, BC3, BC7 };
+
+    inline size_t BlockBytes(Format format) { return format == Format::BC1 ? 8 : 16; }
+
+    inline size_t CompressedSize(Format format, int width, int height) {
+        return (size_t)((width + 3) / 4) * ((height + 3) / 4) * BlockBytes(format);
+    }
+
+    inline bool HasAlpha(const uint8_t* rgba, int width, int height) {
+        const size_t count = (size_t)width * height;
+        for (size_t i = 0; i < count; i++) {
+            if (rgba[i * 4 + 3] != 255) return true;
+        }
+        return false;
+    }
+
+    // Block pixels as structure of arrays, one row of 16 per channel
+    struct Block {
+        alignas(16) float c[4][16];
+    };
+
+    inline void LoadBlock(const uint8_t* rgba, int width, int height, int bx, int by, Block& block) {
+        // edge blocks repeat the last row/column so padding doesn't pull endpoints
+        for (int i = 0; i < 16; i++) {
+            const int x = std::min(bx * 4 + (i & 3), width - 1);
+            const int y = std::min(by * 4 + (i >> 2), height - 1);
+            const uint8_t* p = rgba + ((size_t)y * width + x) * 4;
+            for (int c = 0; c < 4; c++) block.c[c][i] = p[c];
+        }
+    }
+
+    // Picks the nearest palette entry for each pixel over the first `channels`
+    // channels; returns the summed squared error
+    inline float NearestIndices(const Block& block, int channels, const float (*palette)[4], int count, uint8_t indices[16]) {
+        float total = 0.0f;
+#ifdef BC_ENCODER_SSE2
+        for (int i = 0; i < 16; i += 4) {
+            __m128 best = _mm_set1_ps(FLT_MAX);
+            __m128i bestIndex = _mm_setzero_si128();
+            for (int k = 0; k < count; k++) {
+                __m128 error = _mm_setzero_ps();
+                for (int c = 0; c < channels; c++) {
+                    const __m128 d = _mm_sub_ps(_mm_load_ps(block.c[c] + i), _mm_set1_ps(palette[k][c]));
+                    error = _mm_add_ps(error, _mm_mul_ps(d, d));
+                }
+                const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(error, best));
+                best = _mm_min_ps(error, best);
+                bestIndex = _mm_or_si128(_mm_andnot_si128(closer, bestIndex), _mm_and_si128(closer, _mm_set1_epi32(k)));
+            }
+            alignas(16) float errors[4];
+            alignas(16) int32_t chosen[4];
+            _mm_store_ps(errors, best);
+            _mm_store_si128((__m128i*)chosen, bestIndex);
+            for (int j = 0; j < 4; j++) {
+                indices[i + j] = (uint8_t)chosen[j];
+                total += errors[j];
+            }
+        }
+#else
+        for (int i = 0; i < 16; i++) {
+            float best = FLT_MAX;
+            for (int k = 0; k < count; k++) {
+                float error = 0.0f;
+                for (int c = 0; c < channels; c++) {
+                    const float d = block.c[c][i] - palette[k][c];
+                    error += d * d;
+                }
+                if (error < best) {
+                    best = error;
+                    indices[i] = (uint8_t)k;
+                }
+            }
+            total += best;
+        }
+#endif
+        return total;
+    }
+
+    // Endpoints at the extremes of the block's principal axis
+    inline void FitEndpoints(const Block& block, int channels, float e0[4], float e1[4]) {
+        float mean[4] = {};
+        for (int c = 0; c < channels; c++) {
+            for (int i = 0; i < 16; i++) mean[c] += block.c[c][i];
+            mean[c] /= 16.0f;
+        }
+
+        float cov[4][4] = {};
+        for (int i = 0; i < 16; i++) {
+            for (int a = 0; a < channels; a++) {
+                for (int b = a; b < channels; b++) {
+                    cov[a][b] += (block.c[a][i] - mean[a]) * (block.c[b][i] - mean[b]);
+                }
+            }
+        }
+        for (int a = 0; a < channels; a++) {
+            for (int b = 0; b < a; b++) cov[a][b] = cov[b][a];
+        }
+
+        // power iteration, seeded with the channel of largest variance
+        float axis[4] = {};
+        int seed = 0;
+        for (int c = 1; c < channels; c++) {
+            if (cov[c][c] > cov[seed][seed]) seed = c;
+        }
+        for (int c = 0; c < channels; c++) axis[c] = cov[seed][c];
+        for (int iter = 0; iter < 8; iter++) {
+            float next[4] = {};
+            float length = 0.0f;
+            for (int a = 0; a < channels; a++) {
+                for (int b = 0; b < channels; b++) next[a] += cov[a][b] * axis[b];
+                length += next[a] * next[a];
+            }
+            if (length < 1e-12f) break;
+            length = 1.0f / sqrtf(length);
+            for (int c = 0; c < channels; c++) axis[c] = next[c] * length;
+        }
+
+        float lo = 0.0f, hi = 0.0f;
+        for (int i = 0; i < 16; i++) {
+            float t = 0.0f;
+            for (int c = 0; c < channels; c++) t += (block.c[c][i] - mean[c]) * axis[c];
+            lo = std::min(lo, t);
+            hi = std::max(hi, t);
+        }
+        for (int c = 0; c < 4; c++) {
+            e0[c] = c < channels ? std::clamp(mean[c] + lo * axis[c], 0.0f, 255.0f) : 255.0f;
+            e1[c] = c < channels ? std::clamp(mean[c] + hi * axis[c], 0.0f, 255.0f) : 255.0f;
+        }
+    }
+
+    // Least-squares endpoints for fixed interpolation weights (0 = e0, 1 = e1)
+    inline void RefineEndpoints(const Block& block, int channels, const float weights[16], float e0[4], float e1[4]) {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        float ap[4] = {}, bp[4] = {};
+        for (int i = 0; i < 16; i++) {
+            const float b = weights[i];
+            const float a = 1.0f - b;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (int c = 0; c < channels; c++) {
+                ap[c] += a * block.c[c][i];
+                bp[c] += b * block.c[c][i];
+            }
+        }
+        const float det = aa * bb - ab * ab;
+        if (fabsf(det) < 1e-6f) return;
+        for (int c = 0; c < channels; c++) {
+            e0[c] = std::clamp((ap[c] * bb - bp[c] * ab) / det, 0.0f, 255.0f);
+            e1[c] = std::clamp((bp[c] * aa - ap[c] * ab) / det, 0.0f, 255.0f);
+        }
+    }
+
+    inline uint16_t To565(const float c[4]) {
+        const int r = std::clamp((int)lrintf(c[0] * 31.0f / 255.0f), 0, 31);
+        const int g = std::clamp((int)lrintf(c[1] * 63.0f / 255.0f), 0, 63);
+        const int b = std::clamp((int)lrintf(c[2] * 31.0f / 255.0f), 0, 31);
+        return (uint16_t)(r << 11 | g << 5 | b);
+    }
+
+    inline void From565(uint16_t v, int out[3]) {
+        const int r = v >> 11, g = (v >> 5) & 63, b = v & 31;
+        out[0] = r << 3 | r >> 2;
+        out[1] = g << 2 | g >> 4;
+        out[2] = b << 3 | b >> 2;
+    }
+
+    // Four-colour BC1 block; BC3 reuses it for its colour half
+    inline void EncodeColorBlock(const Block& block, uint8_t out[8]) {
+        float e0[4], e1[4];
+        FitEndpoints(block, 3, e0, e1);
+
+        float bestError = FLT_MAX;
+        uint16_t best0 = 0, best1 = 0;
+        uint8_t bestLinear[16] = {};
+        for (int pass = 0; pass < 2; pass++) {
+            const uint16_t q0 = To565(e0), q1 = To565(e1);
+            int c0[3], c1[3];
+            From565(q0, c0);
+            From565(q1, c1);
+            float palette[4][4] = {};
+            for (int c = 0; c < 3; c++) {
+                palette[0][c] = (float)c0[c];
+                palette[1][c] = (float)((2 * c0[c] + c1[c]) / 3);
+                palette[2][c] = (float)((c0[c] + 2 * c1[c]) / 3);
+                palette[3][c] = (float)c1[c];
+            }
+
+            uint8_t linear[16];
+            const float error = NearestIndices(block, 3, palette, 4, linear);
+            if (error < bestError) {
+                bestError = error;
+                best0 = q0;
+                best1 = q1;
+                memcpy(bestLinear, linear, 16);
+            }
+            if (error == 0.0f) break;
+
+            float weights[16];
+            for (int i = 0; i < 16; i++) weights[i] = linear[i] / 3.0f;
+            RefineEndpoints(block, 3, weights, e0, e1);
+        }
+
+        // four-colour mode needs c0 > c1
+        if (best0 < best1) {
+            std::swap(best0, best1);
+            for (uint8_t& l : bestLinear) l = (uint8_t)(3 - l);
+        }
+        else if (best0 == best1) {
+            memset(bestLinear, 0, sizeof(bestLinear));
+        }
+
+        static constexpr uint8_t code[4] = { 0, 2, 3, 1 };
+        uint32_t bits = 0;
+        for (int i = 0; i < 16; i++) bits |= (uint32_t)code[bestLinear[i]] << (i * 2);
+        out[0] = (uint8_t)best0;
+        out[1] = (uint8_t)(best0 >> 8);
+        out[2] = (uint8_t)best1;
+        out[3] = (uint8_t)(best1 >> 8);
+        memcpy(out + 4, &bits, 4);
+    }
+
+    // BC3 alpha half: eight-level interpolation between the block's extremes
+    inline void EncodeAlphaBlock(const Block& block, uint8_t out[8]) {
+        float lo = 255.0f, hi = 0.0f;
+        for (int i = 0; i < 16; i++) {
+            lo = std::min(lo, block.c[3][i]);
+            hi = std::max(hi, block.c[3][i]);
+        }
+        const int a0 = (int)hi, a1 = (int)lo;
+        out[0] = (uint8_t)a0;
+        out[1] = (uint8_t)a1;
+
+        uint64_t bits = 0;
+        if (a0 != a1) {
+            static constexpr uint8_t code[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+            for (int i = 0; i < 16; i++) {
+                int best = 0, bestError = INT32_MAX;
+                for (int k = 0; k < 8; k++) {
+                    const int value = ((7 - k) * a0 + k * a1) / 7;
+                    const int error = std::abs(value - (int)block.c[3][i]);
+                    if (error < bestError) {
+                        bestError = error;
+                        best = k;
+                    }
+                }
+                bits |= (uint64_t)code[best] << (i * 3);
+            }
+        }
+        for (int i = 0; i < 6; i++) out[2 + i] = (uint8_t)(bits >> (i * 8));
+    }
+
+    // BC7 mode 6: one subset, RGBA 7.7.7.7 endpoints plus a p-bit each, 4-bit indices
+    namespace Bc7 {
+        constexpr int Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        struct BitWriter {
+            uint8_t* out;
+            int pos{ 0 };
+
+            void Put(uint32_t value, int count) {
+                for (int i = 0; i < count; i++, pos++) {
+                    if (value >> i & 1) out[pos >> 3] |= (uint8_t)(1 << (pos & 7));
+                }
+            }
+        };
+
+        struct BitReader {
+            const uint8_t* in;
+            int pos{ 0 };
+
+            uint32_t Get(int count) {
+                uint32_t value = 0;
+                for (int i = 0; i < count; i++, pos++) value |= (uint32_t)(in[pos >> 3] >> (pos & 7) & 1) << i;
+                return value;
+            }
+        };
+
+        // Quantizes an endpoint to 7 bits per channel plus the shared p-bit that fits best
+        inline void Quantize(const float e[4], uint8_t q[4], uint8_t& pbit) {
+            float bestError = FLT_MAX;
+            for (int p = 0; p < 2; p++) {
+                uint8_t candidate[4];
+                float error = 0.0f;
+                for (int c = 0; c < 4; c++) {
+                    candidate[c] = (uint8_t)std::clamp((int)lrintf((e[c] - p) / 2.0f), 0, 127);
+                    const float d = (float)(candidate[c] << 1 | p) - e[c];
+                    error += d * d;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    memcpy(q, candidate, 4);
+                    pbit = (uint8_t)p;
+                }
+            }
+        }
+
+        inline void EncodeBlock(const Block& block, uint8_t out[16]) {
+            float e0[4], e1[4];
+            FitEndpoints(block, 4, e0, e1);
+
+            float bestError = FLT_MAX;
+            uint8_t best[2][4] = {}, bestP[2] = {}, bestIndices[16] = {};
+            for (int pass = 0; pass < 2; pass++) {
+                uint8_t q[2][4], p[2];
+                Quantize(e0, q[0], p[0]);
+                Quantize(e1, q[1], p[1]);
+
+                float palette[16][4];
+                for (int k = 0; k < 16; k++) {
+                    for (int c = 0; c < 4; c++) {
+                        const int v0 = q[0][c] << 1 | p[0], v1 = q[1][c] << 1 | p[1];
+                        palette[k][c] = (float)(((64 - Weights[k]) * v0 + Weights[k] * v1 + 32) >> 6);
+                    }
+                }
+
+                uint8_t indices[16];
+                const float error = NearestIndices(block, 4, palette, 16, indices);
+                if (error < bestError) {
+                    bestError = error;
+                    memcpy(best, q, sizeof(best));
+                    memcpy(bestP, p, sizeof(bestP));
+                    memcpy(bestIndices, indices, 16);
+                }
+                if (error == 0.0f) break;
+
+                float weights[16];
+                for (int i = 0; i < 16; i++) weights[i] = Weights[indices[i]] / 64.0f;
+                RefineEndpoints(block, 4, weights, e0, e1);
+            }
+
+            // the anchor (first) index is stored with its top bit implied zero
+            if (bestIndices[0] & 8) {
+                std::swap(best[0], best[1]);
+                std::swap(bestP[0], bestP[1]);
+                for (uint8_t& i : bestIndices) i = (uint8_t)(15 - i);
+            }
+
+            memset(out, 0, 16);
+            BitWriter writer{ out };
+            writer.Put(1 << 6, 7);
+            for (int c = 0; c < 4; c++) {
+                writer.Put(best[0][c], 7);
+                writer.Put(best[1][c], 7);
+            }
+            writer.Put(bestP[0], 1);
+            writer.Put(bestP[1], 1);
+            writer.Put(bestIndices[0], 3);
+            for (int i = 1; i < 16; i++) writer.Put(bestIndices[i], 4);
+        }
+
+        // Decodes mode 6 only (what EncodeBlock emits); other modes come out black
+        inline void DecodeBlock(const uint8_t in[16], uint8_t rgba[64]) {
+            memset(rgba, 0, 64);
+            if ((in[0] & 0x7f) != 0x40) return;
+            BitReader reader{ in, 7 };
+            int v[2][4];
+            for (int c = 0; c < 4; c++) {
+                v[0][c] = (int)reader.Get(7) << 1;
+                v[1][c] = (int)reader.Get(7) << 1;
+            }
+            const uint32_t p0 = reader.Get(1), p1 = reader.Get(1);
+            for (int c = 0; c < 4; c++) {
+                v[0][c] |= p0;
+                v[1][c] |= p1;
+            }
+            for (int i = 0; i < 16; i++) {
+                const int w = Weights[reader.Get(i == 0 ? 3 : 4)];
+                for (int c = 0; c < 4; c++) rgba[i * 4 + c] = (uint8_t)(((64 - w) * v[0][c] + w * v[1][c] + 32) >> 6);
+            }
+        }
+    }
+
+    inline void EncodeBlock(Format format, const Block& block, uint8_t* out) {
+        switch (format) {
+        case Format::BC1:
+            EncodeColorBlock(block, out);
+            break;
+        case Format::BC3:
+            EncodeAlphaBlock(block, out);
+            EncodeColorBlock(block, out + 8);
+            break;
+        case Format::BC7:
+            Bc7::EncodeBlock(block, out);
+            break;
+        }
+    }
+
+    inline void DecodeColorBlock(const uint8_t in[8], uint8_t rgba[64]) {
+        const uint16_t q0 = (uint16_t)(in[0] | in[1] << 8), q1 = (uint16_t)(in[2] | in[3] << 8);
+        int c0[3], c1[3];
+        From565(q0, c0);
+        From565(q1, c1);
+        int palette[4][4];
+        for (int c = 0; c < 3; c++) {
+            palette[0][c] = c0[c];
+            palette[1][c] = c1[c];
+            palette[2][c] = q0 > q1 ? (2 * c0[c] + c1[c]) / 3 : (c0[c] + c1[c]) / 2;
+            palette[3][c] = q0 > q1 ? (c0[c] + 2 * c1[c]) / 3 : 0;
+        }
+        palette[0][3] = palette[1][3] = palette[2][3] = 255;
+        palette[3][3] = q0 > q1 ? 255 : 0;
+
+        uint32_t bits;
+        memcpy(&bits, in + 4, 4);
+        for (int i = 0; i < 16; i++) {
+            const int* p = palette[bits >> (i * 2) & 3];
+            for (int c = 0; c < 4; c++) rgba[i * 4 + c] = (uint8_t)p[c];
+        }
+    }
+
+    inline void DecodeAlphaBlock(const uint8_t in[8], uint8_t rgba[64]) {
+        const int a0 = in[0], a1 = in[1];
+        int palette[8] = { a0, a1 };
+        for (int k = 2; k < 8; k++) {
+            palette[k] = a0 > a1 ? ((8 - k) * a0 + (k - 1) * a1) / 7
+                : k < 6 ? ((7 - k) * a0 + (k - 1) * a1) / 5
+                : k == 6 ? 0 : 255;
+        }
+        uint64_t bits = 0;
+        for (int i = 0; i < 6; i++) bits |= (uint64_t)in[2 + i] << (i * 8);
+        for (int i = 0; i < 16; i++) rgba[i * 4 + 3] = (uint8_t)palette[bits >> (i * 3) & 7];
+    }
+
+    inline void DecodeBlock(Format format, const uint8_t* in, uint8_t rgba[64]) {
+        switch (format) {
+        case Format::BC1:
+            DecodeColorBlock(in, rgba);
+            break;
+        case Format::BC3:
+            DecodeColorBlock(in + 8, rgba);
+            DecodeAlphaBlock(in, rgba);
+            break;
+        case Format::BC7:
+            Bc7::DecodeBlock(in, rgba);
+            break;
+        }
+    }
+
+    // Compresses a tightly packed RGBA8 image; with a pool, rows of blocks are
+    // encoded in parallel. Must not be called from inside a pool task.
+    inline std::vector<uint8_t> Encode(const uint8_t* rgba, int width, int height, Format format, ThreadPool* pool = nullptr) {
+        const int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+        const size_t blockBytes = BlockBytes(format);
+        std::vector<uint8_t> out(CompressedSize(format, width, height));
+
+        auto encodeRows = [&, blocksX, blockBytes](int firstRow, int lastRow) {
+            Block block;
+            for (int by = firstRow; by < lastRow; by++) {
+                for (int bx = 0; bx < blocksX; bx++) {
+                    LoadBlock(rgba, width, height, bx, by, block);
+                    EncodeBlock(format, block, out.data() + ((size_t)by * blocksX + bx) * blockBytes);
+                }
+            }
+        };
+
+        if (!pool) {
+            encodeRows(0, blocksY);
+            return out;
+        }
+
+        // a few tasks per thread so stealing can even out slow rows
+        const int tasks = std::max(1, std::min(blocksY, (int)pool->ThreadCount() * 4));
+        for (int t = 0; t < tasks; t++) {
+            const int first = blocksY * t / tasks, last = blocksY * (t + 1) / tasks;
+            pool->Submit([&encodeRows, first, last] { encodeRows(first, last); });
+        }
+        pool->Wait();
+        return out;
+    }
+
+    inline std::vector<uint8_t> Decode(const uint8_t* blocks, int width, int height, Format format) {
+        const int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+        std::vector<uint8_t> rgba((size_t)width * height * 4);
+        uint8_t texels[64];
+        for (int by = 0; by < blocksY; by++) {
+            for (int bx = 0; bx < blocksX; bx++) {
+                DecodeBlock(format, blocks + ((size_t)by * blocksX + bx) * BlockBytes(format), texels);
+                for (int i = 0; i < 16; i++) {
+                    const int x = bx * 4 + (i & 3), y = by * 4 + (i >> 2);
+                    if (x < width && y < height) memcpy(&rgba[((size_t)y * width + x) * 4], texels + i * 4, 4);
+                }
+            }
+        }
+        return rgba;
+    }
+}
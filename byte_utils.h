@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Byte helpers shared by the cache, captures and scripts: a content hash,
+// an LZ4 block codec and whole-file reads. Standard library only, so the
+// headers that need one of these don't pull in stb_image and the cache.
+
+// 64-bit content hash: four multiply-rotate lanes over 32-byte stripes
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0) {
+    constexpr uint64_t P1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t P3 = 0x165667B19E3779F9ull;
+    auto rotl = [](uint64_t v, int r) { return (v << r) | (v >> (64 - r)); };
+    auto read64 = [](const unsigned char* p) { uint64_t v; memcpy(&v, p, 8); return v; };
+    auto round = [&](uint64_t acc, uint64_t input) { return rotl(acc + input * P2, 31) * P1; };
+
+    const unsigned char* p = (const unsigned char*)data;
+    const unsigned char* end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        uint64_t v[4] = { seed + P1 + P2, seed + P2, seed, seed - P1 };
+        for (; p + 32 <= end; p += 32) {
+            for (int i = 0; i < 4; i++) v[i] = round(v[i], read64(p + i * 8));
+        }
+        h = rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18);
+        for (int i = 0; i < 4; i++) h = (h ^ round(0, v[i])) * P1 + P3;
+    }
+    else {
+        h = seed + P3;
+    }
+
+    h += size;
+    for (; p + 8 <= end; p += 8) h = rotl(h ^ round(0, read64(p)), 27) * P1 + P3;
+    for (; p < end; p++) h = rotl(h ^ (*p * P3), 11) * P1;
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+// LZ4 block format (no frame header), enough for cache payloads
+namespace Lz4 {
+    inline void PutLength(std::vector<unsigned char>& out, size_t len) {
+        while (len >= 255) {
+            out.push_back(255);
+            len -= 255;
+        }
+        out.push_back((unsigned char)len);
+    }
+
+    inline void PutSequence(std::vector<unsigned char>& out, const unsigned char* literals, size_t litLen, size_t offset, size_t matchLen) {
+        const size_t m = matchLen ? matchLen - 4 : 0;
+        out.push_back((unsigned char)((std::min<size_t>(litLen, 15) << 4) | std::min<size_t>(m, 15)));
+        if (litLen >= 15) PutLength(out, litLen - 15);
+        out.insert(out.end(), literals, literals + litLen);
+        if (!matchLen) return;
+        out.push_back((unsigned char)offset);
+        out.push_back((unsigned char)(offset >> 8));
+        if (m >= 15) PutLength(out, m - 15);
+    }
+
+    inline std::vector<unsigned char> Compress(const unsigned char* src, size_t size) {
+        std::vector<unsigned char> out;
+        out.reserve(size / 2 + 16);
+        // the format requires the last 5 bytes to be literals and the last
+        // match to start at least 12 bytes before the end
+        const size_t matchLimit = size > 12 ? size - 12 : 0;
+        const size_t endLimit = size > 5 ? size - 5 : 0;
+        constexpr int HashBits = 16;
+        std::vector<int64_t> table((size_t)1 << HashBits, -1);
+        auto read32 = [&](size_t i) { uint32_t v; memcpy(&v, src + i, 4); return v; };
+        auto hash = [&](uint32_t v) { return (v * 2654435761u) >> (32 - HashBits); };
+
+        size_t anchor = 0, i = 0;
+        while (i < matchLimit) {
+            const uint32_t seq = read32(i);
+            int64_t& slot = table[hash(seq)];
+            const int64_t cand = slot;
+            slot = (int64_t)i;
+            if (cand < 0 || i - (size_t)cand > 65535 || read32((size_t)cand) != seq) {
+                i++;
+                continue;
+            }
+            size_t len = 4;
+            while (i + len < endLimit && src[cand + len] == src[i + len]) len++;
+            PutSequence(out, src + anchor, i - anchor, i - (size_t)cand, len);
+            i += len;
+            anchor = i;
+        }
+        PutSequence(out, src + anchor, size - anchor, 0, 0);
+        return out;
+    }
+
+    inline bool Decompress(const unsigned char* src, size_t srcSize, unsigned char* dst, size_t dstSize) {
+        const unsigned char* ip = src;
+        const unsigned char* const iend = src + srcSize;
+        unsigned char* op = dst;
+        unsigned char* const oend = dst + dstSize;
+
+        auto getLength = [&](size_t len) -> size_t {
+            if (len != 15) return len;
+            unsigned char b;
+            do {
+                if (ip >= iend) return SIZE_MAX;
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+            return len;
+        };
+
+        while (ip < iend) {
+            const unsigned char token = *ip++;
+            const size_t litLen = getLength(token >> 4);
+            if (litLen == SIZE_MAX || litLen > (size_t)(iend - ip) || litLen > (size_t)(oend - op)) return false;
+            memcpy(op, ip, litLen);
+            ip += litLen;
+            op += litLen;
+            if (ip == iend) break;
+
+            if (iend - ip < 2) return false;
+            const size_t offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+            const size_t matchLen = getLength(token & 15);
+            if (matchLen == SIZE_MAX || offset == 0 || offset > (size_t)(op - dst) || matchLen + 4 > (size_t)(oend - op)) return false;
+            const unsigned char* match = op - offset;
+            for (size_t k = 0; k < matchLen + 4; k++) op[k] = match[k];
+            op += matchLen + 4;
+        }
+        return op == oend;
+    }
+}
+
+inline bool ReadFileBytes(const std::string& path, std::vector<unsigned char>& out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    const std::streamsize size = file.tellg();
+    if (size < 0) return false;
+    out.resize((size_t)size);
+    file.seekg(0);
+    return (bool)file.read((char*)out.data(), size);
+}
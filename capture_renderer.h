@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "imgui.h"
+#include "draw_capture.h"
+#include "draw_fingerprint.h"
+#include "platform.h"
+#include "texture_loader.h"
+
+// IRenderer that records every frame to a DrawCapture file on the way to
+// another renderer
+//
+// Wraps the real renderer, so the app runs and looks as usual. Textures are
+// recorded as they are created, decoded to RGBA8 from the same prepared
+// data the inner renderer uploads, along with the font atlas; ids that
+// appear in a frame without having been created here (a texture the app
+// made some other way) are recorded without pixels. Callbacks are recorded
+// as the state they select: the inner renderer's premultiplied marker is
+// found by watching what AddImagePremultiplied() adds.
+class CaptureRenderer : public IRenderer {
+    IRenderer& inner;
+    std::string path;
+    DrawCapture::Writer writer;
+    DrawFingerprint fingerprint;
+    std::unordered_map<void*, uint32_t> textureIds;
+    uint32_t nextId{ 1 };
+    uint64_t textureEpoch{ 0 };
+    void* fontTexture{ nullptr };
+    ImDrawCallback premultipliedMarker{ nullptr };
+    std::vector<uint8_t> buffer;
+    std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+    uint64_t frames{ 0 };
+
+    template<typename T>
+    void Append(const T& value) {
+        const uint8_t* bytes = (const uint8_t*)&value;
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    uint32_t RecordTexture(void* texture, int width, int height, const uint8_t* rgba) {
+        const uint32_t id = nextId++;
+        textureIds[texture] = id;
+        textureEpoch++;
+        buffer.clear();
+        Append(DrawCapture::TextureHeader{ id, width, height });
+        if (rgba) buffer.insert(buffer.end(), rgba, rgba + (size_t)width * height * 4);
+        writer.Write(DrawCapture::RecordType::Texture, buffer.data(), buffer.size());
+        return id;
+    }
+
+    uint32_t TextureId(void* texture) {
+        if (!texture) return 0;
+        const auto it = textureIds.find(texture);
+        return it != textureIds.end() ? it->second : RecordTexture(texture, 0, 0, nullptr);
+    }
+
+    void RecordFrame(const ImDrawData* data, const ImVec4& clearColor) {
+        // ids are resolved first: recording an unknown texture reuses the buffer
+        for (int i = 0; data && i < data->CmdListsCount; i++) {
+            for (const ImDrawCmd& cmd : data->CmdLists[i]->CmdBuffer) TextureId(cmd.GetTexID());
+        }
+
+        frames++;
+        if (fingerprint.Unchanged(data, HashBytes(&clearColor, sizeof(clearColor), textureEpoch))) {
+            writer.Write(DrawCapture::RecordType::Repeat, nullptr, 0);
+            return;
+        }
+
+        buffer.clear();
+        DrawCapture::FrameHeader header{};
+        header.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        header.clearColor[0] = clearColor.x;
+        header.clearColor[1] = clearColor.y;
+        header.clearColor[2] = clearColor.z;
+        header.clearColor[3] = clearColor.w;
+        if (data) {
+            header.displayPos[0] = data->DisplayPos.x;
+            header.displayPos[1] = data->DisplayPos.y;
+            header.displaySize[0] = data->DisplaySize.x;
+            header.displaySize[1] = data->DisplaySize.y;
+            header.listCount = (uint32_t)data->CmdListsCount;
+        }
+        Append(header);
+
+        for (uint32_t i = 0; i < header.listCount; i++) {
+            const ImDrawList* list = data->CmdLists[(int)i];
+            Append(DrawCapture::ListHeader{ (uint32_t)list->VtxBuffer.Size, (uint32_t)list->IdxBuffer.Size, (uint32_t)list->CmdBuffer.Size });
+            const uint8_t* vertices = (const uint8_t*)list->VtxBuffer.Data;
+            const uint8_t* indices = (const uint8_t*)list->IdxBuffer.Data;
+            buffer.insert(buffer.end(), vertices, vertices + (size_t)list->VtxBuffer.Size * sizeof(ImDrawVert));
+            buffer.insert(buffer.end(), indices, indices + (size_t)list->IdxBuffer.Size * sizeof(ImDrawIdx));
+
+            for (const ImDrawCmd& cmd : list->CmdBuffer) {
+                DrawCapture::Callback callback = DrawCapture::Callback::None;
+                if (cmd.UserCallback == ImDrawCallback_ResetRenderState) callback = DrawCapture::Callback::ResetRenderState;
+                else if (cmd.UserCallback && cmd.UserCallback == premultipliedMarker) callback = DrawCapture::Callback::PremultipliedBlend;
+                else if (cmd.UserCallback) callback = DrawCapture::Callback::Other;
+
+                const auto id = textureIds.find(cmd.GetTexID());
+                Append(DrawCapture::Command{ { cmd.ClipRect.x, cmd.ClipRect.y, cmd.ClipRect.z, cmd.ClipRect.w },
+                    id != textureIds.end() ? id->second : 0, cmd.VtxOffset, cmd.IdxOffset, cmd.ElemCount, (uint32_t)callback });
+            }
+        }
+        writer.Write(DrawCapture::RecordType::Frame, buffer.data(), buffer.size());
+    }
+
+public:
+    CaptureRenderer(IRenderer& inner, std::string path) : inner(inner), path(std::move(path)) {}
+
+    bool Initialize(IPlatform& platform) override {
+        if (!writer.Open(path, (uint32_t)sizeof(ImDrawVert), (uint32_t)sizeof(ImDrawIdx))) {
+            platform.Log(("Can't write the capture " + path + "\n").c_str());
+        }
+        return inner.Initialize(platform);
+    }
+
+    void Shutdown() override {
+        writer.Close();
+        inner.Shutdown();
+    }
+
+    // The inner renderer builds the font atlas texture; its pixels are
+    // still on the CPU side, so they are recorded from there
+    void NewFrame() override {
+        inner.NewFrame();
+        ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+        if (!fonts->TexID || fonts->TexID == fontTexture) return;
+        fontTexture = fonts->TexID;
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        RecordTexture(fontTexture, width, height, pixels);
+    }
+
+    void Render(const ImVec4& clearColor) override {
+        if (writer.IsOpen()) RecordFrame(ImGui::GetDrawData(), clearColor);
+        inner.Render(clearColor);
+    }
+
+    void Resize(int width, int height) override { inner.Resize(width, height); }
+    bool SupportsBC7() const override { return inner.SupportsBC7(); }
+
+    void* CreateTexture(const TextureLoader::Prepared& prepared) override {
+        void* texture = inner.CreateTexture(prepared);
+        if (!texture || !writer.IsOpen()) return texture;
+        std::vector<uint8_t> rgba;
+        int width = 0, height = 0;
+        if (TextureLoader::DecodeTopLevel(prepared, rgba, width, height)) RecordTexture(texture, width, height, rgba.data());
+        else RecordTexture(texture, 0, 0, nullptr);
+        return texture;
+    }
+
+    void ReleaseTexture(void* texture) override {
+        const auto it = textureIds.find(texture);
+        if (it != textureIds.end()) {
+            writer.Write(DrawCapture::RecordType::Release, &it->second, sizeof(it->second));
+            textureIds.erase(it);
+            textureEpoch++;
+        }
+        inner.ReleaseTexture(texture);
+    }
+
+    void AddImagePremultiplied(ImDrawList* drawList, void* texture, const ImVec2& min, const ImVec2& max,
+        const ImVec2& uvMin, const ImVec2& uvMax, float alpha) override {
+        // AddCallback() may reuse the last command when it is still empty
+        const int first = std::max(0, drawList->CmdBuffer.Size - 1);
+        inner.AddImagePremultiplied(drawList, texture, min, max, uvMin, uvMax, alpha);
+        for (int i = first; i < drawList->CmdBuffer.Size && !premultipliedMarker; i++) {
+            const ImDrawCallback callback = drawList->CmdBuffer[i].UserCallback;
+            if (callback && callback != ImDrawCallback_ResetRenderState) premultipliedMarker = callback;
+        }
+    }
+
+    uint64_t Frames() const { return frames; }
+    uint64_t Bytes() const { return writer.Bytes(); }
+    uint64_t RawBytes() const { return writer.RawBytes(); }
+    uint64_t RepeatedFrames() const { return fingerprint.GetStats().skipped; }
+};
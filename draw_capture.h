@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "byte_utils.h"
+
+// Recorded ImDrawData, for replaying real frames without the app
+//
+// A capture is a FileHeader and then records in the order they happened:
+// textures as they are created (RGBA8 pixels, ids counting up from 1 and
+// never reused) and released, and one record per rendered frame. A frame
+// holds the display rect, the clear colour and every draw list's vertices,
+// indices and commands, with texture ids translated to capture ids and
+// callbacks reduced to the render state they select. A frame identical to
+// the previous one is a Repeat record with no payload. Payloads are LZ4
+// compressed when that makes them smaller. Everything is stored in native
+// byte order, as written by the little-endian machines the app runs on.
+//
+// This header has no ImGui dependency: CaptureRenderer (capture_renderer.h)
+// writes captures from a running app, and Load() reads them back for tools.
+namespace DrawCapture {
+    constexpr char Magic[4] = { 'I', 'M', 'D', 'C' };
+    constexpr uint32_t Version = 1;
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t vertexSize;  // sizeof(ImDrawVert): pos, uv, packed colour
+        uint32_t indexSize;   // sizeof(ImDrawIdx)
+    };
+
+    enum class RecordType : uint32_t { Texture = 1, Release = 2, Frame = 3, Repeat = 4 };
+
+    struct RecordHeader {
+        uint32_t type;
+        uint32_t storedSize;  // bytes that follow
+        uint32_t rawSize;     // LZ4 compressed when different from storedSize
+    };
+
+    // Followed by width * height * 4 bytes of RGBA8; a texture the capture
+    // never saw created is recorded with no pixels and size 0
+    struct TextureHeader {
+        uint32_t id;
+        int32_t width;
+        int32_t height;
+    };
+
+    struct FrameHeader {
+        double time;          // seconds since the capture started
+        float displayPos[2];
+        float displaySize[2];
+        float clearColor[4];
+        uint32_t listCount;
+    };
+
+    // Followed by the vertices, the indices and the commands
+    struct ListHeader {
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t commandCount;
+    };
+
+    enum class Callback : uint32_t { None, ResetRenderState, PremultipliedBlend, Other };
+
+    struct Command {
+        float clip[4];
+        uint32_t texture;  // capture id, 0 for none
+        uint32_t vertexOffset;
+        uint32_t indexOffset;
+        uint32_t elementCount;
+        uint32_t callback;  // Callback
+    };
+
+    class Writer {
+        FILE* file{ nullptr };
+        uint64_t bytes{ 0 };
+        uint64_t rawBytes{ 0 };
+
+    public:
+        Writer() {}
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+        ~Writer() { Close(); }
+
+        bool Open(const std::string& path, uint32_t vertexSize, uint32_t indexSize) {
+            Close();
+            file = fopen(path.c_str(), "wb");
+            if (!file) return false;
+            FileHeader header;
+            memcpy(header.magic, Magic, sizeof(Magic));
+            header.version = Version;
+            header.vertexSize = vertexSize;
+            header.indexSize = indexSize;
+            bytes = rawBytes = sizeof(header);
+            return fwrite(&header, sizeof(header), 1, file) == 1;
+        }
+
+        void Close() {
+            if (file) fclose(file);
+            file = nullptr;
+        }
+
+        bool IsOpen() const { return file != nullptr; }
+
+        bool Write(RecordType type, const void* payload, size_t size) {
+            if (!file) return false;
+            std::vector<unsigned char> compressed;
+            if (size > 64) compressed = Lz4::Compress((const unsigned char*)payload, size);
+            const bool useCompressed = !compressed.empty() && compressed.size() < size;
+
+            RecordHeader header{ (uint32_t)type, (uint32_t)(useCompressed ? compressed.size() : size), (uint32_t)size };
+            bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+            if (header.storedSize) ok = ok && fwrite(useCompressed ? compressed.data() : payload, header.storedSize, 1, file) == 1;
+            bytes += sizeof(header) + header.storedSize;
+            rawBytes += sizeof(header) + size;
+            return ok;
+        }
+
+        uint64_t Bytes() const { return bytes; }
+        uint64_t RawBytes() const { return rawBytes; }
+    };
+
+    struct Texture {
+        int width{ 0 };
+        int height{ 0 };
+        std::vector<uint8_t> rgba;
+    };
+
+    struct Frame {
+        struct List {
+            ListHeader header{};
+            std::vector<uint8_t> vertices;
+            std::vector<uint8_t> indices;
+            std::vector<Command> commands;
+        };
+
+        FrameHeader header{};
+        std::vector<List> lists;
+    };
+
+    struct Capture {
+        uint32_t vertexSize{ 0 };
+        uint32_t indexSize{ 0 };
+        std::unordered_map<uint32_t, Texture> textures;  // every texture ever created; releases are not replayed
+        std::vector<Frame> frames;                       // distinct frames
+        std::vector<uint32_t> sequence;                  // each recorded frame as an index into frames
+        uint64_t fileBytes{ 0 };
+    };
+
+    // Whether every vertex a draw command's indices reach is inside its list
+    template<typename Index>
+    inline bool IndicesInRange(const std::vector<uint8_t>& indices, const Command& command, uint32_t vertexCount) {
+        const Index* index = (const Index*)indices.data() + command.indexOffset;
+        for (uint32_t i = 0; i < command.elementCount; i++) {
+            if ((uint64_t)command.vertexOffset + index[i] >= vertexCount) return false;
+        }
+        return true;
+    }
+
+    // Also checks each draw command's index range and index values, so
+    // replaying a corrupt capture fails here instead of reading out of bounds
+    inline bool ParseFrame(const uint8_t* p, size_t size, const Capture& capture, Frame& frame) {
+        const uint8_t* end = p + size;
+        auto read = [&](void* out, size_t n) {
+            if ((size_t)(end - p) < n) return false;
+            memcpy(out, p, n);
+            p += n;
+            return true;
+        };
+        if (!read(&frame.header, sizeof(frame.header))) return false;
+        frame.lists.resize(frame.header.listCount);
+        for (Frame::List& list : frame.lists) {
+            if (!read(&list.header, sizeof(list.header))) return false;
+            const size_t vertexBytes = (size_t)list.header.vertexCount * capture.vertexSize;
+            const size_t indexBytes = (size_t)list.header.indexCount * capture.indexSize;
+            const size_t commandBytes = (size_t)list.header.commandCount * sizeof(Command);
+            if ((size_t)(end - p) < vertexBytes + indexBytes + commandBytes) return false;
+            list.vertices.assign(p, p + vertexBytes);
+            p += vertexBytes;
+            list.indices.assign(p, p + indexBytes);
+            p += indexBytes;
+            list.commands.resize(list.header.commandCount);
+            read(list.commands.data(), commandBytes);
+
+            for (const Command& command : list.commands) {
+                if (command.callback != (uint32_t)Callback::None || command.elementCount == 0) continue;
+                if ((uint64_t)command.indexOffset + command.elementCount > list.header.indexCount) return false;
+                if (command.vertexOffset >= list.header.vertexCount) return false;
+                const bool inRange = capture.indexSize == 4 ? IndicesInRange<uint32_t>(list.indices, command, list.header.vertexCount)
+                    : IndicesInRange<uint16_t>(list.indices, command, list.header.vertexCount);
+                if (!inRange) return false;
+            }
+        }
+        return p == end;
+    }
+
+    // Reads a whole capture into memory; on failure failureReason says why
+    inline bool Load(const std::string& path, Capture& out, const char*& failureReason) {
+        out = Capture{};
+        std::vector<unsigned char> file;
+        if (!ReadFileBytes(path, file)) {
+            failureReason = "can't read the file";
+            return false;
+        }
+        out.fileBytes = file.size();
+
+        FileHeader header;
+        if (file.size() < sizeof(header)) {
+            failureReason = "not a capture";
+            return false;
+        }
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+            failureReason = "not a capture, or a different version";
+            return false;
+        }
+        if (header.indexSize != 2 && header.indexSize != 4) {
+            failureReason = "indices are neither 16 nor 32 bits";
+            return false;
+        }
+        out.vertexSize = header.vertexSize;
+        out.indexSize = header.indexSize;
+
+        std::vector<uint8_t> payload;
+        size_t offset = sizeof(header);
+        while (offset < file.size()) {
+            RecordHeader record;
+            if (file.size() - offset < sizeof(record)) break;
+            memcpy(&record, file.data() + offset, sizeof(record));
+            offset += sizeof(record);
+            if (file.size() - offset < record.storedSize) break;
+
+            payload.resize(record.rawSize);
+            const unsigned char* stored = file.data() + offset;
+            offset += record.storedSize;
+            if (record.storedSize != record.rawSize) {
+                if (!Lz4::Decompress(stored, record.storedSize, payload.data(), payload.size())) {
+                    failureReason = "corrupt compressed record";
+                    return false;
+                }
+            }
+            else if (record.rawSize) {
+                memcpy(payload.data(), stored, record.rawSize);
+            }
+
+            switch ((RecordType)record.type) {
+            case RecordType::Texture: {
+                TextureHeader texture;
+                if (payload.size() < sizeof(texture)) {
+                    failureReason = "truncated texture record";
+                    return false;
+                }
+                memcpy(&texture, payload.data(), sizeof(texture));
+                Texture& t = out.textures[texture.id];
+                t.width = texture.width;
+                t.height = texture.height;
+                t.rgba.assign(payload.begin() + sizeof(texture), payload.end());
+                if (t.rgba.size() != (size_t)std::max(0, t.width) * std::max(0, t.height) * 4) {
+                    failureReason = "texture size does not match its pixels";
+                    return false;
+                }
+                break;
+            }
+            case RecordType::Frame:
+                out.frames.emplace_back();
+                if (!ParseFrame(payload.data(), payload.size(), out, out.frames.back())) {
+                    failureReason = "corrupt frame record";
+                    return false;
+                }
+                out.sequence.push_back((uint32_t)out.frames.size() - 1);
+                break;
+            case RecordType::Repeat:
+                if (!out.frames.empty()) out.sequence.push_back((uint32_t)out.frames.size() - 1);
+                break;
+            default:
+                break;
+            }
+        }
+        // a capture cut short by a crash still replays up to its last whole record
+        return true;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "imgui.h"
+#include "byte_utils.h"
+
+// Tells a renderer when a frame would draw the same pixels as the last one
+//
+// Hashes what the renderer consumes from ImDrawData: the display rect, each
+// list's vertex and index bytes, and every command's clip rect, texture,
+// offsets and callback. The renderer mixes in whatever else reaches the
+// screen through the seed (the clear colour, a counter bumped whenever a
+// texture is created or released, since a new texture can reuse a freed
+// one's address) and calls Invalidate() when the back buffer's contents are
+// lost. A match means the previous frame can stay on screen as it is.
+class DrawFingerprint {
+public:
+    struct Stats {
+        uint64_t frames{ 0 };
+        uint64_t skipped{ 0 };
+        double hashMs{ 0.0 };      // all frames
+        double lastHashMs{ 0.0 };
+        bool lastSkipped{ false };
+    };
+
+private:
+    std::vector<uint64_t> commandWords;
+    uint64_t previous{ 0 };
+    bool valid{ false };
+    Stats stats;
+
+    static uint64_t FloatBits(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+public:
+    // Chained list by list: each buffer is hashed with the hash so far as
+    // the seed. The commands are gathered field by field first, so struct
+    // padding never reaches the hash.
+    uint64_t Hash(const ImDrawData* data, uint64_t seed = 0) {
+        if (!data) return seed;
+        const uint64_t display[] = {
+            FloatBits(data->DisplayPos.x), FloatBits(data->DisplayPos.y),
+            FloatBits(data->DisplaySize.x), FloatBits(data->DisplaySize.y),
+            FloatBits(data->FramebufferScale.x), FloatBits(data->FramebufferScale.y),
+            (uint64_t)data->CmdListsCount
+        };
+        uint64_t h = HashBytes(display, sizeof(display), seed);
+
+        for (int i = 0; i < data->CmdListsCount; i++) {
+            const ImDrawList* list = data->CmdLists[i];
+            h = HashBytes(list->VtxBuffer.Data, (size_t)list->VtxBuffer.Size * sizeof(ImDrawVert), h);
+            h = HashBytes(list->IdxBuffer.Data, (size_t)list->IdxBuffer.Size * sizeof(ImDrawIdx), h);
+
+            commandWords.clear();
+            for (const ImDrawCmd& cmd : list->CmdBuffer) {
+                commandWords.push_back(FloatBits(cmd.ClipRect.x) | FloatBits(cmd.ClipRect.y) << 32);
+                commandWords.push_back(FloatBits(cmd.ClipRect.z) | FloatBits(cmd.ClipRect.w) << 32);
+                commandWords.push_back((uint64_t)(uintptr_t)cmd.GetTexID());
+                commandWords.push_back((uint64_t)cmd.VtxOffset | (uint64_t)cmd.IdxOffset << 32);
+                commandWords.push_back(cmd.ElemCount);
+                commandWords.push_back((uint64_t)(uintptr_t)cmd.UserCallback);
+                commandWords.push_back((uint64_t)(uintptr_t)cmd.UserCallbackData);
+            }
+            h = HashBytes(commandWords.data(), commandWords.size() * sizeof(uint64_t), h);
+        }
+        return h;
+    }
+
+    // Fingerprints this frame; true if it matches the previous one and
+    // drawing can be skipped
+    bool Unchanged(const ImDrawData* data, uint64_t seed) {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t h = Hash(data, seed);
+        const bool same = valid && h == previous;
+        previous = h;
+        valid = true;
+
+        stats.lastHashMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        stats.hashMs += stats.lastHashMs;
+        stats.frames++;
+        stats.skipped += same;
+        stats.lastSkipped = same;
+        return same;
+    }
+
+    // The next frame draws whatever it hashes to
+    void Invalidate() { valid = false; }
+
+    const Stats& GetStats() const { return stats; }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Decides when the main loop draws a frame
+//
+// Drawing every vsync costs CPU and GPU time even while nothing on screen
+// changes. Instead, while a frame is drawn the app tells the scheduler what
+// will still change: RequestAnimationFrame() for anything moving, which
+// keeps frames coming every vsync, and RequestFrameAt() for a change at a
+// known time. Input draws a few frames on its own, since ImGui trickles
+// queued events over several frames and widgets react a frame after they
+// see them. When nothing is due the loop blocks for WaitTime(), forever if
+// only input can change the picture. The caller supplies the time, in
+// seconds, so the same logic runs on a virtual clock.
+class FrameScheduler {
+public:
+    static constexpr double Forever = std::numeric_limits<double>::infinity();
+
+    struct Stats {
+        uint64_t frames{ 0 };
+        uint64_t inputFrames{ 0 };      // drawn to settle input or a wake
+        uint64_t animationFrames{ 0 };  // drawn because something was moving
+        uint64_t timerFrames{ 0 };      // drawn for a RequestFrameAt()
+    };
+
+private:
+    int settleFrames;
+    int inputFramesLeft{ 0 };
+    bool animating{ false };
+    double timer{ Forever };
+    Stats stats;
+
+public:
+    explicit FrameScheduler(int settleFrames = 3) : settleFrames(std::max(1, settleFrames)) {}
+
+    // An event arrived, or work finished off the render thread, that the
+    // next frames have to show
+    void OnInput() { inputFramesLeft = settleFrames; }
+
+    // While drawing: the next frame must be drawn as well
+    void RequestAnimationFrame() { animating = true; }
+
+    // While drawing: draw again once the clock reaches time
+    void RequestFrameAt(double time) { timer = std::min(timer, time); }
+
+    // Seconds the loop may block before the next frame is due: 0 to draw
+    // now, Forever when only input can change the picture
+    double WaitTime(double now) const {
+        if (animating || inputFramesLeft > 0) return 0.0;
+        return timer == Forever ? Forever : std::max(0.0, timer - now);
+    }
+
+    bool FrameDue(double now) const { return WaitTime(now) <= 0.0; }
+
+    // Starts drawing a frame, due or not; the requests made while it is
+    // drawn decide when the next one is
+    void BeginFrame(double now) {
+        stats.frames++;
+        if (inputFramesLeft > 0) {
+            inputFramesLeft--;
+            stats.inputFrames++;
+        }
+        else if (animating) {
+            stats.animationFrames++;
+        }
+        else if (timer <= now) {
+            stats.timerFrames++;
+        }
+        if (timer <= now) timer = Forever;
+        animating = false;
+    }
+
+    bool Idle() const { return !animating && inputFramesLeft == 0 && timer == Forever; }
+    const Stats& GetStats() const { return stats; }
+};
@@ -0,0 +1,380 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "imgui.h"
+#include "draw_fingerprint.h"
+#include "input_script.h"
+#include "platform.h"
+#include "resize_policy.h"
+
+// The tools that run the UI are pinned to ImGui v1.91.3 (see README.md);
+// 1.91.4 made ImTextureID an integer, which the renderers here don't expect
+#if IMGUI_VERSION_NUM != 19130
+#error "headless.h needs ImGui v1.91.3"
+#endif
+
+// Runs ImGuiApp without a window or a GPU
+//
+// HeadlessPlatform is a window on an imaginary screen. Input is queued by
+// the caller and handed to ImGui at the next frame, and time is a virtual
+// clock that advances a fixed step per frame, so a run is repeatable and
+// goes as fast as the UI code allows. WaitEvents() skips the clock ahead
+// instead of sleeping. NullRenderer uploads and draws nothing; it counts
+// what each frame submitted and fingerprints it, to show which frames a
+// real renderer would skip, and runs resizes through a ResizePolicy to
+// count the buffer reallocations they would cost. ScriptPlayer drives
+// HeadlessPlatform from an InputScript.
+class HeadlessPlatform : public IPlatform {
+public:
+    struct Options {
+        std::vector<std::string> assetDirectories{ "." };  // searched in order
+        std::string systemFont;       // stands in for every OS font; default Inter-Medium.ttf from the assets
+        int screenWidth{ 1920 };
+        int screenHeight{ 1080 };
+        double frameStep{ 1.0 / 60.0 };
+        bool log{ false };            // Log() to stderr
+    };
+
+private:
+    struct Event {
+        enum class Type { MousePos, MouseButton, Key, Text };
+        Type type;
+        float x{ 0.0f }, y{ 0.0f };
+        int button{ 0 };
+        ImGuiKey key{ ImGuiKey_None };
+        bool down{ false };
+        std::string text;
+
+        explicit Event(Type type) : type(type) {}
+    };
+
+    Options options;
+    WindowRect window;
+    ScreenPoint cursor;
+    std::deque<Event> events;
+    double time{ 0.0 };
+    double lastFrameTime{ 0.0 };
+    uint64_t frames{ 0 };
+    std::atomic<bool> woken{ false };
+    bool quit{ false };
+
+public:
+    HeadlessPlatform() {}
+    explicit HeadlessPlatform(Options options) : options(std::move(options)) {}
+
+    bool Initialize(const char*, int width, int height) override {
+        window = { (options.screenWidth - width) / 2, (options.screenHeight - height) / 2, width, height };
+        ImGui::GetIO().BackendPlatformName = "headless";
+        return true;
+    }
+
+    void Shutdown() override {}
+
+    bool PumpEvents(bool& received) override {
+        if (woken.exchange(false) || !events.empty()) received = true;
+        return !quit;
+    }
+
+    // Nothing else can queue input, so with none queued and no timeout this
+    // returns false at once rather than waiting forever
+    bool WaitEvents(double timeout) override {
+        if (woken || !events.empty()) return true;
+        if (!std::isinf(timeout)) time += std::max(0.0, timeout);
+        return false;
+    }
+
+    void Wake() override { woken = true; }
+    double Time() const override { return time; }
+
+    void NewFrame() override {
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2((float)window.width, (float)window.height);
+        time += options.frameStep;
+        io.DeltaTime = (float)(time - lastFrameTime);
+        lastFrameTime = time;
+        frames++;
+
+        // the window may have moved under a still cursor
+        io.AddMousePosEvent((float)(cursor.x - window.x), (float)(cursor.y - window.y));
+        for (const Event& e : events) {
+            switch (e.type) {
+            case Event::Type::MousePos: io.AddMousePosEvent(e.x, e.y); break;
+            case Event::Type::MouseButton: io.AddMouseButtonEvent(e.button, e.down); break;
+            case Event::Type::Key: io.AddKeyEvent(e.key, e.down); break;
+            case Event::Type::Text: io.AddInputCharactersUTF8(e.text.c_str()); break;
+            }
+        }
+        events.clear();
+    }
+
+    void RequestQuit() override { quit = true; }
+
+    WindowRect GetWindowRect() const override { return window; }
+    void SetWindowRect(const WindowRect& rect) override { window = rect; }
+
+    void MoveWindow(int x, int y) override {
+        window.x = x;
+        window.y = y;
+    }
+
+    ScreenPoint GetCursorPos() const override { return cursor; }
+
+    std::string AssetPath(const char* name) const override {
+        for (const std::string& dir : options.assetDirectories) {
+            std::error_code ec;
+            const std::filesystem::path path = std::filesystem::path(dir) / name;
+            if (std::filesystem::exists(path, ec)) return path.string();
+        }
+        return (std::filesystem::path(options.assetDirectories.empty() ? "." : options.assetDirectories[0]) / name).string();
+    }
+
+    std::string SystemFontPath(const char*) const override {
+        return options.systemFont.empty() ? AssetPath("Inter-Medium.ttf") : options.systemFont;
+    }
+
+    void Log(const char* message) override {
+        if (options.log) fputs(message, stderr);
+    }
+
+    void* NativeWindow() const override { return nullptr; }
+
+    // Input, in the window's client coordinates at the time of the call;
+    // ImGui sees it at the next NewFrame
+    void MoveMouse(float x, float y) {
+        cursor = { window.x + (int)x, window.y + (int)y };
+        Event e(Event::Type::MousePos);
+        e.x = x;
+        e.y = y;
+        events.push_back(e);
+    }
+
+    void MouseButton(int button, bool down) {
+        Event e(Event::Type::MouseButton);
+        e.button = button;
+        e.down = down;
+        events.push_back(e);
+    }
+
+    // ImGui trickles input, so the press and release land on separate frames
+    void Click(float x, float y, int button = 0) {
+        MoveMouse(x, y);
+        MouseButton(button, true);
+        MouseButton(button, false);
+    }
+
+    void Key(ImGuiKey key, bool down) {
+        Event e(Event::Type::Key);
+        e.key = key;
+        e.down = down;
+        events.push_back(e);
+    }
+
+    void Type(const char* text) {
+        Event e(Event::Type::Text);
+        e.text = text;
+        events.push_back(e);
+    }
+
+    uint64_t FrameCount() const { return frames; }
+    const Options& GetOptions() const { return options; }
+};
+
+class NullRenderer : public IRenderer {
+public:
+    struct FrameStats {
+        int drawLists{ 0 };
+        int commands{ 0 };
+        int vertices{ 0 };
+        int indices{ 0 };
+    };
+
+private:
+    struct Texture {
+        int width;
+        int height;
+        uint64_t bytes;
+    };
+
+    Texture fontTexture{};
+    FrameStats lastFrame;
+    DrawFingerprint fingerprint;
+    ResizePolicy resizePolicy;
+    uint64_t textureEpoch{ 0 };
+    size_t liveTextures{ 0 };
+    uint64_t liveBytes{ 0 };
+    bool supportsBC7{ true };
+
+    // Marks where premultiplied blending starts, as the D3D11 renderer's
+    // callback does; there is no state to switch here
+    static void SetPremultipliedBlend(const ImDrawList*, const ImDrawCmd*) {}
+
+public:
+    explicit NullRenderer(bool supportsBC7 = true, ResizePolicy::Options resize = {}) : resizePolicy(resize), supportsBC7(supportsBC7) {}
+
+    bool Initialize(IPlatform& platform) override {
+        const WindowRect rect = platform.GetWindowRect();
+        resizePolicy.Resize(rect.width, rect.height);
+        ImGuiIO& io = ImGui::GetIO();
+        io.BackendRendererName = "null";
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        return true;
+    }
+
+    void Shutdown() override {}
+
+    // Builds the font atlas the first time, as a GPU backend would
+    void NewFrame() override {
+        ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+        if (fonts->IsBuilt()) return;
+        unsigned char* pixels = nullptr;
+        fonts->GetTexDataAsRGBA32(&pixels, &fontTexture.width, &fontTexture.height);
+        fontTexture.bytes = (uint64_t)fontTexture.width * fontTexture.height * 4;
+        fonts->SetTexID((ImTextureID)&fontTexture);
+        textureEpoch++;
+    }
+
+    void Render(const ImVec4& clearColor) override {
+        const ImDrawData* data = ImGui::GetDrawData();
+        lastFrame = {};
+        fingerprint.Unchanged(data, HashBytes(&clearColor, sizeof(clearColor), textureEpoch));
+        if (!data) return;
+        lastFrame.drawLists = data->CmdListsCount;
+        for (int i = 0; i < data->CmdListsCount; i++) {
+            const ImDrawList* list = data->CmdLists[i];
+            lastFrame.commands += list->CmdBuffer.Size;
+            lastFrame.vertices += list->VtxBuffer.Size;
+            lastFrame.indices += list->IdxBuffer.Size;
+        }
+    }
+
+    void Resize(int width, int height) override {
+        resizePolicy.Resize(width, height);
+        fingerprint.Invalidate();
+    }
+
+    bool SupportsBC7() const override { return supportsBC7; }
+
+    void* CreateTexture(const TextureLoader::Prepared& prepared) override {
+        if (!prepared.Ok()) return nullptr;
+        Texture* texture = new Texture{ (int)prepared.layout.width, (int)prepared.layout.height, TextureContainer::TotalSize(prepared.layout) };
+        liveTextures++;
+        liveBytes += texture->bytes;
+        textureEpoch++;
+        return texture;
+    }
+
+    void ReleaseTexture(void* texture) override {
+        const Texture* t = (const Texture*)texture;
+        liveTextures--;
+        liveBytes -= t->bytes;
+        textureEpoch++;
+        delete t;
+    }
+
+    void AddImagePremultiplied(ImDrawList* drawList, void* texture, const ImVec2& min, const ImVec2& max,
+        const ImVec2& uvMin, const ImVec2& uvMax, float alpha) override {
+        const int a = (int)(255 * alpha);
+        drawList->AddCallback(SetPremultipliedBlend, this);
+        drawList->AddImage(texture, min, max, uvMin, uvMax, IM_COL32(a, a, a, a));
+        drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+    }
+
+    const FrameStats& LastFrame() const { return lastFrame; }
+    const DrawFingerprint::Stats& FingerprintStats() const { return fingerprint.GetStats(); }
+    const ResizePolicy::Stats& ResizeStats() const { return resizePolicy.GetStats(); }
+    size_t LiveTextures() const { return liveTextures; }
+    uint64_t LiveTextureBytes() const { return liveBytes; }
+};
+
+// Queues a script's actions on a HeadlessPlatform as its clock reaches them
+class ScriptPlayer {
+    HeadlessPlatform& platform;
+    const InputScript::Script& script;
+    std::vector<ImGuiKey> keys;  // per action
+    size_t next{ 0 };
+    double startTime{ 0.0 };
+    int phase{ -1 };
+    std::vector<const InputScript::Action*> expectations;
+
+public:
+    ScriptPlayer(HeadlessPlatform& platform, const InputScript::Script& script) : platform(platform), script(script) {}
+
+    // ImGui's own key names ("Enter", "Tab", "A", "LeftCtrl"...)
+    static ImGuiKey KeyFromName(const std::string& name) {
+        for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END; key++) {
+            const char* keyName = ImGui::GetKeyName((ImGuiKey)key);
+            if (keyName && name == keyName) return (ImGuiKey)key;
+        }
+        return ImGuiKey_None;
+    }
+
+    // Script time starts now. Key names are resolved here, which needs the
+    // ImGui context, so this comes after the app is initialized
+    bool Start(std::string& failureReason) {
+        keys.assign(script.actions.size(), ImGuiKey_None);
+        for (size_t i = 0; i < script.actions.size(); i++) {
+            const InputScript::Action& action = script.actions[i];
+            if (action.type != InputScript::Type::Key && action.type != InputScript::Type::KeyDown && action.type != InputScript::Type::KeyUp) continue;
+            keys[i] = KeyFromName(action.text);
+            if (keys[i] == ImGuiKey_None) {
+                failureReason = "line " + std::to_string(action.line) + ": no key named " + action.text;
+                return false;
+            }
+        }
+        next = 0;
+        phase = -1;
+        expectations.clear();
+        startTime = platform.Time();
+        return true;
+    }
+
+    // Queues every action due by the platform's current time; the frame
+    // drawn next sees them
+    void Feed() {
+        const double now = platform.Time() - startTime + 1e-9;
+        expectations.clear();
+        for (; next < script.actions.size() && script.actions[next].time <= now; next++) {
+            const InputScript::Action& action = script.actions[next];
+            switch (action.type) {
+            case InputScript::Type::Phase:
+                phase = (int)(std::find(script.phases.begin(), script.phases.end(), action.text) - script.phases.begin());
+                break;
+            case InputScript::Type::Move: platform.MoveMouse(action.x, action.y); break;
+            case InputScript::Type::Click: platform.Click(action.x, action.y, action.button); break;
+            case InputScript::Type::Down:
+            case InputScript::Type::Up:
+                platform.MoveMouse(action.x, action.y);
+                platform.MouseButton(action.button, action.type == InputScript::Type::Down);
+                break;
+            case InputScript::Type::Key:
+                platform.Key(keys[next], true);
+                platform.Key(keys[next], false);
+                break;
+            case InputScript::Type::KeyDown: platform.Key(keys[next], true); break;
+            case InputScript::Type::KeyUp: platform.Key(keys[next], false); break;
+            case InputScript::Type::Text: platform.Type(action.text.c_str()); break;
+            case InputScript::Type::Expect: expectations.push_back(&action); break;
+            case InputScript::Type::End: break;
+            }
+        }
+    }
+
+    bool Done() const { return next >= script.actions.size() && platform.Time() - startTime + 1e-9 >= script.end; }
+
+    // Index into the script's phases, -1 before the first
+    int Phase() const { return phase; }
+
+    // The expect actions the last Feed() reached; the caller checks them
+    // against the frame it draws next
+    const std::vector<const InputScript::Action*>& Expectations() const { return expectations; }
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "image_resample.h"
+#include "thread_pool.h"
+
+// Gaussian blur for pre-blurred ("frosted") copies of an image
+//
+// Runs on the premultiplied linear images ImageResample works with, so
+// transparent texels don't bleed their colour and the blur is in light, not
+// in sRGB code values. It is separable: each row is filtered against a
+// clamped copy of itself, then whole rows are summed down the columns.
+namespace ImageBlur {
+    // Normalised weights for taps 0..radius, radius = ceil(3 sigma)
+    inline std::vector<float> GaussianKernel(float sigma) {
+        const int radius = std::max(1, (int)ceilf(sigma * 3.0f));
+        std::vector<float> weights(radius + 1);
+        double total = 0.0;
+        for (int k = 0; k <= radius; k++) {
+            weights[k] = (float)exp(-0.5 * k * k / ((double)sigma * sigma));
+            total += k ? 2.0 * weights[k] : weights[k];
+        }
+        for (float& w : weights) w = (float)(w / total);
+        return weights;
+    }
+
+    // Blurs in place by sigma pixels; edges repeat the border texels
+    inline void Gaussian(ImageResample::LinearImage& image, float sigma, ThreadPool* pool = nullptr) {
+        if (sigma <= 0.0f || image.width == 0 || image.height == 0) return;
+        const std::vector<float> kernel = GaussianKernel(sigma);
+        const int radius = (int)kernel.size() - 1;
+        const int width = image.width, height = image.height;
+
+        ImageResample::LinearImage wide;
+        wide.width = width;
+        wide.height = height;
+        wide.px.resize(image.px.size());
+        ImageResample::ParallelRows(height, pool, [&](int first, int last) {
+            std::vector<float> padded((size_t)(width + radius * 2) * 4);
+            for (int y = first; y < last; y++) {
+                const float* in = image.Row(y);
+                for (int x = -radius; x < width + radius; x++) {
+                    const float* s = in + std::clamp(x, 0, width - 1) * 4;
+                    std::copy(s, s + 4, &padded[(size_t)(x + radius) * 4]);
+                }
+                float* out = wide.Row(y);
+                for (int x = 0; x < width; x++) {
+                    const float* center = &padded[(size_t)(x + radius) * 4];
+#ifdef IMAGE_RESAMPLE_SSE2
+                    __m128 acc = _mm_mul_ps(_mm_loadu_ps(center), _mm_set1_ps(kernel[0]));
+                    for (int k = 1; k <= radius; k++) {
+                        const __m128 pair = _mm_add_ps(_mm_loadu_ps(center - k * 4), _mm_loadu_ps(center + k * 4));
+                        acc = _mm_add_ps(acc, _mm_mul_ps(pair, _mm_set1_ps(kernel[k])));
+                    }
+                    _mm_storeu_ps(out + x * 4, acc);
+#else
+                    for (int c = 0; c < 4; c++) {
+                        float acc = center[c] * kernel[0];
+                        for (int k = 1; k <= radius; k++) acc += (center[c - k * 4] + center[c + k * 4]) * kernel[k];
+                        out[x * 4 + c] = acc;
+                    }
+#endif
+                }
+            }
+        });
+
+        ImageResample::ParallelRows(height, pool, [&](int first, int last) {
+            for (int y = first; y < last; y++) {
+                float* out = image.Row(y);
+                std::fill(out, out + (size_t)width * 4, 0.0f);
+                for (int k = -radius; k <= radius; k++) {
+                    ImageResample::Accumulate(out, wide.Row(std::clamp(y + k, 0, height - 1)), kernel[abs(k)], width);
+                }
+            }
+        });
+    }
+
+    // Blurs an RGBA8 image by sigma pixels of its own size. Wide blurs run
+    // on a box-reduced copy, halved while at least MinSigma pixels of blur
+    // remain, and come back that small: a blurred image holds nothing a
+    // bilinear upscale loses, and the cost no longer grows with sigma.
+    constexpr float MinSigma = 3.0f;
+
+    inline ImageResample::Level Blur(const uint8_t* rgba, int width, int height, float sigma, bool srgb = true, ThreadPool* pool = nullptr,
+        ImageResample::Alpha alpha = ImageResample::Alpha::Straight) {
+        const bool halve = sigma >= MinSigma * 2 && width >= 2 && height >= 2;
+        ImageResample::LinearImage current = halve ? ImageResample::ToLinearHalved(rgba, width, height, srgb, pool, alpha)
+                                                   : ImageResample::ToLinear(rgba, width, height, srgb, pool, alpha);
+        if (halve) sigma *= 0.5f;
+        while (sigma >= MinSigma * 2 && current.width >= 2 && current.height >= 2) {
+            current = ImageResample::Halve(current, pool);
+            sigma *= 0.5f;
+        }
+        Gaussian(current, sigma, pool);
+
+        ImageResample::Level level;
+        level.width = current.width;
+        level.height = current.height;
+        level.rgba.resize((size_t)current.width * current.height * 4);
+        ImageResample::FromLinear(current, srgb, level.rgba.data(), pool, alpha);
+        return level;
+    }
+}
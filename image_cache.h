@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "byte_utils.h"
+#include "image_decode.h"
+#include "mapped_file.h"
+
+// Pixels that came either from the cache (mapped or decompressed) or from a
+// fresh decode; Pixels() is valid for the lifetime of the object
+struct LoadedImage {
+    int width{ 0 };
+    int height{ 0 };
+    int channels{ 0 };
+    bool premultiplied{ false };  // colour already multiplied by alpha (RGBA only)
+    bool fromCache{ false };
+    double loadMs{ 0.0 };
+    const char* failureReason{ nullptr };
+
+    MappedFile mapping;
+    std::vector<unsigned char> owned;
+    StbiPixels decoded;
+    const unsigned char* pixels{ nullptr };
+
+    bool Ok() const { return pixels != nullptr; }
+    const unsigned char* Pixels() const { return pixels; }
+};
+
+// On-disk cache of decoded pixels
+//
+// Entries are keyed by a hash of the encoded source bytes plus the decode
+// parameters, so an edited source simply misses and its old entry ages out.
+// Each entry carries the source size and a hash of its payload; anything that
+// doesn't validate is treated as stale and deleted. Hits bump the file's
+// write time, and Trim() deletes least-recently-used entries until the
+// directory fits the byte budget.
+class ImageCache {
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t flags;
+        uint64_t key;
+        uint64_t sourceSize;
+        int32_t width;
+        int32_t height;
+        int32_t channels;
+        uint32_t payloadSize;
+        uint64_t payloadHash;
+    };
+
+    static constexpr uint32_t Magic = 0x43474d49;  // "IMGC"
+    static constexpr uint16_t Version = 1;
+    static constexpr uint16_t FlagLz4 = 1;
+
+    std::filesystem::path directory;
+    uint64_t maxBytes{ 0 };
+    bool compress{ false };
+    std::mutex trimMutex;
+
+    std::filesystem::path EntryPath(uint64_t key) const {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.img", (unsigned long long)key);
+        return directory / name;
+    }
+
+    static bool Validate(const Header& h, uint64_t key, size_t sourceSize, size_t fileSize) {
+        if (h.magic != Magic || h.version != Version || h.key != key || h.sourceSize != sourceSize) return false;
+        if (h.width <= 0 || h.height <= 0 || h.channels <= 0 || h.channels > 4) return false;
+        return fileSize == sizeof(Header) + h.payloadSize;
+    }
+
+public:
+    bool Open(const std::string& dir, uint64_t budgetBytes, bool useCompression) {
+        directory = dir;
+        maxBytes = budgetBytes;
+        compress = useCompression;
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        return !ec;
+    }
+
+    bool IsOpen() const { return !directory.empty(); }
+
+    static uint64_t Key(const unsigned char* source, size_t size, int desiredChannels, bool premultiplied = false) {
+        const uint64_t params = ((uint64_t)Version << 32) | (premultiplied ? 1u << 16 : 0u) | (uint32_t)desiredChannels;
+        return HashBytes(source, size, params);
+    }
+
+    bool Lookup(uint64_t key, size_t sourceSize, LoadedImage& out) {
+        if (!IsOpen()) return false;
+        const std::filesystem::path path = EntryPath(key);
+        MappedFile file;
+        if (!file.Open(path.string())) return false;
+
+        Header h;
+        bool valid = file.Size() >= sizeof(Header);
+        if (valid) {
+            memcpy(&h, file.Data(), sizeof(h));
+            valid = Validate(h, key, sourceSize, file.Size());
+        }
+        const unsigned char* payload = file.Data() + sizeof(Header);
+        if (valid) valid = HashBytes(payload, h.payloadSize) == h.payloadHash;
+
+        const size_t pixelBytes = valid ? (size_t)h.width * h.height * h.channels : 0;
+        if (valid && (h.flags & FlagLz4)) {
+            out.owned.resize(pixelBytes);
+            valid = Lz4::Decompress(payload, h.payloadSize, out.owned.data(), pixelBytes);
+            out.pixels = out.owned.data();
+        }
+        else if (valid) {
+            valid = h.payloadSize == pixelBytes;
+        }
+
+        if (!valid) {
+            file.Close();
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            out.owned.clear();
+            out.pixels = nullptr;
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+        out.width = h.width;
+        out.height = h.height;
+        out.channels = h.channels;
+        out.fromCache = true;
+        if (!(h.flags & FlagLz4)) {
+            out.mapping = std::move(file);
+            out.pixels = out.mapping.Data() + sizeof(Header);
+        }
+        return true;
+    }
+
+    bool Store(uint64_t key, size_t sourceSize, const unsigned char* pixels, int width, int height, int channels) {
+        if (!IsOpen()) return false;
+        const size_t pixelBytes = (size_t)width * height * channels;
+        std::vector<unsigned char> compressed;
+        const unsigned char* payload = pixels;
+        size_t payloadSize = pixelBytes;
+        uint16_t flags = 0;
+        if (compress) {
+            compressed = Lz4::Compress(pixels, pixelBytes);
+            if (compressed.size() < pixelBytes) {
+                payload = compressed.data();
+                payloadSize = compressed.size();
+                flags = FlagLz4;
+            }
+        }
+
+        Header h{};
+        h.magic = Magic;
+        h.version = Version;
+        h.flags = flags;
+        h.key = key;
+        h.sourceSize = sourceSize;
+        h.width = width;
+        h.height = height;
+        h.channels = channels;
+        h.payloadSize = (uint32_t)payloadSize;
+        h.payloadHash = HashBytes(payload, payloadSize);
+
+        // write beside the final name and rename, so readers never see a partial entry
+        const std::filesystem::path path = EntryPath(key);
+        std::filesystem::path temp = path;
+        temp += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file) return false;
+            file.write((const char*)&h, sizeof(h));
+            file.write((const char*)payload, (std::streamsize)payloadSize);
+            if (!file) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp, path, ec);
+        if (ec) std::filesystem::remove(temp, ec);
+        return !ec;
+    }
+
+    // Deletes least-recently-used entries until the cache fits its budget
+    void Trim() {
+        if (!IsOpen()) return;
+        std::lock_guard<std::mutex> lock(trimMutex);
+
+        struct Entry {
+            std::filesystem::file_time_type time;
+            uint64_t size;
+            std::filesystem::path path;
+        };
+        std::vector<Entry> entries;
+        uint64_t total = 0;
+        std::error_code ec;
+        for (const auto& item : std::filesystem::directory_iterator(directory, ec)) {
+            if (!item.is_regular_file(ec) || item.path().extension() != ".img") continue;
+            Entry e{ item.last_write_time(ec), item.file_size(ec), item.path() };
+            total += e.size;
+            entries.push_back(std::move(e));
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+        for (const Entry& e : entries) {
+            if (total <= maxBytes) break;
+            if (std::filesystem::remove(e.path, ec)) total -= e.size;
+        }
+    }
+};
+
+// Loads one file through the cache (nullptr decodes directly): a hit is
+// mapped straight from disk, a miss is decoded and written back, and the
+// cache is then trimmed to its budget. With premultiply set, RGBA results
+// are premultiplied right after decoding and cached that way, so hits need
+// no extra pass.
+inline LoadedImage LoadCached(const std::string& path, int desiredChannels, ImageCache* cache, bool premultiply = false) {
+    premultiply = premultiply && desiredChannels == 4;
+    LoadedImage image;
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<unsigned char> source;
+    if (!ReadFileBytes(path, source)) {
+        image.failureReason = "can't fopen";
+        return image;
+    }
+
+    const uint64_t key = ImageCache::Key(source.data(), source.size(), desiredChannels, premultiply);
+    if (!cache || !cache->Lookup(key, source.size(), image)) {
+        DecodedImage decoded = ImageDecode::DecodeOne([&](int* w, int* h, int* c) {
+            return stbi_load_from_memory(source.data(), (int)source.size(), w, h, c, desiredChannels);
+        }, desiredChannels);
+
+        if (decoded.Ok()) {
+            if (premultiply) ImageDecode::Premultiply(decoded.pixels.get(), (size_t)decoded.width * decoded.height);
+            if (cache && cache->Store(key, source.size(), decoded.pixels.get(), decoded.width, decoded.height, decoded.channels)) cache->Trim();
+            image.width = decoded.width;
+            image.height = decoded.height;
+            image.channels = decoded.channels;
+            image.decoded = std::move(decoded.pixels);
+            image.pixels = image.decoded.get();
+        }
+        image.failureReason = decoded.failureReason;
+    }
+    image.premultiplied = image.Ok() && premultiply;
+    image.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return image;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_DECODE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "stb_image.h"
+#include "thread_pool.h"
+
+struct StbiDeleter {
+    void operator()(unsigned char* ptr) const {
+        if (ptr) stbi_image_free(ptr);
+    }
+};
+
+using StbiPixels = std::unique_ptr<unsigned char, StbiDeleter>;
+
+// Encoded image held in memory
+struct ImageSource {
+    const unsigned char* data{ nullptr };
+    size_t size{ 0 };
+};
+
+struct DecodedImage {
+    StbiPixels pixels;
+    int width{ 0 };
+    int height{ 0 };
+    int channels{ 0 };          // channels in pixels (desiredChannels, or the file's)
+    double decodeMs{ 0.0 };
+    const char* failureReason{ nullptr };
+
+    bool Ok() const { return pixels != nullptr; }
+};
+
+namespace ImageDecode {
+    // round(v * a / 255) exactly, without a division
+    inline unsigned char MulDiv255(unsigned v, unsigned a) {
+        const unsigned t = v * a + 128;
+        return (unsigned char)((t + (t >> 8)) >> 8);
+    }
+
+    // Multiplies colour by alpha in place for RGBA8 pixels, rounding exactly
+    // like MulDiv255. Alpha itself is left unchanged.
+    inline void Premultiply(unsigned char* rgba, size_t pixelCount) {
+        size_t i = 0;
+#ifdef IMAGE_DECODE_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        const __m128i alphaScale = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+        const __m128i half = _mm_set1_epi16(128);
+        // two pixels per 16-bit half: multiply each channel by its pixel's alpha
+        // (alpha by 255), then t + (t >> 8) >> 8 divides by 255 with rounding
+        auto scale = [&](__m128i v) {
+            __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            a = _mm_or_si128(_mm_andnot_si128(alphaLanes, a), alphaScale);
+            const __m128i t = _mm_add_epi16(_mm_mullo_epi16(v, a), half);
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        };
+        for (; i + 4 <= pixelCount; i += 4) {
+            __m128i* p = (__m128i*)(rgba + i * 4);
+            const __m128i v = _mm_loadu_si128(p);
+            _mm_storeu_si128(p, _mm_packus_epi16(scale(_mm_unpacklo_epi8(v, zero)), scale(_mm_unpackhi_epi8(v, zero))));
+        }
+#endif
+        for (; i < pixelCount; i++) {
+            unsigned char* p = rgba + i * 4;
+            for (int c = 0; c < 3; c++) p[c] = MulDiv255(p[c], p[3]);
+        }
+    }
+
+    template<typename Load>
+    inline DecodedImage DecodeOne(Load&& load, int desiredChannels) {
+        DecodedImage image;
+        int fileChannels = 0;
+        const auto start = std::chrono::steady_clock::now();
+        image.pixels.reset(load(&image.width, &image.height, &fileChannels));
+        image.decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        image.channels = desiredChannels ? desiredChannels : fileChannels;
+        // stb keeps the failure reason per thread, so read it on the decoding thread
+        if (!image.pixels) image.failureReason = stbi_failure_reason();
+        return image;
+    }
+
+    template<typename Load>
+    inline std::vector<DecodedImage> DecodeBatch(size_t count, Load&& load, int desiredChannels, ThreadPool& pool) {
+        std::vector<DecodedImage> results(count);
+        for (size_t i = 0; i < count; i++) {
+            pool.Submit([&results, &load, desiredChannels, i] {
+                results[i] = DecodeOne([&](int* w, int* h, int* c) { return load(i, w, h, c); }, desiredChannels);
+            });
+        }
+        pool.Wait();
+        return results;
+    }
+}
+
+// Decodes every file concurrently; results come back in input order
+inline std::vector<DecodedImage> DecodeBatch(const std::vector<std::string>& paths, int desiredChannels, ThreadPool& pool) {
+    return ImageDecode::DecodeBatch(paths.size(), [&](size_t i, int* w, int* h, int* c) {
+        return stbi_load(paths[i].c_str(), w, h, c, desiredChannels);
+    }, desiredChannels, pool);
+}
+
+inline std::vector<DecodedImage> DecodeBatch(const std::vector<ImageSource>& buffers, int desiredChannels, ThreadPool& pool) {
+    return ImageDecode::DecodeBatch(buffers.size(), [&](size_t i, int* w, int* h, int* c) {
+        return stbi_load_from_memory(buffers[i].data, (int)buffers[i].size, w, h, c, desiredChannels);
+    }, desiredChannels, pool);
+}
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_RESAMPLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "thread_pool.h"
+
+// Gamma-correct image resampling and mip-chain generation
+//
+// 8-bit sRGB pixels are converted once to premultiplied linear float RGBA,
+// filtered separably (horizontal pass, then vertical) and converted back.
+// Each pixel is one 4-wide vector, so the filter loops are plain SSE
+// multiply-adds. Premultiplying keeps transparent texels from bleeding
+// their colour into visible ones.
+namespace ImageResample {
+    enum class Filter { Box, Kaiser, Lanczos };
+
+    // How colour is stored next to alpha in 8-bit images, both in and out.
+    // Premultiplied here means multiplied in the encoded (sRGB) values, which
+    // is what ImGui's blending into a UNORM target expects.
+    enum class Alpha { Straight, Premultiplied };
+
+    struct LinearImage {
+        int width{ 0 };
+        int height{ 0 };
+        std::vector<float> px;  // premultiplied linear RGBA
+
+        float* Row(int y) { return px.data() + (size_t)y * width * 4; }
+        const float* Row(int y) const { return px.data() + (size_t)y * width * 4; }
+    };
+
+    struct Level {
+        int width{ 0 };
+        int height{ 0 };
+        std::vector<uint8_t> rgba;
+    };
+
+    constexpr int EncodeTableBits = 14;
+
+    struct SrgbTables {
+        float decode[256];
+        uint8_t encode[1 << EncodeTableBits];
+
+        SrgbTables() {
+            for (int i = 0; i < 256; i++) {
+                const float c = i / 255.0f;
+                decode[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+            }
+            const int last = (1 << EncodeTableBits) - 1;
+            for (int i = 0; i <= last; i++) {
+                const float l = (float)i / last;
+                const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+                encode[i] = (uint8_t)lrintf(std::clamp(c, 0.0f, 1.0f) * 255.0f);
+            }
+        }
+    };
+
+    inline const SrgbTables& Tables() {
+        static const SrgbTables tables;
+        return tables;
+    }
+
+    // Splits [0, count) into a few ranges per worker; runs inline without a pool.
+    // Must not be called from inside a pool task.
+    template<typename Body>
+    inline void ParallelRows(int count, ThreadPool* pool, Body&& body) {
+        if (!pool || count < 16) {
+            body(0, count);
+            return;
+        }
+        const int tasks = std::min(count / 8, (int)pool->ThreadCount() * 4);
+        for (int t = 0; t < tasks; t++) {
+            const int first = count * t / tasks, last = count * (t + 1) / tasks;
+            pool->Submit([&body, first, last] { body(first, last); });
+        }
+        pool->Wait();
+    }
+
+    // Converts 8-bit RGBA (straight or premultiplied) to premultiplied linear
+    struct PixelDecoder {
+        float unorm[256];
+        float unpremultiply[256];
+        const float* decode;
+        bool premultiplied;
+
+        PixelDecoder(bool srgb, Alpha alpha) : decode(srgb ? Tables().decode : unorm), premultiplied(alpha == Alpha::Premultiplied) {
+            for (int i = 0; i < 256; i++) {
+                unorm[i] = i / 255.0f;
+                unpremultiply[i] = i ? 255.0f / i : 0.0f;
+            }
+        }
+
+        // premultiplied input is divided back out to index the transfer table
+        int Index(const uint8_t* s, int c) const {
+            return premultiplied ? std::min(255, (int)(s[c] * unpremultiply[s[3]] + 0.5f)) : s[c];
+        }
+
+#ifdef IMAGE_RESAMPLE_SSE2
+        __m128 Load(const uint8_t* s) const {
+            // lane 3 starts at 1, so the premultiply leaves alpha itself there
+            const __m128 color = _mm_set_ps(1.0f, decode[Index(s, 2)], decode[Index(s, 1)], decode[Index(s, 0)]);
+            return _mm_mul_ps(color, _mm_set1_ps(unorm[s[3]]));
+        }
+#else
+        void Load(const uint8_t* s, float* d) const {
+            const float a = unorm[s[3]];
+            for (int c = 0; c < 3; c++) d[c] = decode[Index(s, c)] * a;
+            d[3] = a;
+        }
+#endif
+    };
+
+    inline LinearImage ToLinear(const uint8_t* rgba, int width, int height, bool srgb, ThreadPool* pool = nullptr, Alpha alpha = Alpha::Straight) {
+        LinearImage image;
+        image.width = width;
+        image.height = height;
+        image.px.resize((size_t)width * height * 4);
+        const PixelDecoder decoder(srgb, alpha);
+
+        ParallelRows(height, pool, [&](int first, int last) {
+            for (size_t i = (size_t)first * width; i < (size_t)last * width; i++) {
+#ifdef IMAGE_RESAMPLE_SSE2
+                _mm_storeu_ps(image.px.data() + i * 4, decoder.Load(rgba + i * 4));
+#else
+                decoder.Load(rgba + i * 4, image.px.data() + i * 4);
+#endif
+            }
+        });
+        return image;
+    }
+
+    // ToLinear fused with an exact 2:1 box step, so a large source never
+    // exists as a full-resolution float image
+    inline LinearImage ToLinearHalved(const uint8_t* rgba, int width, int height, bool srgb, ThreadPool* pool = nullptr, Alpha alpha = Alpha::Straight) {
+        LinearImage image;
+        image.width = width / 2;
+        image.height = height / 2;
+        image.px.resize((size_t)image.width * image.height * 4);
+        const PixelDecoder decoder(srgb, alpha);
+
+        ParallelRows(image.height, pool, [&](int first, int last) {
+            for (int y = first; y < last; y++) {
+                const uint8_t* rows[2] = { rgba + (size_t)y * 2 * width * 4, rgba + ((size_t)y * 2 + 1) * width * 4 };
+                float* out = image.Row(y);
+                for (int x = 0; x < image.width; x++) {
+#ifdef IMAGE_RESAMPLE_SSE2
+                    __m128 sum = _mm_setzero_ps();
+                    for (const uint8_t* row : rows) {
+                        sum = _mm_add_ps(sum, _mm_add_ps(decoder.Load(row + x * 8), decoder.Load(row + x * 8 + 4)));
+                    }
+                    _mm_storeu_ps(out + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+                    float sum[4] = {}, px[4];
+                    for (const uint8_t* row : rows) {
+                        for (int k = 0; k < 2; k++) {
+                            decoder.Load(row + x * 8 + k * 4, px);
+                            for (int c = 0; c < 4; c++) sum[c] += px[c];
+                        }
+                    }
+                    for (int c = 0; c < 4; c++) out[x * 4 + c] = sum[c] * 0.25f;
+#endif
+                }
+            }
+        });
+        return image;
+    }
+
+    inline void FromLinear(const LinearImage& image, bool srgb, uint8_t* rgba, ThreadPool* pool = nullptr, Alpha alpha = Alpha::Straight) {
+        const SrgbTables& tables = Tables();
+        const float scale = (float)((1 << EncodeTableBits) - 1);
+        const bool premultiply = alpha == Alpha::Premultiplied;
+
+        ParallelRows(image.height, pool, [&](int first, int last) {
+            for (size_t i = (size_t)first * image.width; i < (size_t)last * image.width; i++) {
+                const float* s = image.px.data() + i * 4;
+                uint8_t* d = rgba + i * 4;
+                const float a = std::clamp(s[3], 0.0f, 1.0f);
+                const float unpremultiply = a > 0.0f ? 1.0f / a : 0.0f;
+                d[3] = (uint8_t)(a * 255.0f + 0.5f);
+                for (int c = 0; c < 3; c++) {
+                    const float v = std::clamp(s[c] * unpremultiply, 0.0f, 1.0f);
+                    const unsigned encoded = srgb ? tables.encode[(int)(v * scale + 0.5f)] : (unsigned)(v * 255.0f + 0.5f);
+                    if (premultiply) {
+                        // round(encoded * alpha / 255), as ImageDecode::Premultiply does
+                        const unsigned t = encoded * d[3] + 128;
+                        d[c] = (uint8_t)((t + (t >> 8)) >> 8);
+                    }
+                    else {
+                        d[c] = (uint8_t)encoded;
+                    }
+                }
+            }
+        });
+    }
+
+    // Filter taps for every output pixel along one axis
+    struct Contributions {
+        std::vector<int> first;
+        std::vector<int> count;
+        std::vector<float> weights;  // `stride` per output pixel
+        int stride{ 0 };
+    };
+
+    inline double BesselI0(double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; k++) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1e-12) break;
+        }
+        return sum;
+    }
+
+    inline Contributions BuildContributions(int srcSize, int dstSize, Filter filter) {
+        // Kaiser- and Lanczos-windowed sinc both span three lobes either side
+        constexpr double SincRadius = 3.0;
+        constexpr double KaiserAlpha = 4.0;
+        constexpr double Pi = 3.14159265358979323846;
+
+        const double scale = (double)srcSize / dstSize;
+        const double footprint = std::max(scale, 1.0);
+        const double radius = filter == Filter::Box ? 0.5 * footprint : SincRadius * footprint;
+
+        Contributions out;
+        out.stride = (int)ceil(radius * 2.0) + 2;
+        out.first.resize(dstSize);
+        out.count.resize(dstSize);
+        out.weights.assign((size_t)dstSize * out.stride, 0.0f);
+
+        const double kaiserNorm = 1.0 / BesselI0(KaiserAlpha);
+        for (int x = 0; x < dstSize; x++) {
+            const double center = (x + 0.5) * scale;
+            const int lo = std::max(0, (int)floor(center - radius));
+            const int hi = std::min(srcSize - 1, (int)ceil(center + radius) - 1);
+            std::vector<double> weights(out.stride);
+            double total = 0.0;
+            int n = 0;
+            for (int i = lo; i <= hi && n < out.stride; i++, n++) {
+                double w;
+                if (filter == Filter::Box) {
+                    // area of source pixel [i, i + 1) inside the footprint
+                    w = std::max(0.0, std::min(i + 1.0, center + radius) - std::max((double)i, center - radius));
+                }
+                else {
+                    const double t = (i + 0.5 - center) / footprint;
+                    const double r = t / SincRadius;
+                    const double sinc = fabs(t) < 1e-9 ? 1.0 : sin(Pi * t) / (Pi * t);
+                    if (r * r >= 1.0) w = 0.0;
+                    else if (filter == Filter::Kaiser) w = sinc * BesselI0(KaiserAlpha * sqrt(1.0 - r * r)) * kaiserNorm;
+                    else w = sinc * (fabs(r) < 1e-9 ? 1.0 : sin(Pi * r) / (Pi * r));
+                }
+                weights[n] = w;
+                total += w;
+            }
+            if (total == 0.0) {
+                // footprint fell between samples (extreme upscale): nearest pixel
+                n = 1;
+                weights[0] = total = 1.0;
+            }
+            out.first[x] = lo;
+            out.count[x] = n;
+            for (int k = 0; k < n; k++) out.weights[(size_t)x * out.stride + k] = (float)(weights[k] / total);
+        }
+        return out;
+    }
+
+    // acc[i] += src[i] * w over whole pixels
+    inline void Accumulate(float* acc, const float* src, float w, int pixels) {
+#ifdef IMAGE_RESAMPLE_SSE2
+        const __m128 weight = _mm_set1_ps(w);
+        for (int i = 0; i < pixels; i++) {
+            _mm_storeu_ps(acc + i * 4, _mm_add_ps(_mm_loadu_ps(acc + i * 4), _mm_mul_ps(_mm_loadu_ps(src + i * 4), weight)));
+        }
+#else
+        for (int i = 0; i < pixels * 4; i++) acc[i] += src[i] * w;
+#endif
+    }
+
+    // Exact 2:1 box reduction in one pass, the common mip step
+    inline LinearImage Halve(const LinearImage& src, ThreadPool* pool) {
+        LinearImage dst;
+        dst.width = src.width / 2;
+        dst.height = src.height / 2;
+        dst.px.resize((size_t)dst.width * dst.height * 4);
+        ParallelRows(dst.height, pool, [&](int first, int last) {
+            for (int y = first; y < last; y++) {
+                const float* a = src.Row(y * 2);
+                const float* b = src.Row(y * 2 + 1);
+                float* out = dst.Row(y);
+                for (int x = 0; x < dst.width; x++, a += 8, b += 8) {
+#ifdef IMAGE_RESAMPLE_SSE2
+                    const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(a + 4)), _mm_add_ps(_mm_loadu_ps(b), _mm_loadu_ps(b + 4)));
+                    _mm_storeu_ps(out + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+                    for (int c = 0; c < 4; c++) out[x * 4 + c] = (a[c] + a[4 + c] + b[c] + b[4 + c]) * 0.25f;
+#endif
+                }
+            }
+        });
+        return dst;
+    }
+
+    inline LinearImage Resample(const LinearImage& src, int dstWidth, int dstHeight, Filter filter, ThreadPool* pool = nullptr) {
+        if (filter == Filter::Box && src.width == dstWidth * 2 && src.height == dstHeight * 2) return Halve(src, pool);
+
+        const Contributions cx = BuildContributions(src.width, dstWidth, filter);
+        const Contributions cy = BuildContributions(src.height, dstHeight, filter);
+
+        // horizontal pass keeps every source row
+        LinearImage wide;
+        wide.width = dstWidth;
+        wide.height = src.height;
+        wide.px.assign((size_t)dstWidth * src.height * 4, 0.0f);
+        ParallelRows(src.height, pool, [&](int first, int last) {
+            for (int y = first; y < last; y++) {
+                const float* in = src.Row(y);
+                float* out = wide.Row(y);
+                for (int x = 0; x < dstWidth; x++) {
+                    const float* w = cx.weights.data() + (size_t)x * cx.stride;
+                    const float* taps = in + (size_t)cx.first[x] * 4;
+#ifdef IMAGE_RESAMPLE_SSE2
+                    __m128 acc = _mm_setzero_ps();
+                    for (int k = 0; k < cx.count[x]; k++) acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(taps + k * 4), _mm_set1_ps(w[k])));
+                    _mm_storeu_ps(out + x * 4, acc);
+#else
+                    for (int k = 0; k < cx.count[x]; k++) Accumulate(out + x * 4, taps + k * 4, w[k], 1);
+#endif
+                }
+            }
+        });
+
+        // vertical pass streams whole rows through the accumulator
+        LinearImage dst;
+        dst.width = dstWidth;
+        dst.height = dstHeight;
+        dst.px.assign((size_t)dstWidth * dstHeight * 4, 0.0f);
+        ParallelRows(dstHeight, pool, [&](int first, int last) {
+            for (int y = first; y < last; y++) {
+                const float* w = cy.weights.data() + (size_t)y * cy.stride;
+                for (int k = 0; k < cy.count[y]; k++) Accumulate(dst.Row(y), wide.Row(cy.first[y] + k), w[k], dstWidth);
+            }
+        });
+        return dst;
+    }
+
+    // Smallest size at the source aspect ratio that still covers a
+    // coverWidth x coverHeight area, for images drawn cropped to fill it.
+    // Returns false when the source is already no larger than that.
+    inline bool CoverSize(int width, int height, int coverWidth, int coverHeight, int& outWidth, int& outHeight) {
+        const double scale = std::max((double)coverWidth / width, (double)coverHeight / height);
+        if (scale >= 1.0) return false;
+        outWidth = std::clamp((int)ceil(width * scale - 1e-6), 1, width);
+        outHeight = std::clamp((int)ceil(height * scale - 1e-6), 1, height);
+        return outWidth < width || outHeight < height;
+    }
+
+    // Resizes an RGBA8 image in linear light. Large reductions box-halve first
+    // until less than 4:1 remains, so the final filter only spans a few source
+    // pixels per tap instead of dozens.
+    inline Level Downscale(const uint8_t* rgba, int width, int height, int dstWidth, int dstHeight, Filter filter, bool srgb = true, ThreadPool* pool = nullptr,
+        Alpha alpha = Alpha::Straight) {
+        const bool halve = width >= dstWidth * 4 && height >= dstHeight * 4;
+        LinearImage current = halve ? ToLinearHalved(rgba, width, height, srgb, pool, alpha) : ToLinear(rgba, width, height, srgb, pool, alpha);
+        while (current.width >= dstWidth * 4 && current.height >= dstHeight * 4) {
+            current = Resample(current, current.width / 2, current.height / 2, Filter::Box, pool);
+        }
+        current = Resample(current, dstWidth, dstHeight, filter, pool);
+
+        Level level;
+        level.width = dstWidth;
+        level.height = dstHeight;
+        level.rgba.resize((size_t)dstWidth * dstHeight * 4);
+        FromLinear(current, srgb, level.rgba.data(), pool, alpha);
+        return level;
+    }
+
+    inline int MipCount(int width, int height) {
+        int count = 1;
+        for (int d = std::max(width, height); d > 1; d >>= 1) count++;
+        return count;
+    }
+
+    // Levels 1..N of the mip chain below an RGBA8 image (level 0 is the image
+    // itself). Each level is filtered from the previous one in linear space.
+    inline std::vector<Level> BuildMipChain(const uint8_t* rgba, int width, int height, Filter filter, bool srgb = true, ThreadPool* pool = nullptr,
+        Alpha alpha = Alpha::Straight) {
+        std::vector<Level> levels;
+        LinearImage current = ToLinear(rgba, width, height, srgb, pool, alpha);
+        const int count = MipCount(width, height);
+        for (int i = 1; i < count; i++) {
+            current = Resample(current, std::max(1, current.width / 2), std::max(1, current.height / 2), filter, pool);
+            Level level;
+            level.width = current.width;
+            level.height = current.height;
+            level.rgba.resize((size_t)current.width * current.height * 4);
+            FromLinear(current, srgb, level.rgba.data(), pool, alpha);
+            levels.push_back(std::move(level));
+        }
+        return levels;
+    }
+}
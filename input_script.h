@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "byte_utils.h"
+
+// Timed input for driving the app unattended
+//
+// A script is text, one action per line:
+//
+//   # comment
+//   TIME phase NAME          frames from here on are reported as NAME
+//   TIME move X Y            mouse to X, Y in window client coordinates
+//   TIME click X Y [BUTTON]  move there, press and release (button 0 default)
+//   TIME down X Y [BUTTON]
+//   TIME up X Y [BUTTON]
+//   TIME key NAME            press and release a key, by ImGui's name for it
+//   TIME keydown NAME
+//   TIME keyup NAME
+//   TIME type TEXT           the rest of the line as text input
+//   TIME expect PAGE         the frame drawn next must show PAGE
+//   TIME end                 the script runs until here
+//
+// TIME is seconds from the start, or +SECONDS after the line before; times
+// never go backwards. Without an end line the script ends with its last
+// action. Page names are the app's (ImGuiApp::PageName). Parsing has no
+// ImGui dependency; ScriptPlayer (headless.h) feeds a script to
+// HeadlessPlatform, where virtual time makes every run the same.
+namespace InputScript {
+    enum class Type { Phase, Move, Click, Down, Up, Key, KeyDown, KeyUp, Text, Expect, End };
+
+    struct Action {
+        double time{ 0.0 };
+        Type type{ Type::Move };
+        float x{ 0.0f };
+        float y{ 0.0f };
+        int button{ 0 };
+        std::string text;  // phase name, key name, text to type or expected page
+        int line{ 0 };
+    };
+
+    struct Script {
+        std::vector<Action> actions;
+        std::vector<std::string> phases;  // in order of appearance
+        double end{ 0.0 };
+    };
+
+    // On failure failureReason names the line and what is wrong with it
+    inline bool Parse(const std::string& text, Script& out, std::string& failureReason) {
+        struct Command {
+            const char* name;
+            Type type;
+        };
+        static const Command commands[] = { { "phase", Type::Phase }, { "move", Type::Move }, { "click", Type::Click },
+            { "down", Type::Down }, { "up", Type::Up }, { "key", Type::Key }, { "keydown", Type::KeyDown },
+            { "keyup", Type::KeyUp }, { "type", Type::Text }, { "expect", Type::Expect }, { "end", Type::End } };
+
+        out = Script{};
+        double time = 0.0;
+        bool ended = false;
+        int lineNumber = 0;
+        size_t begin = 0;
+        while (begin < text.size()) {
+            size_t finish = text.find('\n', begin);
+            if (finish == std::string::npos) finish = text.size();
+            std::string line = text.substr(begin, finish - begin);
+            begin = finish + 1;
+            lineNumber++;
+
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            const size_t first = line.find_first_not_of(" \t");
+            if (first == std::string::npos || line[first] == '#') continue;
+            auto fail = [&](const char* what) {
+                failureReason = "line " + std::to_string(lineNumber) + ": " + what;
+                return false;
+            };
+            if (ended) return fail("action after end");
+
+            const char* p = line.c_str() + first;
+            const bool relative = *p == '+';
+            char* next = nullptr;
+            const double value = strtod(relative ? p + 1 : p, &next);
+            if (next == (relative ? p + 1 : p) || value < 0.0) return fail("expected a time");
+            if (!relative && value < time) return fail("time goes backwards");
+            time = relative ? time + value : value;
+
+            while (*next == ' ' || *next == '\t') next++;
+            const char* nameEnd = next;
+            while (*nameEnd && *nameEnd != ' ' && *nameEnd != '\t') nameEnd++;
+            const std::string name(next, (size_t)(nameEnd - next));
+            const Command* command = nullptr;
+            for (const Command& c : commands) {
+                if (name == c.name) command = &c;
+            }
+            if (!command) return fail("unknown action");
+
+            Action action;
+            action.time = time;
+            action.type = command->type;
+            action.line = lineNumber;
+            const char* args = nameEnd;
+            while (*args == ' ' || *args == '\t') args++;
+            std::string rest = args;
+            while (!rest.empty() && (rest.back() == ' ' || rest.back() == '\t')) rest.pop_back();
+
+            switch (action.type) {
+            case Type::Move:
+            case Type::Click:
+            case Type::Down:
+            case Type::Up: {
+                const int fields = sscanf(rest.c_str(), "%f %f %d", &action.x, &action.y, &action.button);
+                if (fields < 2 || (action.type == Type::Move && fields > 2)) return fail("expected X Y, and a button for clicks");
+                if (action.button < 0 || action.button > 4) return fail("buttons are 0 to 4");
+                break;
+            }
+            case Type::Phase:
+            case Type::Expect:
+            case Type::Key:
+            case Type::KeyDown:
+            case Type::KeyUp:
+                if (rest.empty() || rest.find_first_of(" \t") != std::string::npos) return fail("expected one name");
+                action.text = rest;
+                break;
+            case Type::Text:
+                if (rest.empty()) return fail("nothing to type");
+                action.text = rest;
+                break;
+            case Type::End:
+                if (!rest.empty()) return fail("end takes nothing");
+                ended = true;
+                break;
+            }
+
+            if (action.type == Type::Phase) {
+                bool known = false;
+                for (const std::string& phase : out.phases) known |= phase == action.text;
+                if (!known) out.phases.push_back(action.text);
+            }
+            out.actions.push_back(action);
+        }
+        out.end = time;
+        return true;
+    }
+
+    inline bool Load(const std::string& path, Script& out, std::string& failureReason) {
+        std::vector<unsigned char> file;
+        if (!ReadFileBytes(path, file)) {
+            failureReason = "can't read the file";
+            return false;
+        }
+        return Parse(std::string(file.begin(), file.end()), out, failureReason);
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+
+#include "imgui.h"
+#include "texture_loader.h"
+
+// What ImGuiApp needs from the OS and from the GPU
+//
+// The UI code only talks to these two interfaces, so it builds anywhere
+// ImGui does. main.cpp implements them with Win32 and D3D11; headless.h has
+// a fake window with injected input and a renderer that draws nothing, for
+// running the UI on Linux.
+struct ScreenPoint {
+    int x{ 0 };
+    int y{ 0 };
+};
+
+struct WindowRect {
+    int x{ 0 };
+    int y{ 0 };
+    int width{ 0 };
+    int height{ 0 };
+};
+
+class IPlatform {
+public:
+    virtual ~IPlatform() = default;
+
+    // Creates the window centred on screen and starts ImGui's platform
+    // backend; the ImGui context must exist already
+    virtual bool Initialize(const char* title, int width, int height) = 0;
+    virtual void Shutdown() = 0;
+
+    // Handles pending OS events and sets received if there were any; false
+    // once the app should quit
+    virtual bool PumpEvents(bool& received) = 0;
+    // Blocks until an event is pending, Wake() is called or timeout seconds
+    // pass (an infinite timeout waits for the first two); true if it did not
+    // time out
+    virtual bool WaitEvents(double timeout) = 0;
+    // Ends a WaitEvents() in progress or the next one; any thread may call it
+    virtual void Wake() = 0;
+    // Seconds on the clock WaitEvents() times out by
+    virtual double Time() const = 0;
+    // Feeds ImGuiIO for the coming frame: display size, time step, input
+    virtual void NewFrame() = 0;
+    virtual void RequestQuit() = 0;
+
+    // Screen coordinates
+    virtual WindowRect GetWindowRect() const = 0;
+    virtual void SetWindowRect(const WindowRect& rect) = 0;
+    virtual void MoveWindow(int x, int y) = 0;
+    virtual ScreenPoint GetCursorPos() const = 0;
+
+    // A file shipped next to the executable, and one of the OS fonts
+    virtual std::string AssetPath(const char* name) const = 0;
+    virtual std::string SystemFontPath(const char* name) const = 0;
+    virtual void Log(const char* message) = 0;
+
+    // HWND on Windows; renderers that present to a window need it
+    virtual void* NativeWindow() const = 0;
+};
+
+class IRenderer {
+public:
+    virtual ~IRenderer() = default;
+
+    // Creates the device for the platform's window and starts ImGui's
+    // renderer backend
+    virtual bool Initialize(IPlatform& platform) = 0;
+    virtual void Shutdown() = 0;
+
+    virtual void NewFrame() = 0;
+    // Draws ImGui::GetDrawData() and presents it
+    virtual void Render(const ImVec4& clearColor) = 0;
+    virtual void Resize(int width, int height) = 0;
+
+    virtual bool SupportsBC7() const = 0;
+    // Uploads a prepared texture; returns its ImTextureID, or nullptr
+    virtual void* CreateTexture(const TextureLoader::Prepared& prepared) = 0;
+    virtual void ReleaseTexture(void* texture) = 0;
+
+    // Draws a premultiplied-alpha texture with the matching blend state. The
+    // whole vertex colour is scaled by alpha, which is how a premultiplied
+    // source fades.
+    virtual void AddImagePremultiplied(ImDrawList* drawList, void* texture, const ImVec2& min, const ImVec2& max,
+        const ImVec2& uvMin, const ImVec2& uvMax, float alpha) = 0;
+};
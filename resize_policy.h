@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+// Decides when a swapchain's buffers have to be reallocated
+//
+// ResizeBuffers() drops the back buffers and every view of them, and the
+// window width animation would otherwise call it every frame. The policy
+// keeps the buffers at least as large as the visible area; the renderer
+// draws into the visible top-left corner and presents only that part. The
+// buffers are reallocated only when the visible area no longer fits:
+//   Exact    buffers always match the visible area (the old behaviour)
+//   Buckets  sizes round up to a multiple of bucket, and shrink again only
+//            once the buffers hold shrinkRatio times the visible area
+//   Maximum  allocated once at maxWidth x maxHeight, the largest size the
+//            app uses; a larger area still grows them, nothing shrinks them
+class ResizePolicy {
+public:
+    enum class Mode { Exact, Buckets, Maximum };
+
+    struct Options {
+        Mode mode{ Mode::Buckets };
+        int bucket{ 128 };
+        double shrinkRatio{ 4.0 };
+        int maxWidth{ 0 };
+        int maxHeight{ 0 };
+    };
+
+    struct Size {
+        int width{ 0 };
+        int height{ 0 };
+    };
+
+    struct Stats {
+        uint64_t resizes{ 0 };
+        uint64_t reallocations{ 0 };
+    };
+
+private:
+    Options options;
+    Size visible;
+    Size allocated;
+    Stats stats;
+
+    int RoundUp(int value) const {
+        const int bucket = std::max(1, options.bucket);
+        return (value + bucket - 1) / bucket * bucket;
+    }
+
+    Size Target(const Size& size) const {
+        switch (options.mode) {
+        case Mode::Buckets:
+            return { RoundUp(size.width), RoundUp(size.height) };
+        case Mode::Maximum:
+            return { std::max({ size.width, allocated.width, options.maxWidth }), std::max({ size.height, allocated.height, options.maxHeight }) };
+        default:
+            return size;
+        }
+    }
+
+public:
+    ResizePolicy() {}
+    explicit ResizePolicy(Options options) : options(options) {}
+
+    // The visible area is now width x height; true if the buffers must be
+    // reallocated at Allocated()
+    bool Resize(int width, int height) {
+        visible = { std::max(1, width), std::max(1, height) };
+        stats.resizes++;
+
+        bool reallocate = visible.width > allocated.width || visible.height > allocated.height;
+        if (!reallocate && options.mode == Mode::Exact) {
+            reallocate = visible.width != allocated.width || visible.height != allocated.height;
+        }
+        if (!reallocate && options.mode == Mode::Buckets) {
+            const double allocatedArea = (double)allocated.width * allocated.height;
+            reallocate = allocatedArea > options.shrinkRatio * visible.width * visible.height;
+        }
+        if (!reallocate) return false;
+
+        allocated = Target(visible);
+        stats.reallocations++;
+        return true;
+    }
+
+    // Forgets the allocation, e.g. after the device was lost; the next
+    // Resize() reallocates
+    void Reset() { allocated = {}; }
+
+    Size Visible() const { return visible; }
+    Size Allocated() const { return allocated; }
+    const Options& GetOptions() const { return options; }
+    const Stats& GetStats() const { return stats; }
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+
+// Time as the app's animations and timers see it
+//
+// Real follows the platform's clock, with one frame's step capped at
+// maxStep so a stall (a dragged window, a debugger) doesn't skip whole
+// animations. FixedStep moves exactly step per frame whatever the wall
+// clock does, so what a frame shows depends only on how many frames came
+// before it. Manual moves only as far as Advance() asks, for tools that
+// jump to the end of an animation in one frame. Call Tick() once per
+// frame; Now() and Delta() then describe that frame.
+class SimClock {
+public:
+    enum class Mode { Real, FixedStep, Manual };
+
+    struct Options {
+        Mode mode{ Mode::Real };
+        double step{ 1.0 / 60.0 };  // FixedStep's step, and Real's first
+        double maxStep{ 0.25 };     // Real's cap on one frame's step
+    };
+
+private:
+    Options options;
+    double now{ 0.0 };
+    double delta{ 0.0 };
+    double lastPlatformTime{ 0.0 };
+    double pending{ 0.0 };
+    bool started{ false };
+
+public:
+    SimClock() {}
+    explicit SimClock(Options options) : options(options) {}
+
+    void Tick(double platformTime) {
+        switch (options.mode) {
+        case Mode::Real:
+            delta = started ? std::clamp(platformTime - lastPlatformTime, 0.0, options.maxStep) : options.step;
+            break;
+        case Mode::FixedStep:
+            delta = options.step;
+            break;
+        case Mode::Manual:
+            delta = pending;
+            pending = 0.0;
+            break;
+        }
+        lastPlatformTime = platformTime;
+        started = true;
+        now += delta;
+    }
+
+    // Manual: the next Tick() moves the clock this much further
+    void Advance(double seconds) { pending += std::max(0.0, seconds); }
+
+    // Takes effect at the next Tick(); Now() carries on from where it is
+    void SetMode(Mode mode) { options.mode = mode; }
+
+    double Now() const { return now; }
+    double Delta() const { return delta; }
+    const Options& GetOptions() const { return options; }
+};
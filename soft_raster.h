@@ -0,0 +1,645 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFT_RASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "thread_pool.h"
+
+// CPU rasterizer for ImGui-style draw lists
+//
+// Follows the rules a D3D11 GPU draws ImGui with: vertices snap to 1/256
+// pixel, pixels are sampled at their centres, edges shared by two triangles
+// go to exactly one of them (top-left rule), textures are sampled
+// bilinearly with wrapping, scissor rects are whole pixels and blending is
+// ImGui's straight alpha or premultiplied. Edge functions on the snapped
+// coordinates are whole numbers well inside a double's mantissa, so they
+// are exact and tested two pixels per SSE2 instruction.
+//
+// A frame runs in two passes on the rasterizer's own pool. Setup splits the
+// triangles into chunks; each chunk computes edge and attribute planes and
+// bins its triangles into 64x64 screen tiles. Then every tile is cleared
+// and drawn by one task, walking the chunks in order, so draw order holds
+// without any locking and each tile stays in cache.
+namespace SoftRaster {
+    // Same layout as ImDrawVert
+    struct Vertex {
+        float x, y;
+        float u, v;
+        uint32_t col;  // RGBA8, red in the low byte
+    };
+
+    struct Texture {
+        int width{ 0 };
+        int height{ 0 };
+        std::vector<uint8_t> rgba;
+    };
+
+    enum class Blend { Alpha, Premultiplied };
+
+    struct Command {
+        float clip[4];  // x0, y0, x1, y1 in vertex coordinates
+        const Texture* texture;  // nullptr samples opaque white
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t vertexOffset;
+        Blend blend;
+    };
+
+    struct Mesh {
+        const Vertex* vertices{ nullptr };
+        const void* indices{ nullptr };
+        int indexSize{ 2 };  // bytes per index, 2 or 4
+        std::vector<Command> commands;
+    };
+
+    // Maps vertex coordinates to pixels: (x + offset) * scale
+    struct Transform {
+        float offsetX{ 0.0f };
+        float offsetY{ 0.0f };
+        float scaleX{ 1.0f };
+        float scaleY{ 1.0f };
+    };
+
+    struct Stats {
+        size_t triangles{ 0 };  // submitted
+        size_t drawn{ 0 };      // left after scissor and culling of empty ones
+        size_t binned{ 0 };     // triangle and tile pairs
+        double setupMs{ 0.0 };
+        double rasterMs{ 0.0 };
+    };
+
+    constexpr int TileSize = 64;
+    constexpr int SubpixelBits = 8;
+    // Triangles reaching further off-screen are dropped; it keeps the edge
+    // functions exact
+    constexpr float GuardBand = 32768.0f;
+
+    struct Triangle {
+        int x0, y0, x1, y1;  // pixels covered by the bounds, end exclusive
+        // edge k is inside where a*x + b*y + c >= 0 at pixel (x, y); the
+        // top-left rule is folded into c
+        double a[3], b[3], c[3];
+        // value at pixel (x0, y0), then per pixel in x and in y
+        float color[3][4];
+        float uv[3][2];
+        const Texture* texture;  // nullptr when the texel is constant and folded into color
+        Blend blend;
+        // one texel per pixel with pixel centres on texel centres, as for
+        // glyphs and cover-sized images: bilinear is a plain fetch, starting
+        // at this texel for pixel (x0, y0)
+        bool texelAligned;
+        int texelX, texelY;
+    };
+
+    // The two texels either side of texture coordinate f (in texels, centres
+    // on whole numbers), wrapped, and the weight of the second
+    inline void Wrap(float f, int size, int& i0, int& i1, float& weight) {
+        int i = (int)f;
+        if ((float)i > f) i--;
+        weight = f - (float)i;
+        if (i < 0 || i >= size - 1) {
+            i %= size;
+            if (i < 0) i += size;
+        }
+        i0 = i;
+        i1 = i + 1 == size ? 0 : i + 1;
+    }
+
+#ifdef SOFT_RASTER_SSE2
+    inline __m128 LoadPixel(const uint8_t* p) {
+        int32_t bits;
+        memcpy(&bits, p, 4);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bits), zero), zero);
+        return _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(1.0f / 255.0f));
+    }
+
+    inline void StorePixel(uint8_t* p, __m128 color) {
+        const __m128i v = _mm_cvtps_epi32(_mm_mul_ps(color, _mm_set1_ps(255.0f)));
+        const int32_t bits = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(v, v), v));
+        memcpy(p, &bits, 4);
+    }
+
+    inline __m128 Sample(const Texture& texture, float u, float v) {
+        float fx = u * texture.width - 0.5f, fy = v * texture.height - 0.5f;
+        if (!(fabsf(fx) < 1e7f && fabsf(fy) < 1e7f)) fx = fy = 0.0f;
+        int x0, y0, x1, y1;
+        float tx, ty;
+        Wrap(fx, texture.width, x0, x1, tx);
+        Wrap(fy, texture.height, y0, y1, ty);
+        const uint8_t* row0 = texture.rgba.data() + (size_t)y0 * texture.width * 4;
+        const uint8_t* row1 = texture.rgba.data() + (size_t)y1 * texture.width * 4;
+        // neighbours in a row sit side by side unless the row wraps
+        const __m128i zero = _mm_setzero_si128();
+        auto pair = [&](const uint8_t* row) {
+            if (x1 == x0 + 1) return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(row + x0 * 4)), zero);
+            int32_t a, b;
+            memcpy(&a, row + x0 * 4, 4);
+            memcpy(&b, row + x1 * 4, 4);
+            return _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b)), zero);
+        };
+        const __m128i top2 = pair(row0), bottom2 = pair(row1);
+        const __m128 t00 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(top2, zero)), t10 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(top2, zero));
+        const __m128 t01 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(bottom2, zero)), t11 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(bottom2, zero));
+        const __m128 top = _mm_add_ps(t00, _mm_mul_ps(_mm_sub_ps(t10, t00), _mm_set1_ps(tx)));
+        const __m128 bottom = _mm_add_ps(t01, _mm_mul_ps(_mm_sub_ps(t11, t01), _mm_set1_ps(tx)));
+        return _mm_mul_ps(_mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(ty))), _mm_set1_ps(1.0f / 255.0f));
+    }
+#else
+    inline void LoadPixel(const uint8_t* p, float out[4]) {
+        for (int c = 0; c < 4; c++) out[c] = p[c] * (1.0f / 255.0f);
+    }
+
+    inline void StorePixel(uint8_t* p, const float color[4]) {
+        for (int c = 0; c < 4; c++) p[c] = (uint8_t)std::clamp((int)lrintf(color[c] * 255.0f), 0, 255);
+    }
+
+    inline void Sample(const Texture& texture, float u, float v, float out[4]) {
+        float fx = u * texture.width - 0.5f, fy = v * texture.height - 0.5f;
+        if (!(fabsf(fx) < 1e7f && fabsf(fy) < 1e7f)) fx = fy = 0.0f;
+        int x0, y0, x1, y1;
+        float tx, ty;
+        Wrap(fx, texture.width, x0, x1, tx);
+        Wrap(fy, texture.height, y0, y1, ty);
+        const uint8_t* row0 = texture.rgba.data() + (size_t)y0 * texture.width * 4;
+        const uint8_t* row1 = texture.rgba.data() + (size_t)y1 * texture.width * 4;
+        for (int c = 0; c < 4; c++) {
+            const float top = row0[x0 * 4 + c] + (row0[x1 * 4 + c] - row0[x0 * 4 + c]) * tx;
+            const float bottom = row1[x0 * 4 + c] + (row1[x1 * 4 + c] - row1[x0 * 4 + c]) * tx;
+            out[c] = (top + (bottom - top) * ty) * (1.0f / 255.0f);
+        }
+    }
+#endif
+
+    // Edge and attribute planes for one triangle; false when it covers no
+    // pixel inside the scissor rect
+    inline bool SetupTriangle(const Vertex* const (&v)[3], const Command& command, const Transform& transform,
+        int targetWidth, int targetHeight, Triangle& t) {
+        constexpr double Subpixels = 1 << SubpixelBits;
+        double px[3], py[3];
+        int64_t sx[3], sy[3];
+        for (int i = 0; i < 3; i++) {
+            const float x = (v[i]->x + transform.offsetX) * transform.scaleX;
+            const float y = (v[i]->y + transform.offsetY) * transform.scaleY;
+            if (!(fabsf(x) < GuardBand && fabsf(y) < GuardBand)) return false;
+            sx[i] = llrint(x * Subpixels);
+            sy[i] = llrint(y * Subpixels);
+            px[i] = sx[i] / Subpixels;
+            py[i] = sy[i] / Subpixels;
+        }
+
+        // edges run so the third vertex is on their inside whichever way
+        // the triangle winds
+        const int64_t area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+        if (area == 0) return false;
+        int order[3] = { 0, 1, 2 };
+        if (area < 0) std::swap(order[1], order[2]);
+
+        // scissor rects are truncated to whole pixels, as D3D11 takes them
+        auto clipPixel = [](float c, float offset, float scale) { return (int)std::clamp((c + offset) * scale, -GuardBand, GuardBand); };
+        const int clipX0 = std::max(0, clipPixel(command.clip[0], transform.offsetX, transform.scaleX));
+        const int clipY0 = std::max(0, clipPixel(command.clip[1], transform.offsetY, transform.scaleY));
+        const int clipX1 = std::min(targetWidth, clipPixel(command.clip[2], transform.offsetX, transform.scaleX));
+        const int clipY1 = std::min(targetHeight, clipPixel(command.clip[3], transform.offsetY, transform.scaleY));
+
+        // pixel x is a candidate when its centre, x * 256 + 128, lies within
+        // the bounds (shifts of negative values round down)
+        const int64_t half = 1 << (SubpixelBits - 1), round = (1 << SubpixelBits) - 1;
+        t.x0 = std::max(clipX0, (int)((std::min({ sx[0], sx[1], sx[2] }) - half + round) >> SubpixelBits));
+        t.y0 = std::max(clipY0, (int)((std::min({ sy[0], sy[1], sy[2] }) - half + round) >> SubpixelBits));
+        t.x1 = std::min(clipX1, (int)((std::max({ sx[0], sx[1], sx[2] }) - half) >> SubpixelBits) + 1);
+        t.y1 = std::min(clipY1, (int)((std::max({ sy[0], sy[1], sy[2] }) - half) >> SubpixelBits) + 1);
+        if (t.x0 >= t.x1 || t.y0 >= t.y1) return false;
+
+        for (int k = 0; k < 3; k++) {
+            const int i = order[k], j = order[(k + 1) % 3];
+            const int64_t dx = sx[j] - sx[i], dy = sy[j] - sy[i];
+            const bool topLeft = dy < 0 || (dy == 0 && dx > 0);
+            t.a[k] = (double)(-dy * (1 << SubpixelBits));
+            t.b[k] = (double)(dx * (1 << SubpixelBits));
+            t.c[k] = (double)(dx * (half - sy[i]) - dy * (half - sx[i]) - (topLeft ? 0 : 1));
+        }
+
+        // attribute planes in pixels, evaluated at the centre of (x0, y0)
+        const double det = (double)area / (Subpixels * Subpixels);
+        const double ex1 = px[1] - px[0], ey1 = py[1] - py[0], ex2 = px[2] - px[0], ey2 = py[2] - py[0];
+        const double cx = t.x0 + 0.5 - px[0], cy = t.y0 + 0.5 - py[0];
+        auto plane = [&](float f0, float f1, float f2, float out[3][4], int channel) {
+            const double dfdx = ((f1 - f0) * ey2 - (f2 - f0) * ey1) / det;
+            const double dfdy = ((f2 - f0) * ex1 - (f1 - f0) * ex2) / det;
+            out[0][channel] = (float)(f0 + dfdx * cx + dfdy * cy);
+            out[1][channel] = (float)dfdx;
+            out[2][channel] = (float)dfdy;
+        };
+        for (int c = 0; c < 4; c++) {
+            plane((v[0]->col >> (c * 8) & 0xff) / 255.0f, (v[1]->col >> (c * 8) & 0xff) / 255.0f, (v[2]->col >> (c * 8) & 0xff) / 255.0f,
+                t.color, c);
+        }
+
+        t.blend = command.blend;
+        t.texture = command.texture;
+        t.texelAligned = false;
+        memset(t.uv, 0, sizeof(t.uv));
+        const bool flatUv = v[0]->u == v[1]->u && v[0]->u == v[2]->u && v[0]->v == v[1]->v && v[0]->v == v[2]->v;
+        if (t.texture && !flatUv) {
+            float uv[3][4];
+            plane(v[0]->u, v[1]->u, v[2]->u, uv, 0);
+            plane(v[0]->v, v[1]->v, v[2]->v, uv, 1);
+            for (int r = 0; r < 3; r++) {
+                t.uv[r][0] = uv[r][0];
+                t.uv[r][1] = uv[r][1];
+            }
+
+            const float w = (float)t.texture->width, h = (float)t.texture->height;
+            const float fx = t.uv[0][0] * w - 0.5f, fy = t.uv[0][1] * h - 0.5f;
+            auto near = [](float a, float b) { return fabsf(a - b) < 1e-3f; };
+            t.texelAligned = near(t.uv[1][0] * w, 1.0f) && near(t.uv[2][1] * h, 1.0f) && near(t.uv[2][0] * w, 0.0f) && near(t.uv[1][1] * h, 0.0f) &&
+                fabsf(fx) < 1e7f && fabsf(fy) < 1e7f && near(fx, roundf(fx)) && near(fy, roundf(fy));
+            if (t.texelAligned) {
+                // whole rows of the triangle stay within the tolerance
+                const float drift = (float)std::max(t.x1 - t.x0, t.y1 - t.y0) * (fabsf(t.uv[1][0] * w - 1.0f) + fabsf(t.uv[2][1] * h - 1.0f) +
+                    fabsf(t.uv[2][0] * w) + fabsf(t.uv[1][1] * h));
+                t.texelAligned = drift < 1e-3f;
+            }
+            if (t.texelAligned) {
+                t.texelX = (int)roundf(fx) % t.texture->width;
+                t.texelY = (int)roundf(fy) % t.texture->height;
+                if (t.texelX < 0) t.texelX += t.texture->width;
+                if (t.texelY < 0) t.texelY += t.texture->height;
+            }
+        }
+        else if (t.texture) {
+            // solid shapes sample ImGui's white texel; a constant texel
+            // scales the colour planes and the pixel loop skips sampling
+            float texel[4];
+#ifdef SOFT_RASTER_SSE2
+            _mm_storeu_ps(texel, Sample(*t.texture, v[0]->u, v[0]->v));
+#else
+            Sample(*t.texture, v[0]->u, v[0]->v, texel);
+#endif
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 4; c++) t.color[r][c] *= texel[c];
+            }
+            t.texture = nullptr;
+        }
+        return true;
+    }
+
+    inline int FloorToInt(double v) {
+        v = std::clamp(v, -1e9, 1e9);
+        const int i = (int)v;
+        return (double)i > v ? i - 1 : i;
+    }
+
+    // Whether any pixel of [x0, x1) x [y0, y1) can be inside: each edge is
+    // tested at the corner where it is largest
+    inline bool TouchesRect(const Triangle& t, int x0, int y0, int x1, int y1) {
+        for (int k = 0; k < 3; k++) {
+            const double x = t.a[k] > 0.0 ? x1 - 1 : x0, y = t.b[k] > 0.0 ? y1 - 1 : y0;
+            if (t.a[k] * x + t.b[k] * y + t.c[k] < 0.0) return false;
+        }
+        return true;
+    }
+
+    // How a triangle's pixels get their colour
+    enum class Shading {
+        Solid,     // one colour throughout
+        Gradient,  // interpolated colour, constant texel (folded in)
+        Aligned,   // interpolated colour times a texel fetch (Triangle::texelAligned)
+        Bilinear,  // interpolated colour times a bilinear sample
+    };
+
+    inline Shading ShadingOf(const Triangle& t) {
+        if (t.texelAligned) return Shading::Aligned;
+        if (t.texture) return Shading::Bilinear;
+        for (int c = 0; c < 4; c++) {
+            if (t.color[1][c] != 0.0f || t.color[2][c] != 0.0f) return Shading::Gradient;
+        }
+        return Shading::Solid;
+    }
+
+    // Draws the part of a triangle inside [x0, x1) x [y0, y1) into an RGBA8
+    // target. Everything the loops need is copied to locals first: the
+    // pixel stores could alias the triangle as far as the compiler knows.
+    template<Shading Mode, Blend BlendMode>
+    inline void DrawTriangleAs(const Triangle& t, int x0, int y0, int x1, int y1, uint8_t* pixels, int stride) {
+        double a[3], b[3], c[3], inverseA[3];
+        for (int k = 0; k < 3; k++) {
+            a[k] = t.a[k];
+            b[k] = t.b[k];
+            c[k] = t.c[k];
+            inverseA[k] = a[k] != 0.0 ? 1.0 / a[k] : 0.0;
+        }
+        const int originX = t.x0, originY = t.y0;
+        const Texture* texture = t.texture;
+        const int textureWidth = texture ? texture->width : 1, textureHeight = texture ? texture->height : 1;
+        const int texelX = t.texelX, texelY = t.texelY;
+        const float u0 = t.uv[0][0], v0 = t.uv[0][1], dudx = t.uv[1][0], dvdx = t.uv[1][1], dudy = t.uv[2][0], dvdy = t.uv[2][1];
+
+#ifdef SOFT_RASTER_SSE2
+        __m128d low[3], high[3];
+        for (int k = 0; k < 3; k++) {
+            low[k] = _mm_set_pd(a[k], 0.0);
+            high[k] = _mm_set_pd(a[k] * 3.0, a[k] * 2.0);
+        }
+        const __m128 color0 = _mm_loadu_ps(t.color[0]), dcdx = _mm_loadu_ps(t.color[1]), dcdy = _mm_loadu_ps(t.color[2]);
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+        const __m128 alphaLane = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+        // premultiplies by alpha where ImGui's blend state would
+        auto source = [&](__m128 color, __m128& alpha) {
+            color = _mm_min_ps(_mm_max_ps(color, zero), one);
+            alpha = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3));
+            if (BlendMode == Blend::Alpha) color = _mm_or_ps(_mm_andnot_ps(alphaLane, _mm_mul_ps(color, alpha)), _mm_and_ps(alphaLane, color));
+            return color;
+        };
+        __m128 solidAlpha = zero;
+        const __m128 solid = source(color0, solidAlpha);
+        const __m128 solidKeep = _mm_mul_ps(_mm_sub_ps(one, solidAlpha), _mm_set1_ps(1.0f / 255.0f));
+        const __m128 solid255 = _mm_mul_ps(solid, _mm_set1_ps(255.0f));
+#endif
+
+        for (int y = y0; y < y1; y++) {
+            // narrow the row to where the edges cross it, give or take a
+            // pixel of rounding; long thin triangles would otherwise test
+            // their whole bounds
+            int first = x0, last = x1;
+            for (int k = 0; k < 3; k++) {
+                const double atZero = b[k] * y + c[k];
+                if (a[k] > 0.0) first = std::max(first, FloorToInt(-atZero * inverseA[k]) - 1);
+                else if (a[k] < 0.0) last = std::min(last, FloorToInt(-atZero * inverseA[k]) + 2);
+                else if (atZero < 0.0) last = first;
+            }
+            if (first >= last) continue;
+
+            uint8_t* row = pixels + (size_t)y * stride;
+            double e[3];
+            for (int k = 0; k < 3; k++) e[k] = a[k] * first + b[k] * y + c[k];
+            const float fy = (float)(y - originY);
+            const float rowU = u0 + dudy * fy, rowV = v0 + dvdy * fy;
+            const uint8_t* texelRow = nullptr;
+            if (Mode == Shading::Aligned) texelRow = texture->rgba.data() + (size_t)((texelY + y - originY) % textureHeight) * textureWidth * 4;
+#ifdef SOFT_RASTER_SSE2
+            const __m128 rowColor = _mm_add_ps(color0, _mm_mul_ps(dcdy, _mm_set1_ps(fy)));
+#endif
+
+            for (int x = first; x < last; x += 4) {
+                int mask;
+#ifdef SOFT_RASTER_SSE2
+                __m128d inLow = _mm_castsi128_pd(_mm_set1_epi32(-1)), inHigh = inLow;
+                for (int k = 0; k < 3; k++) {
+                    const __m128d base = _mm_set1_pd(e[k]);
+                    inLow = _mm_and_pd(inLow, _mm_cmpge_pd(_mm_add_pd(base, low[k]), _mm_setzero_pd()));
+                    inHigh = _mm_and_pd(inHigh, _mm_cmpge_pd(_mm_add_pd(base, high[k]), _mm_setzero_pd()));
+                    e[k] += a[k] * 4.0;
+                }
+                mask = _mm_movemask_pd(inLow) | _mm_movemask_pd(inHigh) << 2;
+#else
+                mask = 0;
+                for (int i = 0; i < 4; i++) {
+                    if (e[0] + a[0] * i >= 0.0 && e[1] + a[1] * i >= 0.0 && e[2] + a[2] * i >= 0.0) mask |= 1 << i;
+                }
+                for (int k = 0; k < 3; k++) e[k] += a[k] * 4.0;
+#endif
+                if (last - x < 4) mask &= (1 << (last - x)) - 1;
+
+#ifdef SOFT_RASTER_SSE2
+                if (Mode == Shading::Solid && mask == 15) {
+                    // four pixels at once: widen, blend, narrow
+                    uint8_t* dst = row + (size_t)x * 4;
+                    const __m128i packed = _mm_loadu_si128((const __m128i*)dst), zeroi = _mm_setzero_si128();
+                    const __m128i lo = _mm_unpacklo_epi8(packed, zeroi), hi = _mm_unpackhi_epi8(packed, zeroi);
+                    __m128i out[4];
+                    const __m128i wide[4] = { _mm_unpacklo_epi16(lo, zeroi), _mm_unpackhi_epi16(lo, zeroi), _mm_unpacklo_epi16(hi, zeroi), _mm_unpackhi_epi16(hi, zeroi) };
+                    for (int i = 0; i < 4; i++) out[i] = _mm_cvtps_epi32(_mm_add_ps(solid255, _mm_mul_ps(_mm_cvtepi32_ps(wide[i]), _mm_mul_ps(solidKeep, _mm_set1_ps(255.0f)))));
+                    _mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(_mm_packs_epi32(out[0], out[1]), _mm_packs_epi32(out[2], out[3])));
+                    continue;
+                }
+#endif
+
+                for (int i = 0; i < 4; i++) {
+                    if (!(mask & 1 << i)) continue;
+                    const int px = x + i;
+                    const float fx = (float)(px - originX);
+                    uint8_t* dst = row + (size_t)px * 4;
+                    int texel = 0;
+                    if (Mode == Shading::Aligned) {
+                        texel = texelX + px - originX;
+                        if (texel >= textureWidth) texel %= textureWidth;
+                    }
+#ifdef SOFT_RASTER_SSE2
+                    __m128 src, alpha;
+                    if (Mode == Shading::Solid) {
+                        src = solid;
+                        alpha = solidAlpha;
+                    }
+                    else {
+                        __m128 color = _mm_add_ps(rowColor, _mm_mul_ps(dcdx, _mm_set1_ps(fx)));
+                        if (Mode == Shading::Aligned) color = _mm_mul_ps(color, LoadPixel(texelRow + (size_t)texel * 4));
+                        if (Mode == Shading::Bilinear) color = _mm_mul_ps(color, Sample(*texture, rowU + dudx * fx, rowV + dvdx * fx));
+                        src = source(color, alpha);
+                    }
+                    StorePixel(dst, _mm_add_ps(src, _mm_mul_ps(LoadPixel(dst), _mm_sub_ps(one, alpha))));
+#else
+                    float src[4], sample[4] = { 1.0f, 1.0f, 1.0f, 1.0f }, old[4];
+                    if (Mode == Shading::Aligned) LoadPixel(texelRow + (size_t)texel * 4, sample);
+                    if (Mode == Shading::Bilinear) Sample(*texture, rowU + dudx * fx, rowV + dvdx * fx, sample);
+                    for (int ch = 0; ch < 4; ch++) src[ch] = std::clamp((t.color[0][ch] + t.color[2][ch] * fy + t.color[1][ch] * fx) * sample[ch], 0.0f, 1.0f);
+                    const float alpha = src[3];
+                    if (BlendMode == Blend::Alpha) {
+                        for (int ch = 0; ch < 3; ch++) src[ch] *= alpha;
+                    }
+                    LoadPixel(dst, old);
+                    for (int ch = 0; ch < 4; ch++) src[ch] += old[ch] * (1.0f - alpha);
+                    StorePixel(dst, src);
+#endif
+                }
+            }
+        }
+    }
+
+    inline void DrawTriangle(const Triangle& t, int x0, int y0, int x1, int y1, uint8_t* pixels, int stride) {
+        const bool premultiplied = t.blend == Blend::Premultiplied;
+        switch (ShadingOf(t)) {
+        case Shading::Solid:
+            if (premultiplied) DrawTriangleAs<Shading::Solid, Blend::Premultiplied>(t, x0, y0, x1, y1, pixels, stride);
+            else DrawTriangleAs<Shading::Solid, Blend::Alpha>(t, x0, y0, x1, y1, pixels, stride);
+            break;
+        case Shading::Gradient:
+            if (premultiplied) DrawTriangleAs<Shading::Gradient, Blend::Premultiplied>(t, x0, y0, x1, y1, pixels, stride);
+            else DrawTriangleAs<Shading::Gradient, Blend::Alpha>(t, x0, y0, x1, y1, pixels, stride);
+            break;
+        case Shading::Aligned:
+            if (premultiplied) DrawTriangleAs<Shading::Aligned, Blend::Premultiplied>(t, x0, y0, x1, y1, pixels, stride);
+            else DrawTriangleAs<Shading::Aligned, Blend::Alpha>(t, x0, y0, x1, y1, pixels, stride);
+            break;
+        case Shading::Bilinear:
+            if (premultiplied) DrawTriangleAs<Shading::Bilinear, Blend::Premultiplied>(t, x0, y0, x1, y1, pixels, stride);
+            else DrawTriangleAs<Shading::Bilinear, Blend::Alpha>(t, x0, y0, x1, y1, pixels, stride);
+            break;
+        }
+    }
+
+    class Rasterizer {
+        struct Chunk {
+            std::vector<Triangle> triangles;
+            std::vector<std::vector<uint32_t>> bins;  // per tile, indices into triangles
+        };
+
+        struct CommandRef {
+            const Mesh* mesh;
+            const Command* command;
+            size_t firstTriangle;
+        };
+
+        std::unique_ptr<ThreadPool> pool;
+        int width{ 0 };
+        int height{ 0 };
+        int tilesX{ 0 };
+        int tilesY{ 0 };
+        std::vector<uint8_t> pixels;
+        std::vector<Chunk> chunks;
+        std::vector<CommandRef> commands;
+        Stats stats;
+
+        // One task per item; the pool is ours, so waiting here is safe
+        template<typename Body>
+        void ForEach(int count, Body&& body) {
+            if (!pool || count < 2) {
+                for (int i = 0; i < count; i++) body(i);
+                return;
+            }
+            for (int i = 0; i < count; i++) pool->Submit([&body, i] { body(i); });
+            pool->Wait();
+        }
+
+        template<typename Index>
+        void SetupChunk(Chunk& chunk, size_t first, size_t last, const Transform& transform) {
+            chunk.triangles.clear();
+            for (std::vector<uint32_t>& bin : chunk.bins) bin.clear();
+            if (first >= last) return;
+
+            size_t c = std::upper_bound(commands.begin(), commands.end(), first,
+                [](size_t index, const CommandRef& ref) { return index < ref.firstTriangle; }) - commands.begin() - 1;
+            for (size_t index = first; index < last; index++) {
+                while (index >= commands[c].firstTriangle + commands[c].command->indexCount / 3) c++;
+                const Mesh& mesh = *commands[c].mesh;
+                const Command& command = *commands[c].command;
+                const Index* indices = (const Index*)mesh.indices + command.firstIndex + (index - commands[c].firstTriangle) * 3;
+                const Vertex* const vertices[3] = {
+                    mesh.vertices + command.vertexOffset + indices[0],
+                    mesh.vertices + command.vertexOffset + indices[1],
+                    mesh.vertices + command.vertexOffset + indices[2],
+                };
+
+                Triangle t;
+                if (!SetupTriangle(vertices, command, transform, width, height, t)) continue;
+                const uint32_t slot = (uint32_t)chunk.triangles.size();
+                chunk.triangles.push_back(t);
+                const int firstX = t.x0 / TileSize, lastX = (t.x1 - 1) / TileSize, firstY = t.y0 / TileSize, lastY = (t.y1 - 1) / TileSize;
+                const bool single = firstX == lastX && firstY == lastY;
+                for (int ty = firstY; ty <= lastY; ty++) {
+                    for (int tx = firstX; tx <= lastX; tx++) {
+                        // thin diagonal triangles miss most tiles of their bounds
+                        if (!single && !TouchesRect(t, std::max(t.x0, tx * TileSize), std::max(t.y0, ty * TileSize),
+                            std::min(t.x1, (tx + 1) * TileSize), std::min(t.y1, (ty + 1) * TileSize))) continue;
+                        chunk.bins[ty * tilesX + tx].push_back(slot);
+                    }
+                }
+            }
+        }
+
+    public:
+        // threadCount 0 uses every core; 1 draws on the calling thread
+        explicit Rasterizer(unsigned threadCount = 0) {
+            if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+            if (threadCount > 1) pool = std::make_unique<ThreadPool>(threadCount);
+        }
+
+        void Resize(int w, int h) {
+            width = std::max(0, w);
+            height = std::max(0, h);
+            tilesX = (width + TileSize - 1) / TileSize;
+            tilesY = (height + TileSize - 1) / TileSize;
+            pixels.assign((size_t)width * height * 4, 0);
+            for (Chunk& chunk : chunks) chunk.bins.assign((size_t)tilesX * tilesY, {});
+        }
+
+        // Clears to clearColor (straight RGBA, 0..1) and draws every command
+        // in order. All meshes must share one index size.
+        void Draw(const std::vector<Mesh>& meshes, const float clearColor[4], const Transform& transform = {}) {
+            const auto start = std::chrono::steady_clock::now();
+            stats = {};
+
+            commands.clear();
+            size_t triangleCount = 0;
+            int indexSize = 2;
+            for (const Mesh& mesh : meshes) {
+                if (!mesh.vertices || !mesh.indices) continue;
+                indexSize = mesh.indexSize;
+                for (const Command& command : mesh.commands) {
+                    if (command.indexCount < 3) continue;
+                    commands.push_back({ &mesh, &command, triangleCount });
+                    triangleCount += command.indexCount / 3;
+                }
+            }
+            stats.triangles = triangleCount;
+
+            // a few chunks per thread once there is enough to share out
+            const int threads = pool ? (int)pool->ThreadCount() : 1;
+            const int chunkCount = (int)std::clamp<size_t>(triangleCount / 512, 1, (size_t)threads * 4);
+            if ((int)chunks.size() < chunkCount) {
+                chunks.resize(chunkCount);
+                for (Chunk& chunk : chunks) chunk.bins.resize((size_t)tilesX * tilesY);
+            }
+            ForEach(chunkCount, [&](int i) {
+                const size_t first = triangleCount * i / chunkCount, last = triangleCount * (i + 1) / chunkCount;
+                if (indexSize == 4) SetupChunk<uint32_t>(chunks[i], first, last, transform);
+                else SetupChunk<uint16_t>(chunks[i], first, last, transform);
+            });
+            for (int i = 0; i < chunkCount; i++) {
+                stats.drawn += chunks[i].triangles.size();
+                for (const std::vector<uint32_t>& bin : chunks[i].bins) stats.binned += bin.size();
+            }
+            const auto setupEnd = std::chrono::steady_clock::now();
+
+            uint8_t clear[4];
+            for (int c = 0; c < 4; c++) clear[c] = (uint8_t)lrintf(std::clamp(clearColor[c], 0.0f, 1.0f) * 255.0f);
+            ForEach(tilesX * tilesY, [&](int tile) {
+                const int x0 = tile % tilesX * TileSize, y0 = tile / tilesX * TileSize;
+                const int x1 = std::min(width, x0 + TileSize), y1 = std::min(height, y0 + TileSize);
+                for (int y = y0; y < y1; y++) {
+                    uint8_t* row = pixels.data() + ((size_t)y * width + x0) * 4;
+                    for (int x = x0; x < x1; x++, row += 4) memcpy(row, clear, 4);
+                }
+                for (int i = 0; i < chunkCount; i++) {
+                    for (uint32_t slot : chunks[i].bins[tile]) {
+                        const Triangle& t = chunks[i].triangles[slot];
+                        DrawTriangle(t, std::max(x0, t.x0), std::max(y0, t.y0), std::min(x1, t.x1), std::min(y1, t.y1),
+                            pixels.data(), width * 4);
+                    }
+                }
+            });
+
+            const auto end = std::chrono::steady_clock::now();
+            stats.setupMs = std::chrono::duration<double, std::milli>(setupEnd - start).count();
+            stats.rasterMs = std::chrono::duration<double, std::milli>(end - setupEnd).count();
+        }
+
+        int Width() const { return width; }
+        int Height() const { return height; }
+        const uint8_t* Pixels() const { return pixels.data(); }
+        const Stats& LastStats() const { return stats; }
+        unsigned ThreadCount() const { return pool ? pool->ThreadCount() : 1; }
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "imgui.h"
+#include "draw_fingerprint.h"
+#include "platform.h"
+#include "soft_raster.h"
+#include "texture_loader.h"
+
+// IRenderer that draws ImGui's draw data into memory with SoftRaster
+//
+// Consumes ImGui::GetDrawData() the way the D3D11 backend does: the same
+// scissor rects, blend states and callbacks, with textures sampled from
+// their top mip. Nothing is presented; Pixels() holds the last frame as
+// tightly packed RGBA8. Runs without a GPU, so it works in CI, in remote
+// or virtual sessions, and as a reference for pixel comparisons. A frame
+// whose DrawFingerprint matches the last one is not rasterized again.
+class SoftwareRenderer : public IRenderer {
+    static_assert(sizeof(ImDrawVert) == sizeof(SoftRaster::Vertex) && offsetof(ImDrawVert, col) == offsetof(SoftRaster::Vertex, col),
+        "SoftRaster::Vertex must match ImDrawVert");
+
+    SoftRaster::Rasterizer raster;
+    SoftRaster::Texture fontTexture;
+    std::vector<SoftRaster::Mesh> meshes;
+    DrawFingerprint fingerprint;
+    uint64_t textureEpoch{ 0 };
+    size_t liveTextures{ 0 };
+
+    // Marks where premultiplied blending starts, like the D3D11 renderer's
+    // callback; Render() reads it back out of the command list
+    static void SetPremultipliedBlend(const ImDrawList*, const ImDrawCmd*) {}
+
+public:
+    // threadCount 0 uses every core; the rasterizer has its own pool, so
+    // frames never wait behind texture loads
+    explicit SoftwareRenderer(unsigned threadCount = 0) : raster(threadCount) {}
+
+    bool Initialize(IPlatform& platform) override {
+        ImGuiIO& io = ImGui::GetIO();
+        io.BackendRendererName = "software";
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        const WindowRect rect = platform.GetWindowRect();
+        raster.Resize(rect.width, rect.height);
+        return true;
+    }
+
+    void Shutdown() override {}
+
+    void NewFrame() override {
+        ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+        if (fonts->IsBuilt() && fonts->TexID) return;
+        unsigned char* pixels = nullptr;
+        fonts->GetTexDataAsRGBA32(&pixels, &fontTexture.width, &fontTexture.height);
+        fontTexture.rgba.assign(pixels, pixels + (size_t)fontTexture.width * fontTexture.height * 4);
+        fonts->SetTexID((ImTextureID)&fontTexture);
+        textureEpoch++;
+    }
+
+    void Render(const ImVec4& clearColor) override {
+        const ImDrawData* data = ImGui::GetDrawData();
+        if (fingerprint.Unchanged(data, HashBytes(&clearColor, sizeof(clearColor), textureEpoch))) return;
+
+        const float clear[4] = { clearColor.x, clearColor.y, clearColor.z, clearColor.w };
+        meshes.resize(data ? data->CmdListsCount : 0);
+        for (size_t i = 0; i < meshes.size(); i++) {
+            const ImDrawList* list = data->CmdLists[(int)i];
+            SoftRaster::Mesh& mesh = meshes[i];
+            mesh.vertices = (const SoftRaster::Vertex*)list->VtxBuffer.Data;
+            mesh.indices = list->IdxBuffer.Data;
+            mesh.indexSize = (int)sizeof(ImDrawIdx);
+            mesh.commands.clear();
+
+            SoftRaster::Blend blend = SoftRaster::Blend::Alpha;
+            for (const ImDrawCmd& cmd : list->CmdBuffer) {
+                if (cmd.UserCallback == ImDrawCallback_ResetRenderState) blend = SoftRaster::Blend::Alpha;
+                else if (cmd.UserCallback == SetPremultipliedBlend) blend = SoftRaster::Blend::Premultiplied;
+                else if (cmd.UserCallback) cmd.UserCallback(list, &cmd);
+                if (cmd.UserCallback) continue;
+                if (cmd.ClipRect.z <= cmd.ClipRect.x || cmd.ClipRect.w <= cmd.ClipRect.y) continue;
+                mesh.commands.push_back({ { cmd.ClipRect.x, cmd.ClipRect.y, cmd.ClipRect.z, cmd.ClipRect.w },
+                    (const SoftRaster::Texture*)cmd.GetTexID(), cmd.IdxOffset, cmd.ElemCount, cmd.VtxOffset, blend });
+            }
+        }
+
+        SoftRaster::Transform transform;
+        if (data) {
+            transform.offsetX = -data->DisplayPos.x;
+            transform.offsetY = -data->DisplayPos.y;
+        }
+        raster.Draw(meshes, clear, transform);
+    }
+
+    void Resize(int width, int height) override {
+        raster.Resize(width, height);
+        fingerprint.Invalidate();
+    }
+
+    // BcEncoder only decodes the BC7 mode it writes itself
+    bool SupportsBC7() const override { return false; }
+
+    // Keeps the top mip as RGBA8, decoding block formats and sRGB the way
+    // a GPU sampler would hand them to the shader
+    void* CreateTexture(const TextureLoader::Prepared& prepared) override {
+        SoftRaster::Texture* texture = new SoftRaster::Texture;
+        if (!TextureLoader::DecodeTopLevel(prepared, texture->rgba, texture->width, texture->height)) {
+            delete texture;
+            return nullptr;
+        }
+        liveTextures++;
+        textureEpoch++;
+        return texture;
+    }
+
+    void ReleaseTexture(void* texture) override {
+        liveTextures--;
+        textureEpoch++;
+        delete (SoftRaster::Texture*)texture;
+    }
+
+    void AddImagePremultiplied(ImDrawList* drawList, void* texture, const ImVec2& min, const ImVec2& max,
+        const ImVec2& uvMin, const ImVec2& uvMax, float alpha) override {
+        const int a = (int)(255 * alpha);
+        drawList->AddCallback(SetPremultipliedBlend, nullptr);
+        drawList->AddImage(texture, min, max, uvMin, uvMax, IM_COL32(a, a, a, a));
+        drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+    }
+
+    const uint8_t* Pixels() const { return raster.Pixels(); }
+    int Width() const { return raster.Width(); }
+    int Height() const { return raster.Height(); }
+    const SoftRaster::Stats& LastStats() const { return raster.LastStats(); }
+    const DrawFingerprint::Stats& FingerprintStats() const { return fingerprint.GetStats(); }
+    size_t LiveTextures() const { return liveTextures; }
+};
@@ -145,6 +145,79 @@ extern "C" {
     STBIDEF char* stbi_zlib_decode_noheader_malloc(const char* buffer, int len, int* outlen);
     STBIDEF int   stbi_zlib_decode_noheader_buffer(char* obuffer, int olen, const char* ibuffer, int ilen);
 
+    // Per-decode allocators
+    //
+    // STBI_MALLOC/STBI_FREE are global; the *_with_allocator entry points route
+    // every allocation made during that one decode (huffman tables, IDAT and
+    // row buffers, the output image) through 'alloc' instead. the returned
+    // image belongs to 'alloc' and must be released through it, NOT with
+    // stbi_image_free. alloc->realloc may be NULL, in which case alloc+copy+free
+    // is used.
+
+    typedef struct
+    {
+        void* (*alloc)  (void* user, size_t size);
+        void* (*realloc)(void* user, void* p, size_t oldsize, size_t newsize);
+        void  (*free)   (void* user, void* p);
+        void* user;
+    } stbi_allocator;
+
+    STBIDEF stbi_uc* stbi_load_from_memory_with_allocator(stbi_uc const* buffer, int len, int* x, int* y, int* channels_in_file, int desired_channels, stbi_allocator const* alloc);
+#ifndef STBI_NO_STDIO
+    STBIDEF stbi_uc* stbi_load_with_allocator(char const* filename, int* x, int* y, int* channels_in_file, int desired_channels, stbi_allocator const* alloc);
+#endif
+
+    // bump arena: every allocation is a pointer bump, free is a no-op (except
+    // for the most recent block, which is popped), and stbi_arena_reset drops a
+    // whole decode's memory at once. when a decode overflows the arena, extra
+    // blocks are chained from STBI_MALLOC; the next reset coalesces them into
+    // a single block so a steady-state loop does no heap traffic at all.
+    typedef struct stbi__arena_block stbi__arena_block;
+
+    typedef struct
+    {
+        stbi__arena_block* head;   // current block, older blocks chained behind it
+        size_t             total;  // capacity over all blocks
+        size_t             used;   // bytes handed out since the last reset
+        size_t             peak;   // high-water mark of 'used'
+    } stbi_arena;
+
+    STBIDEF void           stbi_arena_init(stbi_arena* arena, size_t initial_size);
+    STBIDEF void           stbi_arena_reset(stbi_arena* arena);
+    STBIDEF void           stbi_arena_release(stbi_arena* arena);
+    STBIDEF stbi_allocator stbi_arena_allocator(stbi_arena* arena);
+
+    // allocation counters for the most recent decode on the calling thread.
+    // 'allocs' counts requests made by the decoder; 'heap_allocs' counts the
+    // ones that actually reached STBI_MALLOC/STBI_REALLOC.
+    typedef struct
+    {
+        unsigned int allocs;
+        unsigned int reallocs;
+        unsigned int frees;
+        unsigned int heap_allocs;
+        size_t       bytes;
+    } stbi_alloc_stats;
+
+    STBIDEF void stbi_get_decode_alloc_stats(stbi_alloc_stats* stats);
+
+    // Reusable decoders
+    //
+    // a decoder keeps its scratch arena (grown to the largest image seen so
+    // far) and precomputed static tables across calls, so batch-loading many
+    // small images pays setup cost once. the returned pixels are owned by the
+    // decoder and stay valid until the next load on it or stbi_decoder_destroy;
+    // copy or upload them, do not stbi_image_free them. a decoder must only be
+    // used by one thread at a time.
+    typedef struct stbi__decoder stbi_decoder;
+
+    STBIDEF stbi_decoder* stbi_decoder_create(size_t scratch_size);
+    STBIDEF void          stbi_decoder_destroy(stbi_decoder* decoder);
+    STBIDEF stbi_uc*      stbi_decoder_load_from_memory(stbi_decoder* decoder, stbi_uc const* buffer, int len, int* x, int* y, int* channels_in_file, int desired_channels);
+#ifndef STBI_NO_STDIO
+    STBIDEF stbi_uc*      stbi_decoder_load(stbi_decoder* decoder, char const* filename, int* x, int* y, int* channels_in_file, int desired_channels);
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -160,7 +233,7 @@ extern "C" {
 #if defined(STBI_ONLY_JPEG) || defined(STBI_ONLY_PNG) || defined(STBI_ONLY_BMP) \
   || defined(STBI_ONLY_TGA) || defined(STBI_ONLY_GIF) || defined(STBI_ONLY_PSD) \
   || defined(STBI_ONLY_HDR) || defined(STBI_ONLY_PIC) || defined(STBI_ONLY_PNM) \
-  || defined(STBI_ONLY_ZLIB)
+  || defined(STBI_ONLY_QOI) || defined(STBI_ONLY_ZLIB)
 #ifndef STBI_ONLY_JPEG
 #define STBI_NO_JPEG
 #endif
@@ -188,6 +261,9 @@ extern "C" {
 #ifndef STBI_ONLY_PNM
 #define STBI_NO_PNM
 #endif
+#ifndef STBI_ONLY_QOI
+#define STBI_NO_QOI
+#endif
 #endif
 
 #if defined(STBI_NO_PNG) && !defined(STBI_SUPPORT_ZLIB) && !defined(STBI_NO_ZLIB)
@@ -558,6 +634,12 @@ static int      stbi__pnm_info(stbi__context* s, int* x, int* y, int* comp);
 static int      stbi__pnm_is16(stbi__context* s);
 #endif
 
+#ifndef STBI_NO_QOI
+static int      stbi__qoi_test(stbi__context* s);
+static void* stbi__qoi_load(stbi__context* s, int* x, int* y, int* comp, int req_comp, stbi__result_info* ri);
+static int      stbi__qoi_info(stbi__context* s, int* x, int* y, int* comp);
+#endif
+
 static
 #ifdef STBI_THREAD_LOCAL
 STBI_THREAD_LOCAL
@@ -577,11 +659,70 @@ static int stbi__err(const char* str)
 }
 #endif
 
+// allocator for the decode in flight on this thread; NULL means STBI_MALLOC
+static
+#ifdef STBI_THREAD_LOCAL
+STBI_THREAD_LOCAL
+#endif
+const stbi_allocator* stbi__g_allocator;
+
+static
+#ifdef STBI_THREAD_LOCAL
+STBI_THREAD_LOCAL
+#endif
+stbi_alloc_stats stbi__g_alloc_stats;
+
+static void stbi__begin_decode(void)
+{
+    memset(&stbi__g_alloc_stats, 0, sizeof(stbi__g_alloc_stats));
+}
+
+STBIDEF void stbi_get_decode_alloc_stats(stbi_alloc_stats* stats)
+{
+    *stats = stbi__g_alloc_stats;
+}
+
 static void* stbi__malloc(size_t size)
 {
+    ++stbi__g_alloc_stats.allocs;
+    stbi__g_alloc_stats.bytes += size;
+    if (stbi__g_allocator)
+        return stbi__g_allocator->alloc(stbi__g_allocator->user, size);
+    ++stbi__g_alloc_stats.heap_allocs;
     return STBI_MALLOC(size);
 }
 
+static void stbi__free(void* p)
+{
+    if (p == NULL) return;
+    ++stbi__g_alloc_stats.frees;
+    if (stbi__g_allocator)
+        stbi__g_allocator->free(stbi__g_allocator->user, p);
+    else
+        STBI_FREE(p);
+}
+
+static void* stbi__realloc_sized(void* p, size_t oldsz, size_t newsz)
+{
+    ++stbi__g_alloc_stats.reallocs;
+    if (newsz > oldsz) stbi__g_alloc_stats.bytes += newsz - oldsz;
+    if (stbi__g_allocator) {
+        const stbi_allocator* a = stbi__g_allocator;
+        void* q;
+        if (a->realloc) return a->realloc(a->user, p, oldsz, newsz);
+        q = a->alloc(a->user, newsz);
+        if (q == NULL) return NULL;
+        if (p) {
+            memcpy(q, p, oldsz < newsz ? oldsz : newsz);
+            a->free(a->user, p);
+        }
+        return q;
+    }
+    ++stbi__g_alloc_stats.heap_allocs;
+    STBI_NOTUSED(oldsz);
+    return STBI_REALLOC_SIZED(p, oldsz, newsz);
+}
+
 // stb_image uses ints pervasively, including for offset calculations.
 // therefore the largest decoded image size we can support with the
 // current code, even on 64-bit targets, is INT_MAX. this is not a
@@ -614,7 +755,7 @@ static int stbi__mul2sizes_valid(int a, int b)
     return a <= INT_MAX / b;
 }
 
-#if !defined(STBI_NO_JPEG) || !defined(STBI_NO_PNG) || !defined(STBI_NO_TGA) || !defined(STBI_NO_HDR)
+#if !defined(STBI_NO_JPEG) || !defined(STBI_NO_PNG) || !defined(STBI_NO_TGA) || !defined(STBI_NO_HDR) || !defined(STBI_NO_QOI)
 // returns 1 if "a*b + add" has no negative terms/factors and doesn't overflow
 static int stbi__mad2sizes_valid(int a, int b, int add)
 {
@@ -638,7 +779,7 @@ static int stbi__mad4sizes_valid(int a, int b, int c, int d, int add)
 }
 #endif
 
-#if !defined(STBI_NO_JPEG) || !defined(STBI_NO_PNG) || !defined(STBI_NO_TGA) || !defined(STBI_NO_HDR)
+#if !defined(STBI_NO_JPEG) || !defined(STBI_NO_PNG) || !defined(STBI_NO_TGA) || !defined(STBI_NO_HDR) || !defined(STBI_NO_QOI)
 // mallocs with size overflow checking
 static void* stbi__malloc_mad2(int a, int b, int add)
 {
@@ -755,6 +896,9 @@ static void* stbi__load_main(stbi__context* s, int* x, int* y, int* comp, int re
 #ifndef STBI_NO_PIC
     if (stbi__pic_test(s))  return stbi__pic_load(s, x, y, comp, req_comp, ri);
 #endif
+#ifndef STBI_NO_QOI
+    if (stbi__qoi_test(s))  return stbi__qoi_load(s, x, y, comp, req_comp, ri);
+#endif
 
     // then the formats that can end up attempting to load with just 1 or 2
     // bytes matching expectations; these are prone to false positives, so
@@ -794,7 +938,7 @@ static stbi_uc* stbi__convert_16_to_8(stbi__uint16* orig, int w, int h, int chan
     for (i = 0; i < img_len; ++i)
         reduced[i] = (stbi_uc)((orig[i] >> 8) & 0xFF); // top half of each byte is sufficient approx of 16->8 bit scaling
 
-    STBI_FREE(orig);
+    stbi__free(orig);
     return reduced;
 }
 
@@ -810,7 +954,7 @@ static stbi__uint16* stbi__convert_8_to_16(stbi_uc* orig, int w, int h, int chan
     for (i = 0; i < img_len; ++i)
         enlarged[i] = (stbi__uint16)((orig[i] << 8) + orig[i]); // replicate to high and low byte, maps 0->0, 255->0xffff
 
-    STBI_FREE(orig);
+    stbi__free(orig);
     return enlarged;
 }
 
@@ -855,7 +999,9 @@ static void stbi__vertical_flip_slices(void* image, int w, int h, int z, int byt
 static unsigned char* stbi__load_and_postprocess_8bit(stbi__context* s, int* x, int* y, int* comp, int req_comp)
 {
     stbi__result_info ri;
-    void* result = stbi__load_main(s, x, y, comp, req_comp, &ri, 8);
+    void* result;
+    stbi__begin_decode();
+    result = stbi__load_main(s, x, y, comp, req_comp, &ri, 8);
 
     if (result == NULL)
         return NULL;
@@ -881,7 +1027,9 @@ static unsigned char* stbi__load_and_postprocess_8bit(stbi__context* s, int* x,
 static stbi__uint16* stbi__load_and_postprocess_16bit(stbi__context* s, int* x, int* y, int* comp, int req_comp)
 {
     stbi__result_info ri;
-    void* result = stbi__load_main(s, x, y, comp, req_comp, &ri, 16);
+    void* result;
+    stbi__begin_decode();
+    result = stbi__load_main(s, x, y, comp, req_comp, &ri, 16);
 
     if (result == NULL)
         return NULL;
@@ -1035,6 +1183,171 @@ STBIDEF stbi_uc* stbi_load_from_callbacks(stbi_io_callbacks const* clbk, void* u
     return stbi__load_and_postprocess_8bit(&s, x, y, comp, req_comp);
 }
 
+STBIDEF stbi_uc* stbi_load_from_memory_with_allocator(stbi_uc const* buffer, int len, int* x, int* y, int* comp, int req_comp, stbi_allocator const* alloc)
+{
+    const stbi_allocator* prev = stbi__g_allocator;
+    stbi_uc* result;
+    stbi__context s;
+    stbi__start_mem(&s, buffer, len);
+    stbi__g_allocator = alloc;
+    result = stbi__load_and_postprocess_8bit(&s, x, y, comp, req_comp);
+    stbi__g_allocator = prev;
+    return result;
+}
+
+#ifndef STBI_NO_STDIO
+STBIDEF stbi_uc* stbi_load_with_allocator(char const* filename, int* x, int* y, int* comp, int req_comp, stbi_allocator const* alloc)
+{
+    const stbi_allocator* prev = stbi__g_allocator;
+    FILE* f = stbi__fopen(filename, "rb");
+    stbi_uc* result;
+    stbi__context s;
+    if (!f) return stbi__errpuc("can't fopen", "Unable to open file");
+    stbi__start_file(&s, f);
+    stbi__g_allocator = alloc;
+    result = stbi__load_and_postprocess_8bit(&s, x, y, comp, req_comp);
+    stbi__g_allocator = prev;
+    fclose(f);
+    return result;
+}
+#endif
+
+// arena blocks are chained newest-first; each allocation carries a 16-byte
+// header holding its rounded size so realloc and pop-free don't need oldsize
+struct stbi__arena_block
+{
+    stbi__arena_block* prev;
+    size_t size;
+    size_t used;
+};
+
+#define STBI__ARENA_ALIGN(n)   (((n) + 15) & ~(size_t)15)
+#define STBI__ARENA_HEADER     16
+#define STBI__ARENA_DATA(b)    ((stbi_uc*)(b) + STBI__ARENA_ALIGN(sizeof(stbi__arena_block)))
+
+static stbi__arena_block* stbi__arena_new_block(stbi__arena_block* prev, size_t size)
+{
+    stbi__arena_block* b = (stbi__arena_block*)STBI_MALLOC(STBI__ARENA_ALIGN(sizeof(stbi__arena_block)) + size);
+    if (b == NULL) return NULL;
+    ++stbi__g_alloc_stats.heap_allocs;
+    b->prev = prev;
+    b->size = size;
+    b->used = 0;
+    return b;
+}
+
+static void* stbi__arena_alloc(void* user, size_t size)
+{
+    stbi_arena* a = (stbi_arena*)user;
+    size_t need = STBI__ARENA_HEADER + STBI__ARENA_ALIGN(size);
+    stbi_uc* p;
+    if (a->head == NULL || a->head->used + need > a->head->size) {
+        size_t grow = a->head ? a->head->size * 2 : 64 * 1024;
+        stbi__arena_block* b;
+        if (grow < need) grow = STBI__ARENA_ALIGN(need);
+        b = stbi__arena_new_block(a->head, grow);
+        if (b == NULL) return NULL;
+        a->head = b;
+        a->total += grow;
+    }
+    p = STBI__ARENA_DATA(a->head) + a->head->used;
+    *(size_t*)p = need;
+    a->head->used += need;
+    a->used += need;
+    if (a->used > a->peak) a->peak = a->used;
+    return p + STBI__ARENA_HEADER;
+}
+
+static int stbi__arena_is_last(stbi_arena* a, stbi_uc* hdr)
+{
+    return a->head && hdr + *(size_t*)hdr == STBI__ARENA_DATA(a->head) + a->head->used;
+}
+
+static void stbi__arena_free(void* user, void* p)
+{
+    stbi_arena* a = (stbi_arena*)user;
+    stbi_uc* hdr = (stbi_uc*)p - STBI__ARENA_HEADER;
+    // only the most recent allocation can be returned; the rest waits for reset
+    if (stbi__arena_is_last(a, hdr)) {
+        size_t sz = *(size_t*)hdr;
+        a->head->used -= sz;
+        a->used -= sz;
+    }
+}
+
+static void* stbi__arena_realloc(void* user, void* p, size_t oldsize, size_t newsize)
+{
+    stbi_arena* a = (stbi_arena*)user;
+    stbi_uc* hdr;
+    size_t have, need;
+    void* q;
+    STBI_NOTUSED(oldsize);
+    if (p == NULL) return stbi__arena_alloc(user, newsize);
+    hdr = (stbi_uc*)p - STBI__ARENA_HEADER;
+    have = *(size_t*)hdr;
+    need = STBI__ARENA_HEADER + STBI__ARENA_ALIGN(newsize);
+    if (need <= have) return p;
+    // growing the newest allocation in place is the common case (zlib output, IDAT)
+    if (stbi__arena_is_last(a, hdr) && a->head->used - have + need <= a->head->size) {
+        a->head->used += need - have;
+        a->used += need - have;
+        if (a->used > a->peak) a->peak = a->used;
+        *(size_t*)hdr = need;
+        return p;
+    }
+    q = stbi__arena_alloc(user, newsize);
+    if (q == NULL) return NULL;
+    memcpy(q, p, have - STBI__ARENA_HEADER);
+    return q;
+}
+
+STBIDEF void stbi_arena_init(stbi_arena* arena, size_t initial_size)
+{
+    memset(arena, 0, sizeof(*arena));
+    if (initial_size) {
+        arena->head = stbi__arena_new_block(NULL, STBI__ARENA_ALIGN(initial_size));
+        if (arena->head) arena->total = arena->head->size;
+    }
+}
+
+STBIDEF void stbi_arena_reset(stbi_arena* arena)
+{
+    if (arena->head && arena->head->prev) {
+        // coalesce so the next decode of the same size fits in one block
+        size_t total = arena->total;
+        stbi_arena_release(arena);
+        arena->head = stbi__arena_new_block(NULL, total);
+        if (arena->head) arena->total = total;
+    }
+    else if (arena->head) {
+        arena->head->used = 0;
+    }
+    arena->used = 0;
+}
+
+STBIDEF void stbi_arena_release(stbi_arena* arena)
+{
+    stbi__arena_block* b = arena->head;
+    while (b) {
+        stbi__arena_block* prev = b->prev;
+        STBI_FREE(b);
+        b = prev;
+    }
+    arena->head = NULL;
+    arena->total = 0;
+    arena->used = 0;
+}
+
+STBIDEF stbi_allocator stbi_arena_allocator(stbi_arena* arena)
+{
+    stbi_allocator a;
+    a.alloc = stbi__arena_alloc;
+    a.realloc = stbi__arena_realloc;
+    a.free = stbi__arena_free;
+    a.user = arena;
+    return a;
+}
+
 #ifndef STBI_NO_GIF
 STBIDEF stbi_uc* stbi_load_gif_from_memory(stbi_uc const* buffer, int len, int** delays, int* x, int* y, int* z, int* comp, int req_comp)
 {
@@ -1055,6 +1368,7 @@ STBIDEF stbi_uc* stbi_load_gif_from_memory(stbi_uc const* buffer, int len, int**
 static float* stbi__loadf_main(stbi__context* s, int* x, int* y, int* comp, int req_comp)
 {
     unsigned char* data;
+    stbi__begin_decode();
 #ifndef STBI_NO_HDR
     if (stbi__hdr_test(s)) {
         stbi__result_info ri;
@@ -1234,7 +1548,7 @@ stbi_inline static int stbi__at_eof(stbi__context* s)
 }
 #endif
 
-#if defined(STBI_NO_JPEG) && defined(STBI_NO_PNG) && defined(STBI_NO_BMP) && defined(STBI_NO_PSD) && defined(STBI_NO_TGA) && defined(STBI_NO_GIF) && defined(STBI_NO_PIC)
+#if defined(STBI_NO_JPEG) && defined(STBI_NO_PNG) && defined(STBI_NO_BMP) && defined(STBI_NO_PSD) && defined(STBI_NO_TGA) && defined(STBI_NO_GIF) && defined(STBI_NO_PIC) && defined(STBI_NO_QOI)
 // nothing
 #else
 static void stbi__skip(stbi__context* s, int n)
@@ -1285,7 +1599,7 @@ static int stbi__getn(stbi__context* s, stbi_uc* buffer, int n)
 }
 #endif
 
-#if defined(STBI_NO_JPEG) && defined(STBI_NO_PNG) && defined(STBI_NO_PSD) && defined(STBI_NO_PIC)
+#if defined(STBI_NO_JPEG) && defined(STBI_NO_PNG) && defined(STBI_NO_PSD) && defined(STBI_NO_PIC) && defined(STBI_NO_QOI)
 // nothing
 #else
 static int stbi__get16be(stbi__context* s)
@@ -1295,7 +1609,7 @@ static int stbi__get16be(stbi__context* s)
 }
 #endif
 
-#if defined(STBI_NO_PNG) && defined(STBI_NO_PSD) && defined(STBI_NO_PIC)
+#if defined(STBI_NO_PNG) && defined(STBI_NO_PSD) && defined(STBI_NO_PIC) && defined(STBI_NO_QOI)
 // nothing
 #else
 static stbi__uint32 stbi__get32be(stbi__context* s)
@@ -1326,7 +1640,7 @@ static stbi__uint32 stbi__get32le(stbi__context* s)
 
 #define STBI__BYTECAST(x)  ((stbi_uc) ((x) & 255))  // truncate int to byte without warnings
 
-#if defined(STBI_NO_JPEG) && defined(STBI_NO_PNG) && defined(STBI_NO_BMP) && defined(STBI_NO_PSD) && defined(STBI_NO_TGA) && defined(STBI_NO_GIF) && defined(STBI_NO_PIC) && defined(STBI_NO_PNM)
+#if defined(STBI_NO_JPEG) && defined(STBI_NO_PNG) && defined(STBI_NO_BMP) && defined(STBI_NO_PSD) && defined(STBI_NO_TGA) && defined(STBI_NO_GIF) && defined(STBI_NO_PIC) && defined(STBI_NO_PNM) && defined(STBI_NO_QOI)
 // nothing
 #else
 //////////////////////////////////////////////////////////////////////////////
@@ -1346,7 +1660,7 @@ static stbi_uc stbi__compute_y(int r, int g, int b)
 }
 #endif
 
-#if defined(STBI_NO_PNG) && defined(STBI_NO_BMP) && defined(STBI_NO_PSD) && defined(STBI_NO_TGA) && defined(STBI_NO_GIF) && defined(STBI_NO_PIC) && defined(STBI_NO_PNM)
+#if defined(STBI_NO_PNG) && defined(STBI_NO_BMP) && defined(STBI_NO_PSD) && defined(STBI_NO_TGA) && defined(STBI_NO_GIF) && defined(STBI_NO_PIC) && defined(STBI_NO_PNM) && defined(STBI_NO_QOI)
 // nothing
 #else
 static unsigned char* stbi__convert_format(unsigned char* data, int img_n, int req_comp, unsigned int x, unsigned int y)
@@ -1359,7 +1673,7 @@ static unsigned char* stbi__convert_format(unsigned char* data, int img_n, int r
 
     good = (unsigned char*)stbi__malloc_mad3(req_comp, x, y, 0);
     if (good == NULL) {
-        STBI_FREE(data);
+        stbi__free(data);
         return stbi__errpuc("outofmem", "Out of memory");
     }
 
@@ -1384,12 +1698,12 @@ static unsigned char* stbi__convert_format(unsigned char* data, int img_n, int r
             STBI__CASE(4, 1) { dest[0] = stbi__compute_y(src[0], src[1], src[2]); } break;
             STBI__CASE(4, 2) { dest[0] = stbi__compute_y(src[0], src[1], src[2]); dest[1] = src[3]; } break;
             STBI__CASE(4, 3) { dest[0] = src[0]; dest[1] = src[1]; dest[2] = src[2]; } break;
-        default: STBI_ASSERT(0); STBI_FREE(data); STBI_FREE(good); return stbi__errpuc("unsupported", "Unsupported format conversion");
+        default: STBI_ASSERT(0); stbi__free(data); stbi__free(good); return stbi__errpuc("unsupported", "Unsupported format conversion");
         }
 #undef STBI__CASE
     }
 
-    STBI_FREE(data);
+    stbi__free(data);
     return good;
 }
 #endif
@@ -1416,7 +1730,7 @@ static stbi__uint16* stbi__convert_format16(stbi__uint16* data, int img_n, int r
 
     good = (stbi__uint16*)stbi__malloc(req_comp * x * y * 2);
     if (good == NULL) {
-        STBI_FREE(data);
+        stbi__free(data);
         return (stbi__uint16*)stbi__errpuc("outofmem", "Out of memory");
     }
 
@@ -1441,12 +1755,12 @@ static stbi__uint16* stbi__convert_format16(stbi__uint16* data, int img_n, int r
             STBI__CASE(4, 1) { dest[0] = stbi__compute_y_16(src[0], src[1], src[2]); } break;
             STBI__CASE(4, 2) { dest[0] = stbi__compute_y_16(src[0], src[1], src[2]); dest[1] = src[3]; } break;
             STBI__CASE(4, 3) { dest[0] = src[0]; dest[1] = src[1]; dest[2] = src[2]; } break;
-        default: STBI_ASSERT(0); STBI_FREE(data); STBI_FREE(good); return (stbi__uint16*)stbi__errpuc("unsupported", "Unsupported format conversion");
+        default: STBI_ASSERT(0); stbi__free(data); stbi__free(good); return (stbi__uint16*)stbi__errpuc("unsupported", "Unsupported format conversion");
         }
 #undef STBI__CASE
     }
 
-    STBI_FREE(data);
+    stbi__free(data);
     return good;
 }
 #endif
@@ -1458,7 +1772,7 @@ static float* stbi__ldr_to_hdr(stbi_uc* data, int x, int y, int comp)
     float* output;
     if (!data) return NULL;
     output = (float*)stbi__malloc_mad4(x, y, comp, sizeof(float), 0);
-    if (output == NULL) { STBI_FREE(data); return stbi__errpf("outofmem", "Out of memory"); }
+    if (output == NULL) { stbi__free(data); return stbi__errpf("outofmem", "Out of memory"); }
     // compute number of non-alpha components
     if (comp & 1) n = comp; else n = comp - 1;
     for (i = 0; i < x * y; ++i) {
@@ -1471,7 +1785,7 @@ static float* stbi__ldr_to_hdr(stbi_uc* data, int x, int y, int comp)
             output[i * comp + n] = data[i * comp + n] / 255.0f;
         }
     }
-    STBI_FREE(data);
+    stbi__free(data);
     return output;
 }
 #endif
@@ -1484,7 +1798,7 @@ static stbi_uc* stbi__hdr_to_ldr(float* data, int x, int y, int comp)
     stbi_uc* output;
     if (!data) return NULL;
     output = (stbi_uc*)stbi__malloc_mad3(x, y, comp, 0);
-    if (output == NULL) { STBI_FREE(data); return stbi__errpuc("outofmem", "Out of memory"); }
+    if (output == NULL) { stbi__free(data); return stbi__errpuc("outofmem", "Out of memory"); }
     // compute number of non-alpha components
     if (comp & 1) n = comp; else n = comp - 1;
     for (i = 0; i < x * y; ++i) {
@@ -1501,7 +1815,7 @@ static stbi_uc* stbi__hdr_to_ldr(float* data, int x, int y, int comp)
             output[i * comp + k] = (stbi_uc)stbi__float2int(z);
         }
     }
-    STBI_FREE(data);
+    stbi__free(data);
     return output;
 }
 #endif
@@ -2859,17 +3173,17 @@ static int stbi__free_jpeg_components(stbi__jpeg* z, int ncomp, int why)
     int i;
     for (i = 0; i < ncomp; ++i) {
         if (z->img_comp[i].raw_data) {
-            STBI_FREE(z->img_comp[i].raw_data);
+            stbi__free(z->img_comp[i].raw_data);
             z->img_comp[i].raw_data = NULL;
             z->img_comp[i].data = NULL;
         }
         if (z->img_comp[i].raw_coeff) {
-            STBI_FREE(z->img_comp[i].raw_coeff);
+            stbi__free(z->img_comp[i].raw_coeff);
             z->img_comp[i].raw_coeff = 0;
             z->img_comp[i].coeff = 0;
         }
         if (z->img_comp[i].linebuf) {
-            STBI_FREE(z->img_comp[i].linebuf);
+            stbi__free(z->img_comp[i].linebuf);
             z->img_comp[i].linebuf = NULL;
         }
     }
@@ -3661,7 +3975,7 @@ static void* stbi__jpeg_load(stbi__context* s, int* x, int* y, int* comp, int re
     j->s = s;
     stbi__setup_jpeg(j);
     result = load_jpeg_image(j, x, y, comp, req_comp);
-    STBI_FREE(j);
+    stbi__free(j);
     return result;
 }
 
@@ -3675,7 +3989,7 @@ static int stbi__jpeg_test(stbi__context* s)
     stbi__setup_jpeg(j);
     r = stbi__decode_jpeg_header(j, STBI__SCAN_type);
     stbi__rewind(s);
-    STBI_FREE(j);
+    stbi__free(j);
     return r;
 }
 
@@ -3699,7 +4013,7 @@ static int stbi__jpeg_info(stbi__context* s, int* x, int* y, int* comp)
     memset(j, 0, sizeof(stbi__jpeg));
     j->s = s;
     result = stbi__jpeg_info_raw(j, x, y, comp);
-    STBI_FREE(j);
+    stbi__free(j);
     return result;
 }
 #endif
@@ -3911,7 +4225,7 @@ static int stbi__zexpand(stbi__zbuf* z, char* zout, int n)  // need to make room
         if (limit > UINT_MAX / 2) return stbi__err("outofmem", "Out of memory");
         limit *= 2;
     }
-    q = (char*)STBI_REALLOC_SIZED(z->zout_start, old_limit, limit);
+    q = (char*)stbi__realloc_sized(z->zout_start, old_limit, limit);
     STBI_NOTUSED(old_limit);
     if (q == NULL) return stbi__err("outofmem", "Out of memory");
     z->zout_start = q;
@@ -4111,6 +4425,18 @@ Init algorithm:
 }
 */
 
+// prebuilt fixed-code tables, set by stbi_decoder for the decode in flight
+typedef struct
+{
+    stbi__zhuffman length, distance;
+} stbi__zfixed;
+
+static
+#ifdef STBI_THREAD_LOCAL
+STBI_THREAD_LOCAL
+#endif
+const stbi__zfixed* stbi__g_zfixed;
+
 static int stbi__parse_zlib(stbi__zbuf* a, int parse_header)
 {
     int final, type;
@@ -4131,8 +4457,14 @@ static int stbi__parse_zlib(stbi__zbuf* a, int parse_header)
         else {
             if (type == 1) {
                 // use fixed code lengths
-                if (!stbi__zbuild_huffman(&a->z_length, stbi__zdefault_length, STBI__ZNSYMS)) return 0;
-                if (!stbi__zbuild_huffman(&a->z_distance, stbi__zdefault_distance, 32)) return 0;
+                if (stbi__g_zfixed) {
+                    a->z_length = stbi__g_zfixed->length;
+                    a->z_distance = stbi__g_zfixed->distance;
+                }
+                else {
+                    if (!stbi__zbuild_huffman(&a->z_length, stbi__zdefault_length, STBI__ZNSYMS)) return 0;
+                    if (!stbi__zbuild_huffman(&a->z_distance, stbi__zdefault_distance, 32)) return 0;
+                }
             }
             else {
                 if (!stbi__compute_huffman_codes(a)) return 0;
@@ -4165,7 +4497,7 @@ STBIDEF char* stbi_zlib_decode_malloc_guesssize(const char* buffer, int len, int
         return a.zout_start;
     }
     else {
-        STBI_FREE(a.zout_start);
+        stbi__free(a.zout_start);
         return NULL;
     }
 }
@@ -4187,7 +4519,7 @@ STBIDEF char* stbi_zlib_decode_malloc_guesssize_headerflag(const char* buffer, i
         return a.zout_start;
     }
     else {
-        STBI_FREE(a.zout_start);
+        stbi__free(a.zout_start);
         return NULL;
     }
 }
@@ -4215,7 +4547,7 @@ STBIDEF char* stbi_zlib_decode_noheader_malloc(char const* buffer, int len, int*
         return a.zout_start;
     }
     else {
-        STBI_FREE(a.zout_start);
+        stbi__free(a.zout_start);
         return NULL;
     }
 }
@@ -4498,7 +4830,7 @@ static int stbi__create_png_image_raw(stbi__png* a, stbi_uc* raw, stbi__uint32 r
         }
     }
 
-    STBI_FREE(filter_buf);
+    stbi__free(filter_buf);
     if (!all_ok) return 0;
 
     return 1;
@@ -4528,7 +4860,7 @@ static int stbi__create_png_image(stbi__png* a, stbi_uc* image_data, stbi__uint3
         if (x && y) {
             stbi__uint32 img_len = ((((a->s->img_n * x * depth) + 7) >> 3) + 1) * y;
             if (!stbi__create_png_image_raw(a, image_data, image_data_len, out_n, x, y, depth, color)) {
-                STBI_FREE(final);
+                stbi__free(final);
                 return 0;
             }
             for (j = 0; j < y; ++j) {
@@ -4539,7 +4871,7 @@ static int stbi__create_png_image(stbi__png* a, stbi_uc* image_data, stbi__uint3
                         a->out + (j * x + i) * out_bytes, out_bytes);
                 }
             }
-            STBI_FREE(a->out);
+            stbi__free(a->out);
             image_data += img_len;
             image_data_len -= img_len;
         }
@@ -4631,7 +4963,7 @@ static int stbi__expand_png_palette(stbi__png* a, stbi_uc* palette, int len, int
             p += 4;
         }
     }
-    STBI_FREE(a->out);
+    stbi__free(a->out);
     a->out = temp_out;
 
     STBI_NOTUSED(len);
@@ -4843,7 +5175,7 @@ static int stbi__parse_png_file(stbi__png* z, int scan, int req_comp)
                 while (ioff + c.length > idata_limit)
                     idata_limit *= 2;
                 STBI_NOTUSED(idata_limit_old);
-                p = (stbi_uc*)STBI_REALLOC_SIZED(z->idata, idata_limit_old, idata_limit); if (p == NULL) return stbi__err("outofmem", "Out of memory");
+                p = (stbi_uc*)stbi__realloc_sized(z->idata, idata_limit_old, idata_limit); if (p == NULL) return stbi__err("outofmem", "Out of memory");
                 z->idata = p;
             }
             if (!stbi__getn(s, z->idata + ioff, c.length)) return stbi__err("outofdata", "Corrupt PNG");
@@ -4861,7 +5193,7 @@ static int stbi__parse_png_file(stbi__png* z, int scan, int req_comp)
             raw_len = bpl * s->img_y * s->img_n /* pixels */ + s->img_y /* filter mode per row */;
             z->expanded = (stbi_uc*)stbi_zlib_decode_malloc_guesssize_headerflag((char*)z->idata, ioff, raw_len, (int*)&raw_len, !is_iphone);
             if (z->expanded == NULL) return 0; // zlib should set error
-            STBI_FREE(z->idata); z->idata = NULL;
+            stbi__free(z->idata); z->idata = NULL;
             if ((req_comp == s->img_n + 1 && req_comp != 3 && !pal_img_n) || has_trans)
                 s->img_out_n = s->img_n + 1;
             else
@@ -4889,7 +5221,7 @@ static int stbi__parse_png_file(stbi__png* z, int scan, int req_comp)
                 // non-paletted image with tRNS -> source image has (constant) alpha
                 ++s->img_n;
             }
-            STBI_FREE(z->expanded); z->expanded = NULL;
+            stbi__free(z->expanded); z->expanded = NULL;
             // end of PNG chunk, read and skip CRC
             stbi__get32be(s);
             return 1;
@@ -4942,9 +5274,9 @@ static void* stbi__do_png(stbi__png* p, int* x, int* y, int* n, int req_comp, st
         *y = p->s->img_y;
         if (n) *n = p->s->img_n;
     }
-    STBI_FREE(p->out);      p->out = NULL;
-    STBI_FREE(p->expanded); p->expanded = NULL;
-    STBI_FREE(p->idata);    p->idata = NULL;
+    stbi__free(p->out);      p->out = NULL;
+    stbi__free(p->expanded); p->expanded = NULL;
+    stbi__free(p->idata);    p->idata = NULL;
 
     return result;
 }
@@ -5263,7 +5595,7 @@ static void* stbi__bmp_load(stbi__context* s, int* x, int* y, int* comp, int req
     if (!out) return stbi__errpuc("outofmem", "Out of memory");
     if (info.bpp < 16) {
         int z = 0;
-        if (psize == 0 || psize > 256) { STBI_FREE(out); return stbi__errpuc("invalid", "Corrupt BMP"); }
+        if (psize == 0 || psize > 256) { stbi__free(out); return stbi__errpuc("invalid", "Corrupt BMP"); }
         for (i = 0; i < psize; ++i) {
             pal[i][2] = stbi__get8(s);
             pal[i][1] = stbi__get8(s);
@@ -5275,7 +5607,7 @@ static void* stbi__bmp_load(stbi__context* s, int* x, int* y, int* comp, int req
         if (info.bpp == 1) width = (s->img_x + 7) >> 3;
         else if (info.bpp == 4) width = (s->img_x + 1) >> 1;
         else if (info.bpp == 8) width = s->img_x;
-        else { STBI_FREE(out); return stbi__errpuc("bad bpp", "Corrupt BMP"); }
+        else { stbi__free(out); return stbi__errpuc("bad bpp", "Corrupt BMP"); }
         pad = (-width) & 3;
         if (info.bpp == 1) {
             for (j = 0; j < (int)s->img_y; ++j) {
@@ -5335,13 +5667,13 @@ static void* stbi__bmp_load(stbi__context* s, int* x, int* y, int* comp, int req
                 easy = 2;
         }
         if (!easy) {
-            if (!mr || !mg || !mb) { STBI_FREE(out); return stbi__errpuc("bad masks", "Corrupt BMP"); }
+            if (!mr || !mg || !mb) { stbi__free(out); return stbi__errpuc("bad masks", "Corrupt BMP"); }
             // right shift amt to put high bit in position #7
             rshift = stbi__high_bit(mr) - 7; rcount = stbi__bitcount(mr);
             gshift = stbi__high_bit(mg) - 7; gcount = stbi__bitcount(mg);
             bshift = stbi__high_bit(mb) - 7; bcount = stbi__bitcount(mb);
             ashift = stbi__high_bit(ma) - 7; acount = stbi__bitcount(ma);
-            if (rcount > 8 || gcount > 8 || bcount > 8 || acount > 8) { STBI_FREE(out); return stbi__errpuc("bad masks", "Corrupt BMP"); }
+            if (rcount > 8 || gcount > 8 || bcount > 8 || acount > 8) { stbi__free(out); return stbi__errpuc("bad masks", "Corrupt BMP"); }
         }
         for (j = 0; j < (int)s->img_y; ++j) {
             if (easy) {
@@ -5614,7 +5946,7 @@ static void* stbi__tga_load(stbi__context* s, int* x, int* y, int* comp, int req
         if (tga_indexed)
         {
             if (tga_palette_len == 0) {  /* you have to have at least one entry! */
-                STBI_FREE(tga_data);
+                stbi__free(tga_data);
                 return stbi__errpuc("bad palette", "Corrupt TGA");
             }
 
@@ -5623,7 +5955,7 @@ static void* stbi__tga_load(stbi__context* s, int* x, int* y, int* comp, int req
             //   load the palette
             tga_palette = (unsigned char*)stbi__malloc_mad2(tga_palette_len, tga_comp, 0);
             if (!tga_palette) {
-                STBI_FREE(tga_data);
+                stbi__free(tga_data);
                 return stbi__errpuc("outofmem", "Out of memory");
             }
             if (tga_rgb16) {
@@ -5635,8 +5967,8 @@ static void* stbi__tga_load(stbi__context* s, int* x, int* y, int* comp, int req
                 }
             }
             else if (!stbi__getn(s, tga_palette, tga_palette_len * tga_comp)) {
-                STBI_FREE(tga_data);
-                STBI_FREE(tga_palette);
+                stbi__free(tga_data);
+                stbi__free(tga_palette);
                 return stbi__errpuc("bad palette", "Corrupt TGA");
             }
         }
@@ -5721,7 +6053,7 @@ static void* stbi__tga_load(stbi__context* s, int* x, int* y, int* comp, int req
         //   clear my palette, if I had one
         if (tga_palette != NULL)
         {
-            STBI_FREE(tga_palette);
+            stbi__free(tga_palette);
         }
     }
 
@@ -5917,7 +6249,7 @@ static void* stbi__psd_load(stbi__context* s, int* x, int* y, int* comp, int req
             else {
                 // Read the RLE data.
                 if (!stbi__psd_decode_rle(s, p, pixelCount)) {
-                    STBI_FREE(out);
+                    stbi__free(out);
                     return stbi__errpuc("corrupt", "bad RLE data");
                 }
             }
@@ -6209,7 +6541,7 @@ static void* stbi__pic_load(stbi__context* s, int* px, int* py, int* comp, int r
     memset(result, 0xff, x * y * 4);
 
     if (!stbi__pic_load_core(s, x, y, comp, result)) {
-        STBI_FREE(result);
+        stbi__free(result);
         result = 0;
     }
     *px = x;
@@ -6323,13 +6655,13 @@ static int stbi__gif_info_raw(stbi__context* s, int* x, int* y, int* comp)
     stbi__gif* g = (stbi__gif*)stbi__malloc(sizeof(stbi__gif));
     if (!g) return stbi__err("outofmem", "Out of memory");
     if (!stbi__gif_header(s, g, comp, 1)) {
-        STBI_FREE(g);
+        stbi__free(g);
         stbi__rewind(s);
         return 0;
     }
     if (x) *x = g->w;
     if (y) *y = g->h;
-    STBI_FREE(g);
+    stbi__free(g);
     return 1;
 }
 
@@ -6646,17 +6978,18 @@ static stbi_uc* stbi__gif_load_next(stbi__context* s, stbi__gif* g, int* comp, i
 
 static void* stbi__load_gif_main_outofmem(stbi__gif* g, stbi_uc* out, int** delays)
 {
-    STBI_FREE(g->out);
-    STBI_FREE(g->history);
-    STBI_FREE(g->background);
+    stbi__free(g->out);
+    stbi__free(g->history);
+    stbi__free(g->background);
 
-    if (out) STBI_FREE(out);
-    if (delays && *delays) STBI_FREE(*delays);
+    if (out) stbi__free(out);
+    if (delays && *delays) stbi__free(*delays);
     return stbi__errpuc("outofmem", "Out of memory");
 }
 
 static void* stbi__load_gif_main(stbi__context* s, int** delays, int* x, int* y, int* z, int* comp, int req_comp)
 {
+    stbi__begin_decode();
     if (stbi__gif_test(s)) {
         int layers = 0;
         stbi_uc* u = 0;
@@ -6686,7 +7019,7 @@ static void* stbi__load_gif_main(stbi__context* s, int** delays, int* x, int* y,
                 stride = g.w * g.h * 4;
 
                 if (out) {
-                    void* tmp = (stbi_uc*)STBI_REALLOC_SIZED(out, out_size, layers * stride);
+                    void* tmp = (stbi_uc*)stbi__realloc_sized(out, out_size, layers * stride);
                     if (!tmp)
                         return stbi__load_gif_main_outofmem(&g, out, delays);
                     else {
@@ -6695,7 +7028,7 @@ static void* stbi__load_gif_main(stbi__context* s, int** delays, int* x, int* y,
                     }
 
                     if (delays) {
-                        int* new_delays = (int*)STBI_REALLOC_SIZED(*delays, delays_size, sizeof(int) * layers);
+                        int* new_delays = (int*)stbi__realloc_sized(*delays, delays_size, sizeof(int) * layers);
                         if (!new_delays)
                             return stbi__load_gif_main_outofmem(&g, out, delays);
                         *delays = new_delays;
@@ -6726,9 +7059,9 @@ static void* stbi__load_gif_main(stbi__context* s, int** delays, int* x, int* y,
         } while (u != 0);
 
         // free temp buffer;
-        STBI_FREE(g.out);
-        STBI_FREE(g.history);
-        STBI_FREE(g.background);
+        stbi__free(g.out);
+        stbi__free(g.history);
+        stbi__free(g.background);
 
         // do the final conversion after loading everything;
         if (req_comp && req_comp != 4)
@@ -6762,12 +7095,12 @@ static void* stbi__gif_load(stbi__context* s, int* x, int* y, int* comp, int req
     }
     else if (g.out) {
         // if there was an error and we allocated an image buffer, free it!
-        STBI_FREE(g.out);
+        stbi__free(g.out);
     }
 
     // free buffers needed for multiple frame loading;
-    STBI_FREE(g.history);
-    STBI_FREE(g.background);
+    stbi__free(g.history);
+    stbi__free(g.background);
 
     return u;
 }
@@ -6942,16 +7275,16 @@ static float* stbi__hdr_load(stbi__context* s, int* x, int* y, int* comp, int re
                 stbi__hdr_convert(hdr_data, rgbe, req_comp);
                 i = 1;
                 j = 0;
-                STBI_FREE(scanline);
+                stbi__free(scanline);
                 goto main_decode_loop; // yes, this makes no sense
             }
             len <<= 8;
             len |= stbi__get8(s);
-            if (len != width) { STBI_FREE(hdr_data); STBI_FREE(scanline); return stbi__errpf("invalid decoded scanline length", "corrupt HDR"); }
+            if (len != width) { stbi__free(hdr_data); stbi__free(scanline); return stbi__errpf("invalid decoded scanline length", "corrupt HDR"); }
             if (scanline == NULL) {
                 scanline = (stbi_uc*)stbi__malloc_mad2(width, 4, 0);
                 if (!scanline) {
-                    STBI_FREE(hdr_data);
+                    stbi__free(hdr_data);
                     return stbi__errpf("outofmem", "Out of memory");
                 }
             }
@@ -6965,13 +7298,13 @@ static float* stbi__hdr_load(stbi__context* s, int* x, int* y, int* comp, int re
                         // Run
                         value = stbi__get8(s);
                         count -= 128;
-                        if ((count == 0) || (count > nleft)) { STBI_FREE(hdr_data); STBI_FREE(scanline); return stbi__errpf("corrupt", "bad RLE data in HDR"); }
+                        if ((count == 0) || (count > nleft)) { stbi__free(hdr_data); stbi__free(scanline); return stbi__errpf("corrupt", "bad RLE data in HDR"); }
                         for (z = 0; z < count; ++z)
                             scanline[i++ * 4 + k] = value;
                     }
                     else {
                         // Dump
-                        if ((count == 0) || (count > nleft)) { STBI_FREE(hdr_data); STBI_FREE(scanline); return stbi__errpf("corrupt", "bad RLE data in HDR"); }
+                        if ((count == 0) || (count > nleft)) { stbi__free(hdr_data); stbi__free(scanline); return stbi__errpf("corrupt", "bad RLE data in HDR"); }
                         for (z = 0; z < count; ++z)
                             scanline[i++ * 4 + k] = stbi__get8(s);
                     }
@@ -6981,7 +7314,7 @@ static float* stbi__hdr_load(stbi__context* s, int* x, int* y, int* comp, int re
                 stbi__hdr_convert(hdr_data + (j * width + i) * req_comp, scanline + i * 4, req_comp);
         }
         if (scanline)
-            STBI_FREE(scanline);
+            stbi__free(scanline);
     }
 
     return hdr_data;
@@ -7226,7 +7559,7 @@ static void* stbi__pnm_load(stbi__context* s, int* x, int* y, int* comp, int req
     out = (stbi_uc*)stbi__malloc_mad4(s->img_n, s->img_x, s->img_y, ri->bits_per_channel / 8, 0);
     if (!out) return stbi__errpuc("outofmem", "Out of memory");
     if (!stbi__getn(s, out, s->img_n * s->img_x * s->img_y * (ri->bits_per_channel / 8))) {
-        STBI_FREE(out);
+        stbi__free(out);
         return stbi__errpuc("bad PNM", "PNM file truncated");
     }
 
@@ -7331,6 +7664,157 @@ static int stbi__pnm_is16(stbi__context* s)
 }
 #endif
 
+// *************************************************************************************************
+// Quite OK Image (QOI) loader
+//
+// QOI: https://qoiformat.org/qoi-specification.pdf
+//
+// The colorspace byte is informational only and is ignored.
+
+#ifndef STBI_NO_QOI
+
+#define STBI__QOI_OP_INDEX  0x00
+#define STBI__QOI_OP_DIFF   0x40
+#define STBI__QOI_OP_LUMA   0x80
+#define STBI__QOI_OP_RUN    0xc0
+#define STBI__QOI_OP_RGB    0xfe
+#define STBI__QOI_OP_RGBA   0xff
+
+static int      stbi__qoi_test(stbi__context* s)
+{
+    int r = stbi__get32be(s) == 0x716f6966; // "qoif"
+    stbi__rewind(s);
+    return r;
+}
+
+static int      stbi__qoi_info(stbi__context* s, int* x, int* y, int* comp)
+{
+    stbi__uint32 w, h;
+    int channels;
+
+    if (stbi__get32be(s) != 0x716f6966) {
+        stbi__rewind(s);
+        return 0;
+    }
+    w = stbi__get32be(s);
+    h = stbi__get32be(s);
+    channels = stbi__get8(s);
+    stbi__rewind(s);
+    if (w == 0 || h == 0 || (channels != 3 && channels != 4))
+        return 0;
+
+    if (x) *x = (int)w;
+    if (y) *y = (int)h;
+    if (comp) *comp = channels;
+    return 1;
+}
+
+static void* stbi__qoi_load(stbi__context* s, int* x, int* y, int* comp, int req_comp, stbi__result_info* ri)
+{
+    stbi_uc index[64 * 4];
+    stbi_uc px[4] = { 0, 0, 0, 255 };
+    stbi_uc* out, * p, * end;
+    int channels, out_n, i, run = 0;
+    STBI_NOTUSED(ri);
+
+    stbi__skip(s, 4);
+    s->img_x = stbi__get32be(s);
+    s->img_y = stbi__get32be(s);
+    channels = stbi__get8(s);
+    stbi__get8(s); // colorspace
+
+    if (channels != 3 && channels != 4) return stbi__errpuc("bad QOI", "QOI channel count must be 3 or 4");
+    if (s->img_x == 0 || s->img_y == 0) return stbi__errpuc("0-pixel image", "QOI image has zero width or height");
+    if (s->img_y > STBI_MAX_DIMENSIONS) return stbi__errpuc("too large", "Very large image (corrupt?)");
+    if (s->img_x > STBI_MAX_DIMENSIONS) return stbi__errpuc("too large", "Very large image (corrupt?)");
+    s->img_n = channels;
+
+    // decode straight into the requested layout when that's just adding or
+    // dropping alpha; grey outputs go through the generic converter
+    out_n = (req_comp == 3 || req_comp == 4) ? req_comp : channels;
+    if (!stbi__mad3sizes_valid(out_n, s->img_x, s->img_y, 0))
+        return stbi__errpuc("too large", "QOI too large");
+    out = (stbi_uc*)stbi__malloc_mad3(out_n, s->img_x, s->img_y, 0);
+    if (!out) return stbi__errpuc("outofmem", "Out of memory");
+
+    memset(index, 0, sizeof(index));
+    p = out;
+    end = out + (size_t)out_n * s->img_x * s->img_y;
+    while (p < end) {
+        if (run > 0) {
+            --run;
+        }
+        else {
+            int b1 = stbi__get8(s);
+            if (b1 == STBI__QOI_OP_RGB) {
+                px[0] = stbi__get8(s);
+                px[1] = stbi__get8(s);
+                px[2] = stbi__get8(s);
+            }
+            else if (b1 == STBI__QOI_OP_RGBA) {
+                px[0] = stbi__get8(s);
+                px[1] = stbi__get8(s);
+                px[2] = stbi__get8(s);
+                px[3] = stbi__get8(s);
+            }
+            else {
+                switch (b1 & 0xc0) {
+                case STBI__QOI_OP_INDEX:
+                    memcpy(px, index + b1 * 4, 4);
+                    break;
+                case STBI__QOI_OP_DIFF:
+                    px[0] = (stbi_uc)(px[0] + ((b1 >> 4) & 3) - 2);
+                    px[1] = (stbi_uc)(px[1] + ((b1 >> 2) & 3) - 2);
+                    px[2] = (stbi_uc)(px[2] + (b1 & 3) - 2);
+                    break;
+                case STBI__QOI_OP_LUMA: {
+                    int b2 = stbi__get8(s);
+                    int dg = (b1 & 0x3f) - 32;
+                    px[0] = (stbi_uc)(px[0] + dg - 8 + ((b2 >> 4) & 15));
+                    px[1] = (stbi_uc)(px[1] + dg);
+                    px[2] = (stbi_uc)(px[2] + dg - 8 + (b2 & 15));
+                    break;
+                }
+                default: // STBI__QOI_OP_RUN
+                    run = b1 & 0x3f;
+                    break;
+                }
+            }
+            memcpy(index + ((px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63) * 4, px, 4);
+        }
+
+        p[0] = px[0];
+        p[1] = px[1];
+        p[2] = px[2];
+        if (out_n == 4) p[3] = px[3];
+        p += out_n;
+    }
+
+    // the stream ends with seven zero bytes and a one; anything else means
+    // we ran off a truncated file and decoded padding
+    for (i = 0; i < 7; ++i) {
+        if (stbi__get8(s) != 0) {
+            stbi__free(out);
+            return stbi__errpuc("bad QOI", "QOI end marker missing (truncated?)");
+        }
+    }
+    if (stbi__get8(s) != 1) {
+        stbi__free(out);
+        return stbi__errpuc("bad QOI", "QOI end marker missing (truncated?)");
+    }
+
+    *x = s->img_x;
+    *y = s->img_y;
+    if (comp) *comp = channels;
+
+    if (req_comp && req_comp != out_n) {
+        out = stbi__convert_format(out, out_n, req_comp, s->img_x, s->img_y);
+        if (out == NULL) return out; // stbi__convert_format frees input on failure
+    }
+    return out;
+}
+#endif
+
 static int stbi__info_main(stbi__context* s, int* x, int* y, int* comp)
 {
 #ifndef STBI_NO_JPEG
@@ -7357,6 +7841,10 @@ static int stbi__info_main(stbi__context* s, int* x, int* y, int* comp)
     if (stbi__pic_info(s, x, y, comp))  return 1;
 #endif
 
+#ifndef STBI_NO_QOI
+    if (stbi__qoi_info(s, x, y, comp))  return 1;
+#endif
+
 #ifndef STBI_NO_PNM
     if (stbi__pnm_info(s, x, y, comp))  return 1;
 #endif
@@ -7461,6 +7949,85 @@ STBIDEF int stbi_is_16_bit_from_callbacks(stbi_io_callbacks const* c, void* user
     return stbi__is_16_main(&s);
 }
 
+// reusable decoder: owns an arena that keeps its grown size across decodes
+// and the zlib fixed-huffman tables, which are otherwise rebuilt for every
+// fixed block of every image
+struct stbi__decoder
+{
+    stbi_arena arena;
+    stbi_allocator alloc;
+#ifndef STBI_NO_ZLIB
+    stbi__zfixed zfixed;
+#endif
+};
+
+STBIDEF stbi_decoder* stbi_decoder_create(size_t scratch_size)
+{
+    stbi_decoder* d = (stbi_decoder*)STBI_MALLOC(sizeof(stbi_decoder));
+    if (d == NULL) return (stbi_decoder*)stbi__errpuc("outofmem", "Out of memory");
+    stbi_arena_init(&d->arena, scratch_size);
+    d->alloc = stbi_arena_allocator(&d->arena);
+#ifndef STBI_NO_ZLIB
+    if (!stbi__zbuild_huffman(&d->zfixed.length, stbi__zdefault_length, STBI__ZNSYMS) ||
+        !stbi__zbuild_huffman(&d->zfixed.distance, stbi__zdefault_distance, 32)) {
+        stbi_decoder_destroy(d);
+        return NULL;
+    }
+#endif
+    return d;
+}
+
+STBIDEF void stbi_decoder_destroy(stbi_decoder* d)
+{
+    if (d == NULL) return;
+    stbi_arena_release(&d->arena);
+    STBI_FREE(d);
+}
+
+STBIDEF stbi_uc* stbi_decoder_load_from_memory(stbi_decoder* d, stbi_uc const* buffer, int len, int* x, int* y, int* comp, int req_comp)
+{
+    const stbi_allocator* prev = stbi__g_allocator;
+    stbi_uc* result;
+    stbi__context s;
+    // the previous image lives in the arena, so this is where it goes away
+    stbi_arena_reset(&d->arena);
+    stbi__start_mem(&s, buffer, len);
+    stbi__g_allocator = &d->alloc;
+#ifndef STBI_NO_ZLIB
+    stbi__g_zfixed = &d->zfixed;
+#endif
+    result = stbi__load_and_postprocess_8bit(&s, x, y, comp, req_comp);
+#ifndef STBI_NO_ZLIB
+    stbi__g_zfixed = NULL;
+#endif
+    stbi__g_allocator = prev;
+    return result;
+}
+
+#ifndef STBI_NO_STDIO
+STBIDEF stbi_uc* stbi_decoder_load(stbi_decoder* d, char const* filename, int* x, int* y, int* comp, int req_comp)
+{
+    const stbi_allocator* prev = stbi__g_allocator;
+    FILE* f = stbi__fopen(filename, "rb");
+    stbi_uc* result;
+    stbi__context s;
+    if (!f) return stbi__errpuc("can't fopen", "Unable to open file");
+    stbi_arena_reset(&d->arena);
+    stbi__start_file(&s, f);
+    stbi__g_allocator = &d->alloc;
+#ifndef STBI_NO_ZLIB
+    stbi__g_zfixed = &d->zfixed;
+#endif
+    result = stbi__load_and_postprocess_8bit(&s, x, y, comp, req_comp);
+#ifndef STBI_NO_ZLIB
+    stbi__g_zfixed = NULL;
+#endif
+    stbi__g_allocator = prev;
+    fclose(f);
+    return result;
+}
+#endif
+
 #endif // STB_IMAGE_IMPLEMENTATION
 
-#pragma once
\ No newline at end of file
+#pragma once
\ No newline at end of file
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// Packs many small images into a few RGBA8 atlas pages
+//
+// Every image drawn from the same page shares one texture, so ImGui keeps
+// them in one draw command however many there are. Pages are packed with
+// a skyline (bottom-left) packer and only ever grow: adding an image never
+// moves the others. Removing leaves a hole until Compact() repacks the
+// pages holding enough of them. Each page tracks the rectangle written
+// since its last upload, so a GPU copy can be updated in place.
+//
+// The app doesn't use it yet: its only image is the full-window
+// background, and icons come from a font. It is here, with
+// tools/atlas_bench, for when product art and icons become images; a
+// renderer then mirrors each page as one texture.
+class SkylinePacker {
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    std::vector<Segment> skyline;
+    int width{ 0 };
+    int height{ 0 };
+    int64_t usedArea{ 0 };
+
+    // Lowest y at which a w-wide rect can sit on the skyline from segment i on
+    int FitAt(size_t i, int w) const {
+        if (skyline[i].x + w > width) return -1;
+        int y = 0;
+        for (int remaining = w; remaining > 0; i++) {
+            y = std::max(y, skyline[i].y);
+            remaining -= skyline[i].width;
+        }
+        return y;
+    }
+
+public:
+    SkylinePacker(int width = 0, int height = 0) { Reset(width, height); }
+
+    void Reset(int w, int h) {
+        width = w;
+        height = h;
+        usedArea = 0;
+        skyline.assign(1, Segment{ 0, 0, w });
+    }
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    float Occupancy() const { return width && height ? (float)usedArea / ((float)width * height) : 0.0f; }
+
+    bool Insert(int w, int h, int& outX, int& outY) {
+        if (w <= 0 || h <= 0 || w > width || h > height) return false;
+
+        // lowest top edge wins, then the narrowest segment to waste least
+        size_t best = skyline.size();
+        int bestTop = height + 1, bestWidth = width + 1, bestY = 0;
+        for (size_t i = 0; i < skyline.size(); i++) {
+            const int y = FitAt(i, w);
+            if (y < 0 || y + h > height) continue;
+            if (y + h < bestTop || (y + h == bestTop && skyline[i].width < bestWidth)) {
+                best = i;
+                bestTop = y + h;
+                bestWidth = skyline[i].width;
+                bestY = y;
+            }
+        }
+        if (best == skyline.size()) return false;
+
+        outX = skyline[best].x;
+        outY = bestY;
+        usedArea += (int64_t)w * h;
+
+        // the new segment covers [x, x + w); trim or drop what it overlaps
+        skyline.insert(skyline.begin() + best, Segment{ outX, bestTop, w });
+        const int right = outX + w;
+        size_t i = best + 1;
+        while (i < skyline.size() && skyline[i].x < right) {
+            const int overlap = right - skyline[i].x;
+            if (overlap >= skyline[i].width) {
+                skyline.erase(skyline.begin() + i);
+            }
+            else {
+                skyline[i].x += overlap;
+                skyline[i].width -= overlap;
+                break;
+            }
+        }
+
+        // neighbours at the same height become one segment
+        for (size_t j = 0; j + 1 < skyline.size();) {
+            if (skyline[j].y == skyline[j + 1].y) {
+                skyline[j].width += skyline[j + 1].width;
+                skyline.erase(skyline.begin() + j + 1);
+            }
+            else {
+                j++;
+            }
+        }
+        return true;
+    }
+};
+
+struct AtlasRegion {
+    int page{ -1 };
+    int x{ 0 };
+    int y{ 0 };
+    int width{ 0 };
+    int height{ 0 };
+    float u0{ 0.0f }, v0{ 0.0f }, u1{ 0.0f }, v1{ 0.0f };
+};
+
+struct AtlasRect {
+    int x0{ 0 }, y0{ 0 }, x1{ 0 }, y1{ 0 };
+
+    bool Empty() const { return x0 >= x1 || y0 >= y1; }
+
+    void Include(int ax0, int ay0, int ax1, int ay1) {
+        if (Empty()) {
+            *this = { ax0, ay0, ax1, ay1 };
+            return;
+        }
+        x0 = std::min(x0, ax0);
+        y0 = std::min(y0, ay0);
+        x1 = std::max(x1, ax1);
+        y1 = std::max(y1, ay1);
+    }
+};
+
+class TextureAtlas {
+public:
+    struct Page {
+        SkylinePacker packer;
+        std::vector<uint8_t> rgba;
+        AtlasRect dirty;             // written since the last TakeDirty
+        int64_t freedArea{ 0 };      // removed images still holding space
+        uint32_t generation{ 0 };    // bumped when Compact moves images
+    };
+
+private:
+    std::vector<Page> pages;
+    std::unordered_map<uint64_t, AtlasRegion> regions;
+    int pageSize{ 1024 };
+    int padding{ 1 };
+
+    void Blit(Page& page, const AtlasRegion& region, const uint8_t* rgba, int stride) {
+        // the gutter repeats the edge texels so bilinear filtering never
+        // reaches a neighbour
+        const int x0 = region.x - padding, y0 = region.y - padding;
+        const int w = region.width + padding * 2, h = region.height + padding * 2;
+        for (int y = 0; y < h; y++) {
+            const int sy = std::clamp(y - padding, 0, region.height - 1);
+            uint8_t* dst = &page.rgba[((size_t)(y0 + y) * pageSize + x0) * 4];
+            const uint8_t* src = rgba + (size_t)sy * stride;
+            for (int x = 0; x < padding; x++) memcpy(dst + x * 4, src, 4);
+            memcpy(dst + padding * 4, src, (size_t)region.width * 4);
+            for (int x = 0; x < padding; x++) memcpy(dst + (padding + region.width + x) * 4, src + (region.width - 1) * 4, 4);
+        }
+        page.dirty.Include(x0, y0, x0 + w, y0 + h);
+    }
+
+    // x, y is the packed rect's corner, gutter included
+    void SetPosition(AtlasRegion& region, int page, int x, int y) const {
+        region.page = page;
+        region.x = x + padding;
+        region.y = y + padding;
+        region.u0 = (float)region.x / pageSize;
+        region.v0 = (float)region.y / pageSize;
+        region.u1 = (float)(region.x + region.width) / pageSize;
+        region.v1 = (float)(region.y + region.height) / pageSize;
+    }
+
+    bool Place(const uint8_t* rgba, int stride, int width, int height, AtlasRegion& region) {
+        const int w = width + padding * 2, h = height + padding * 2;
+        int x = 0, y = 0;
+        size_t p = 0;
+        while (p < pages.size() && !pages[p].packer.Insert(w, h, x, y)) p++;
+        if (p == pages.size()) {
+            pages.emplace_back();
+            pages[p].packer.Reset(pageSize, pageSize);
+            pages[p].rgba.assign((size_t)pageSize * pageSize * 4, 0);
+            if (!pages[p].packer.Insert(w, h, x, y)) {
+                pages.pop_back();
+                return false;
+            }
+        }
+
+        region.width = width;
+        region.height = height;
+        SetPosition(region, (int)p, x, y);
+        Blit(pages[p], region, rgba, stride);
+        return true;
+    }
+
+public:
+    explicit TextureAtlas(int pageSize = 1024, int padding = 1) : pageSize(pageSize), padding(padding) {}
+
+    int PageSize() const { return pageSize; }
+    size_t PageCount() const { return pages.size(); }
+    const Page& GetPage(size_t index) const { return pages[index]; }
+    size_t ImageCount() const { return regions.size(); }
+
+    // Copies an RGBA8 image into the first page with room, opening a new page
+    // when none has. Adding an existing key replaces its image, in place when
+    // the size is unchanged. Fails only for images that can't fit on an
+    // empty page.
+    bool Add(uint64_t key, const uint8_t* rgba, int width, int height, AtlasRegion* outRegion = nullptr) {
+        const auto it = regions.find(key);
+        if (it != regions.end() && it->second.width == width && it->second.height == height) {
+            Blit(pages[it->second.page], it->second, rgba, width * 4);
+            if (outRegion) *outRegion = it->second;
+            return true;
+        }
+        Remove(key);
+        AtlasRegion region;
+        if (!Place(rgba, width * 4, width, height, region)) return false;
+        regions[key] = region;
+        if (outRegion) *outRegion = region;
+        return true;
+    }
+
+    bool Remove(uint64_t key) {
+        const auto it = regions.find(key);
+        if (it == regions.end()) return false;
+        const AtlasRegion& region = it->second;
+        pages[region.page].freedArea += (int64_t)(region.width + padding * 2) * (region.height + padding * 2);
+        regions.erase(it);
+        return true;
+    }
+
+    const AtlasRegion* Find(uint64_t key) const {
+        const auto it = regions.find(key);
+        return it == regions.end() ? nullptr : &it->second;
+    }
+
+    // Repacks, together, every page where at least minFreedFraction of the
+    // area is held by removed images; other pages are left untouched. Their
+    // live images go back tallest first, filling the repacked pages in order,
+    // and pages left empty at the end are released. Moved images get new
+    // regions (look them up again) and each repacked page's generation
+    // changes. Returns the number of pages repacked.
+    size_t Compact(float minFreedFraction = 0.25f) {
+        std::vector<size_t> targets;
+        std::vector<bool> repack(pages.size(), false);
+        for (size_t p = 0; p < pages.size(); p++) {
+            if (pages[p].freedArea >= (int64_t)(minFreedFraction * pageSize * pageSize)) {
+                targets.push_back(p);
+                repack[p] = true;
+            }
+        }
+        if (targets.empty()) return 0;
+
+        struct Live {
+            uint64_t key;
+            int width, height;
+            std::vector<uint8_t> rgba;
+        };
+        std::vector<Live> live;
+        for (const auto& [key, region] : regions) {
+            if (!repack[region.page]) continue;
+            const Page& page = pages[region.page];
+            Live image{ key, region.width, region.height, std::vector<uint8_t>((size_t)region.width * region.height * 4) };
+            for (int y = 0; y < region.height; y++) {
+                memcpy(&image.rgba[(size_t)y * region.width * 4], &page.rgba[((size_t)(region.y + y) * pageSize + region.x) * 4],
+                    (size_t)region.width * 4);
+            }
+            live.push_back(std::move(image));
+        }
+        std::sort(live.begin(), live.end(), [](const Live& a, const Live& b) {
+            return a.height != b.height ? a.height > b.height : a.width > b.width;
+        });
+
+        for (size_t p : targets) {
+            Page& page = pages[p];
+            page.packer.Reset(pageSize, pageSize);
+            std::fill(page.rgba.begin(), page.rgba.end(), (uint8_t)0);
+            page.freedArea = 0;
+            page.generation++;
+            page.dirty = { 0, 0, pageSize, pageSize };
+        }
+
+        for (const Live& image : live) {
+            const int w = image.width + padding * 2, h = image.height + padding * 2;
+            AtlasRegion& region = regions[image.key];
+            bool placed = false;
+            for (size_t i = 0; i < targets.size() && !placed; i++) {
+                int x = 0, y = 0;
+                if (pages[targets[i]].packer.Insert(w, h, x, y)) {
+                    SetPosition(region, (int)targets[i], x, y);
+                    Blit(pages[targets[i]], region, image.rgba.data(), image.width * 4);
+                    placed = true;
+                }
+            }
+            // it fitted on a page before, so an empty one always takes it
+            if (!placed) Place(image.rgba.data(), image.width * 4, image.width, image.height, region);
+        }
+
+        while (!pages.empty() && pages.back().packer.Occupancy() == 0.0f) pages.pop_back();
+        return targets.size();
+    }
+
+    // The rectangle of a page written since the previous call, for uploading
+    bool TakeDirty(size_t index, AtlasRect& out) {
+        out = pages[index].dirty;
+        pages[index].dirty = {};
+        return !out.Empty();
+    }
+};
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// DDS and KTX2 containers holding ready-to-upload textures
+//
+// Parsing only locates and validates each mip level inside the file; the
+// bytes themselves stay where they are (typically a MappedFile) and go
+// straight to texture creation. Only single 2D images are accepted: no
+// arrays, cube maps, volumes or KTX2 supercompression.
+namespace TextureContainer {
+    enum class Format { RGBA8, BC1, BC2, BC3, BC4, BC5, BC7 };
+
+    struct MipLevel {
+        size_t offset{ 0 };    // from the start of the file
+        size_t size{ 0 };
+        uint32_t width{ 0 };
+        uint32_t height{ 0 };
+        uint32_t rowPitch{ 0 };  // bytes per row of pixels, or per row of 4x4 blocks
+    };
+
+    struct Layout {
+        Format format{ Format::RGBA8 };
+        bool srgb{ false };
+        bool premultiplied{ false };  // colour stored multiplied by alpha
+        uint32_t width{ 0 };
+        uint32_t height{ 0 };
+        std::vector<MipLevel> levels;
+    };
+
+    constexpr uint32_t MaxDimension = 16384;
+
+    inline bool IsBlockCompressed(Format format) { return format != Format::RGBA8; }
+
+    inline uint32_t BlockBytes(Format format) {
+        return format == Format::BC1 || format == Format::BC4 ? 8 : 16;
+    }
+
+    inline uint32_t RowPitch(Format format, uint32_t width) {
+        return IsBlockCompressed(format) ? std::max(1u, (width + 3) / 4) * BlockBytes(format) : width * 4;
+    }
+
+    inline size_t LevelSize(Format format, uint32_t width, uint32_t height) {
+        const uint32_t rows = IsBlockCompressed(format) ? std::max(1u, (height + 3) / 4) : height;
+        return (size_t)RowPitch(format, width) * rows;
+    }
+
+    // Bytes the whole chain occupies once uploaded
+    inline uint64_t TotalSize(const Layout& layout) {
+        uint64_t total = 0;
+        for (const MipLevel& level : layout.levels) total += level.size;
+        return total;
+    }
+
+    inline uint32_t Read32(const unsigned char* p) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        return v;
+    }
+
+    inline uint64_t Read64(const unsigned char* p) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        return v;
+    }
+
+    constexpr uint32_t FourCC(char a, char b, char c, char d) {
+        return (uint32_t)(uint8_t)a | (uint32_t)(uint8_t)b << 8 | (uint32_t)(uint8_t)c << 16 | (uint32_t)(uint8_t)d << 24;
+    }
+
+    inline bool ValidateSize(Layout& out, uint32_t width, uint32_t height, uint32_t levelCount, const char*& failureReason) {
+        if (width == 0 || height == 0) {
+            failureReason = "zero-sized texture";
+            return false;
+        }
+        if (width > MaxDimension || height > MaxDimension) {
+            failureReason = "texture too large";
+            return false;
+        }
+        uint32_t maxLevels = 1;
+        for (uint32_t d = std::max(width, height); d > 1; d >>= 1) maxLevels++;
+        if (levelCount == 0 || levelCount > maxLevels) {
+            failureReason = "bad mip count";
+            return false;
+        }
+        out.width = width;
+        out.height = height;
+        return true;
+    }
+
+    inline bool IsDds(const unsigned char* data, size_t size) {
+        return size >= 4 && Read32(data) == FourCC('D', 'D', 'S', ' ');
+    }
+
+    inline bool ParseDds(const unsigned char* data, size_t size, Layout& out, const char*& failureReason) {
+        constexpr size_t HeaderSize = 4 + 124;
+        constexpr size_t Dx10HeaderSize = 20;
+        constexpr uint32_t FlagMipCount = 0x20000;
+        constexpr uint32_t PixelFourCC = 0x4;
+        constexpr uint32_t PixelRgb = 0x40;
+        constexpr uint32_t Caps2Cubemap = 0x200;
+        constexpr uint32_t Caps2Volume = 0x200000;
+
+        out = Layout{};
+        if (!IsDds(data, size) || size < HeaderSize || Read32(data + 4) != 124 || Read32(data + 4 + 72) != 32) {
+            failureReason = "not a DDS file";
+            return false;
+        }
+
+        const unsigned char* h = data + 4;
+        const uint32_t flags = Read32(h + 4);
+        const uint32_t height = Read32(h + 8);
+        const uint32_t width = Read32(h + 12);
+        const uint32_t mipCount = (flags & FlagMipCount) ? std::max(1u, Read32(h + 24)) : 1;
+        const uint32_t pixelFlags = Read32(h + 76);
+        const uint32_t fourCC = Read32(h + 80);
+        const uint32_t caps2 = Read32(h + 108);
+
+        if (caps2 & (Caps2Cubemap | Caps2Volume)) {
+            failureReason = "DDS cube maps and volumes are not supported";
+            return false;
+        }
+
+        size_t offset = HeaderSize;
+        if ((pixelFlags & PixelFourCC) && fourCC == FourCC('D', 'X', '1', '0')) {
+            if (size < HeaderSize + Dx10HeaderSize) {
+                failureReason = "DDS truncated";
+                return false;
+            }
+            const unsigned char* dx10 = data + HeaderSize;
+            const uint32_t dxgiFormat = Read32(dx10);
+            const uint32_t dimension = Read32(dx10 + 4);
+            const uint32_t miscFlags = Read32(dx10 + 8);
+            const uint32_t arraySize = Read32(dx10 + 12);
+            const uint32_t alphaMode = Read32(dx10 + 16) & 0x7;
+            if (dimension != 3 || (miscFlags & 0x4) || arraySize != 1) {
+                failureReason = "DDS must hold a single 2D texture";
+                return false;
+            }
+
+            // DXGI_FORMAT values
+            switch (dxgiFormat) {
+            case 28: out.format = Format::RGBA8; break;
+            case 29: out.format = Format::RGBA8; out.srgb = true; break;
+            case 71: out.format = Format::BC1; break;
+            case 72: out.format = Format::BC1; out.srgb = true; break;
+            case 74: out.format = Format::BC2; break;
+            case 75: out.format = Format::BC2; out.srgb = true; break;
+            case 77: out.format = Format::BC3; break;
+            case 78: out.format = Format::BC3; out.srgb = true; break;
+            case 80: out.format = Format::BC4; break;
+            case 83: out.format = Format::BC5; break;
+            case 98: out.format = Format::BC7; break;
+            case 99: out.format = Format::BC7; out.srgb = true; break;
+            default:
+                failureReason = "unsupported DDS DXGI format";
+                return false;
+            }
+            out.premultiplied = alphaMode == 2;  // DDS_ALPHA_MODE_PREMULTIPLIED
+            offset += Dx10HeaderSize;
+        }
+        else if (pixelFlags & PixelFourCC) {
+            switch (fourCC) {
+            case FourCC('D', 'X', 'T', '1'): out.format = Format::BC1; break;
+            case FourCC('D', 'X', 'T', '3'): out.format = Format::BC2; break;
+            case FourCC('D', 'X', 'T', '5'): out.format = Format::BC3; break;
+            case FourCC('A', 'T', 'I', '1'):
+            case FourCC('B', 'C', '4', 'U'): out.format = Format::BC4; break;
+            case FourCC('A', 'T', 'I', '2'):
+            case FourCC('B', 'C', '5', 'U'): out.format = Format::BC5; break;
+            default:
+                failureReason = "unsupported DDS FourCC";
+                return false;
+            }
+        }
+        else if ((pixelFlags & PixelRgb) && Read32(h + 84) == 32 && Read32(h + 88) == 0xff &&
+            Read32(h + 92) == 0xff00 && Read32(h + 96) == 0xff0000) {
+            out.format = Format::RGBA8;
+        }
+        else {
+            failureReason = "unsupported DDS pixel format";
+            return false;
+        }
+
+        if (!ValidateSize(out, width, height, mipCount, failureReason)) return false;
+
+        // mips are stored largest first, back to back
+        for (uint32_t level = 0; level < mipCount; level++) {
+            MipLevel mip;
+            mip.width = std::max(1u, width >> level);
+            mip.height = std::max(1u, height >> level);
+            mip.rowPitch = RowPitch(out.format, mip.width);
+            mip.size = LevelSize(out.format, mip.width, mip.height);
+            mip.offset = offset;
+            if (mip.size > size - offset) {
+                failureReason = "DDS truncated";
+                return false;
+            }
+            offset += mip.size;
+            out.levels.push_back(mip);
+        }
+        return true;
+    }
+
+    constexpr unsigned char Ktx2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+    inline bool IsKtx2(const unsigned char* data, size_t size) {
+        return size >= sizeof(Ktx2Identifier) && memcmp(data, Ktx2Identifier, sizeof(Ktx2Identifier)) == 0;
+    }
+
+    inline bool ParseKtx2(const unsigned char* data, size_t size, Layout& out, const char*& failureReason) {
+        constexpr size_t LevelIndexOffset = 80;
+        constexpr size_t LevelIndexEntry = 24;
+
+        out = Layout{};
+        if (!IsKtx2(data, size) || size < LevelIndexOffset) {
+            failureReason = "not a KTX2 file";
+            return false;
+        }
+
+        const uint32_t vkFormat = Read32(data + 12);
+        const uint32_t width = Read32(data + 20);
+        const uint32_t height = Read32(data + 24);
+        const uint32_t depth = Read32(data + 28);
+        const uint32_t layerCount = Read32(data + 32);
+        const uint32_t faceCount = Read32(data + 36);
+        const uint32_t levelCount = std::max(1u, Read32(data + 40));
+        const uint32_t supercompression = Read32(data + 44);
+        const uint32_t dfdOffset = Read32(data + 48);
+        const uint32_t dfdLength = Read32(data + 52);
+
+        if (depth != 0 || layerCount > 1 || faceCount != 1) {
+            failureReason = "KTX2 must hold a single 2D texture";
+            return false;
+        }
+        if (supercompression != 0) {
+            failureReason = "KTX2 supercompression is not supported";
+            return false;
+        }
+
+        // VkFormat values
+        switch (vkFormat) {
+        case 37: out.format = Format::RGBA8; break;
+        case 43: out.format = Format::RGBA8; out.srgb = true; break;
+        case 131: case 133: out.format = Format::BC1; break;
+        case 132: case 134: out.format = Format::BC1; out.srgb = true; break;
+        case 135: out.format = Format::BC2; break;
+        case 136: out.format = Format::BC2; out.srgb = true; break;
+        case 137: out.format = Format::BC3; break;
+        case 138: out.format = Format::BC3; out.srgb = true; break;
+        case 139: out.format = Format::BC4; break;
+        case 141: out.format = Format::BC5; break;
+        case 145: out.format = Format::BC7; break;
+        case 146: out.format = Format::BC7; out.srgb = true; break;
+        default:
+            failureReason = "unsupported KTX2 format";
+            return false;
+        }
+
+        // flags byte of the basic descriptor block; bit 0 is KHR_DF_FLAG_ALPHA_PREMULTIPLIED
+        if (dfdLength >= 16 && dfdOffset <= size && dfdLength <= size - dfdOffset) {
+            out.premultiplied = (data[dfdOffset + 15] & 1) != 0;
+        }
+
+        if (!ValidateSize(out, width, height, levelCount, failureReason)) return false;
+        if (size < LevelIndexOffset + (size_t)levelCount * LevelIndexEntry) {
+            failureReason = "KTX2 truncated";
+            return false;
+        }
+
+        // the level index lists mip 0 first, wherever the data itself sits
+        for (uint32_t level = 0; level < levelCount; level++) {
+            const unsigned char* entry = data + LevelIndexOffset + (size_t)level * LevelIndexEntry;
+            const uint64_t offset = Read64(entry);
+            const uint64_t length = Read64(entry + 8);
+
+            MipLevel mip;
+            mip.width = std::max(1u, width >> level);
+            mip.height = std::max(1u, height >> level);
+            mip.rowPitch = RowPitch(out.format, mip.width);
+            mip.size = LevelSize(out.format, mip.width, mip.height);
+            if (length != mip.size) {
+                failureReason = "KTX2 level has the wrong size";
+                return false;
+            }
+            if (offset > size || length > size - offset) {
+                failureReason = "KTX2 truncated";
+                return false;
+            }
+            mip.offset = (size_t)offset;
+            out.levels.push_back(mip);
+        }
+        return true;
+    }
+
+    // Drops leading mips while the next one down still covers coverWidth x
+    // coverHeight, so an oversized texture uploads only what gets displayed.
+    // Block-compressed tops must stay multiples of the 4x4 block.
+    inline void SkipLevelsAbove(Layout& layout, uint32_t coverWidth, uint32_t coverHeight) {
+        size_t first = 0;
+        while (first + 1 < layout.levels.size()) {
+            const MipLevel& next = layout.levels[first + 1];
+            if (next.width < coverWidth || next.height < coverHeight) break;
+            if (IsBlockCompressed(layout.format) && (next.width % 4 != 0 || next.height % 4 != 0)) break;
+            first++;
+        }
+        layout.levels.erase(layout.levels.begin(), layout.levels.begin() + first);
+        layout.width = layout.levels.empty() ? layout.width : layout.levels[0].width;
+        layout.height = layout.levels.empty() ? layout.height : layout.levels[0].height;
+    }
+
+    inline bool IsContainer(const unsigned char* data, size_t size) {
+        return IsDds(data, size) || IsKtx2(data, size);
+    }
+
+    inline bool Parse(const unsigned char* data, size_t size, Layout& out, const char*& failureReason) {
+        if (IsDds(data, size)) return ParseDds(data, size, out, failureReason);
+        if (IsKtx2(data, size)) return ParseKtx2(data, size, out, failureReason);
+        failureReason = "not a DDS or KTX2 file";
+        return false;
+    }
+}
@@ -0,0 +1,416 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bc_encoder.h"
+#include "image_blur.h"
+#include "image_cache.h"
+#include "image_resample.h"
+#include "mapped_file.h"
+#include "texture_container.h"
+#include "thread_pool.h"
+
+// Texture preparation off the render thread
+//
+// Everything up to the GPU upload (reading, decoding through the image
+// cache, downscaling, mip generation, block compression) produces a
+// Prepared texture: a TextureContainer::Layout plus the bytes it points
+// into, either a mapped DDS/KTX2 or memory the Prepared owns. The renderer
+// then has a single upload path whatever the source was.
+namespace TextureLoader {
+    struct Options {
+        int coverWidth{ 0 };        // downscale to just cover this area; 0 keeps the source size
+        int coverHeight{ 0 };
+        bool premultiply{ false };  // decoded images only; containers keep their packed alpha mode
+        bool compress{ true };      // BC1 when opaque, BC7 (BC3 without allowBC7) with alpha
+        bool allowBC7{ true };
+        // Kaiser keeps small text and edges crisper than a box down the chain
+        ImageResample::Filter mipFilter{ ImageResample::Filter::Kaiser };
+        // > 0 prepares a pre-blurred copy instead, sigma in pixels of the
+        // covered size; it comes back smaller (see ImageBlur::Blur)
+        float blurSigma{ 0.0f };
+    };
+
+    struct Prepared {
+        TextureContainer::Layout layout;
+        MappedFile mapping;
+        std::vector<uint8_t> storage;
+        int sourceWidth{ 0 };
+        int sourceHeight{ 0 };
+        bool fromCache{ false };
+        const char* failureReason{ nullptr };
+
+        bool Ok() const { return !layout.levels.empty(); }
+        const unsigned char* Data() const { return mapping.Data() ? mapping.Data() : storage.data(); }
+    };
+
+    inline void AppendLevel(Prepared& out, const uint8_t* data, int width, int height) {
+        TextureContainer::MipLevel level;
+        level.offset = out.storage.size();
+        level.width = (uint32_t)width;
+        level.height = (uint32_t)height;
+        level.rowPitch = TextureContainer::RowPitch(out.layout.format, level.width);
+        level.size = TextureContainer::LevelSize(out.layout.format, level.width, level.height);
+        out.storage.insert(out.storage.end(), data, data + level.size);
+        out.layout.levels.push_back(level);
+    }
+
+    // Downscales (when asked) and builds the full mip chain from RGBA8 pixels,
+    // block-compressing every level when the size allows. The reduced size is
+    // rounded up to whole 4x4 blocks where the source allows, so it still
+    // compresses.
+    inline Prepared FromPixels(const unsigned char* rgba, int width, int height, ImageResample::Alpha alpha, const Options& options,
+        ThreadPool* pool = nullptr) {
+        Prepared out;
+        out.sourceWidth = width;
+        out.sourceHeight = height;
+
+        int targetWidth = width, targetHeight = height;
+        ImageResample::Level scaled;
+        if (options.coverWidth > 0 && options.coverHeight > 0 &&
+            ImageResample::CoverSize(width, height, options.coverWidth, options.coverHeight, targetWidth, targetHeight)) {
+            targetWidth = std::min(width, (targetWidth + 3) & ~3);
+            targetHeight = std::min(height, (targetHeight + 3) & ~3);
+            scaled = ImageResample::Downscale(rgba, width, height, targetWidth, targetHeight, ImageResample::Filter::Lanczos, true, pool, alpha);
+            rgba = scaled.rgba.data();
+        }
+        if (options.blurSigma > 0.0f) {
+            scaled = ImageBlur::Blur(rgba, targetWidth, targetHeight, options.blurSigma, true, pool, alpha);
+            rgba = scaled.rgba.data();
+            targetWidth = scaled.width;
+            targetHeight = scaled.height;
+        }
+        const std::vector<ImageResample::Level> mips =
+            ImageResample::BuildMipChain(rgba, targetWidth, targetHeight, options.mipFilter, true, pool, alpha);
+
+        TextureContainer::Layout& layout = out.layout;
+        layout.width = (uint32_t)targetWidth;
+        layout.height = (uint32_t)targetHeight;
+        layout.premultiplied = alpha == ImageResample::Alpha::Premultiplied;
+        layout.format = TextureContainer::Format::RGBA8;
+        BcEncoder::Format bc = BcEncoder::Format::BC1;
+        if (options.compress && targetWidth % 4 == 0 && targetHeight % 4 == 0) {
+            layout.format = TextureContainer::Format::BC1;
+            if (BcEncoder::HasAlpha(rgba, targetWidth, targetHeight)) {
+                layout.format = options.allowBC7 ? TextureContainer::Format::BC7 : TextureContainer::Format::BC3;
+                bc = options.allowBC7 ? BcEncoder::Format::BC7 : BcEncoder::Format::BC3;
+            }
+        }
+
+        size_t total = 0;
+        for (size_t i = 0; i <= mips.size(); i++) {
+            total += TextureContainer::LevelSize(layout.format, std::max(1, targetWidth >> i), std::max(1, targetHeight >> i));
+        }
+        out.storage.reserve(total);
+        for (size_t i = 0; i <= mips.size(); i++) {
+            const int w = i ? mips[i - 1].width : targetWidth;
+            const int h = i ? mips[i - 1].height : targetHeight;
+            const uint8_t* pixels = i ? mips[i - 1].rgba.data() : rgba;
+            if (layout.format == TextureContainer::Format::RGBA8) {
+                AppendLevel(out, pixels, w, h);
+            }
+            else {
+                const std::vector<uint8_t> blocks = BcEncoder::Encode(pixels, w, h, bc, pool);
+                AppendLevel(out, blocks.data(), w, h);
+            }
+        }
+        return out;
+    }
+
+    // Takes over a mapped DDS or KTX2 and keeps only the mips needed to cover the area
+    inline bool FromContainer(MappedFile&& file, const Options& options, Prepared& out) {
+        out = Prepared{};
+        out.mapping = std::move(file);
+        if (!TextureContainer::Parse(out.mapping.Data(), out.mapping.Size(), out.layout, out.failureReason)) return false;
+        if (out.layout.format == TextureContainer::Format::BC7 && !options.allowBC7) {
+            out.layout = TextureContainer::Layout{};
+            out.failureReason = "BC7 is not supported by this device";
+            return false;
+        }
+        out.sourceWidth = (int)out.layout.width;
+        out.sourceHeight = (int)out.layout.height;
+        if (options.coverWidth > 0 && options.coverHeight > 0) {
+            TextureContainer::SkipLevelsAbove(out.layout, (uint32_t)options.coverWidth, (uint32_t)options.coverHeight);
+        }
+        return true;
+    }
+
+    // Several preparations of one decoded image (sizes, blurs), decoded or
+    // read from the cache once; every variant shares the first one's
+    // premultiply. Not for DDS/KTX2, which are already prepared.
+    inline std::vector<Prepared> LoadVariants(const std::string& path, const std::vector<Options>& variants, ImageCache* cache = nullptr,
+        ThreadPool* pool = nullptr) {
+        std::vector<Prepared> out(variants.size());
+        if (variants.empty()) return out;
+        LoadedImage image = LoadCached(path, 4, cache, variants[0].premultiply);
+        const ImageResample::Alpha alpha = image.premultiplied ? ImageResample::Alpha::Premultiplied : ImageResample::Alpha::Straight;
+        for (size_t i = 0; i < variants.size(); i++) {
+            if (!image.Ok()) {
+                out[i].failureReason = image.failureReason;
+                continue;
+            }
+            out[i] = FromPixels(image.Pixels(), image.width, image.height, alpha, variants[i], pool);
+            out[i].fromCache = image.fromCache;
+        }
+        return out;
+    }
+
+    // Any file the loader understands: DDS/KTX2 straight from the mapping,
+    // everything else decoded through the cache (nullptr decodes directly)
+    inline Prepared Load(const std::string& path, const Options& options, ImageCache* cache = nullptr, ThreadPool* pool = nullptr) {
+        Prepared out;
+        {
+            MappedFile file;
+            if (file.Open(path) && TextureContainer::IsContainer(file.Data(), file.Size())) {
+                if (options.blurSigma > 0.0f) {
+                    out.failureReason = "can't blur a packed container";
+                    return out;
+                }
+                FromContainer(std::move(file), options, out);
+                return out;
+            }
+        }
+
+        return std::move(LoadVariants(path, { options }, cache, pool)[0]);
+    }
+
+    // The top level as tightly packed RGBA8, with block formats and sRGB
+    // decoded the way a GPU sampler hands them to the shader; for code that
+    // draws or records textures on the CPU
+    inline bool DecodeTopLevel(const Prepared& prepared, std::vector<uint8_t>& rgba, int& width, int& height) {
+        if (!prepared.Ok()) return false;
+        const TextureContainer::Layout& layout = prepared.layout;
+        const TextureContainer::MipLevel& level = layout.levels[0];
+        const unsigned char* data = prepared.Data() + level.offset;
+        width = (int)level.width;
+        height = (int)level.height;
+
+        switch (layout.format) {
+        case TextureContainer::Format::RGBA8:
+            rgba.resize((size_t)level.width * level.height * 4);
+            for (uint32_t y = 0; y < level.height; y++) {
+                memcpy(rgba.data() + (size_t)y * level.width * 4, data + (size_t)y * level.rowPitch, (size_t)level.width * 4);
+            }
+            break;
+        case TextureContainer::Format::BC1:
+            rgba = BcEncoder::Decode(data, width, height, BcEncoder::Format::BC1);
+            break;
+        case TextureContainer::Format::BC3:
+            rgba = BcEncoder::Decode(data, width, height, BcEncoder::Format::BC3);
+            break;
+        case TextureContainer::Format::BC7:
+            rgba = BcEncoder::Decode(data, width, height, BcEncoder::Format::BC7);
+            break;
+        default:
+            return false;
+        }
+
+        if (layout.srgb) {
+            const float* decode = ImageResample::Tables().decode;
+            for (size_t i = 0; i < rgba.size(); i++) {
+                if (i % 4 != 3) rgba[i] = (uint8_t)lrintf(decode[rgba[i]] * 255.0f);
+            }
+        }
+        return true;
+    }
+}
+
+using TextureHandle = uint32_t;  // 0 is never handed out
+
+// Loads textures on a ThreadPool without blocking the render thread
+//
+// Request() returns a handle at once; preparing happens on a worker. The
+// render thread calls ProcessCompletions() once per frame, which hands each
+// finished Prepared to an upload function (the only step that touches the
+// GPU) and then runs the request's callback. Until then Find() reports the
+// handle as pending along with the colour to draw in its place. Loads run
+// as ordinary pool tasks, so a pool.Wait() elsewhere also waits for them.
+// SetNotify() lets a render thread that sleeps between frames be woken when
+// a load finishes.
+class AsyncTextureLoader {
+public:
+    enum class State { Pending, Ready, Failed };
+
+    struct Info {
+        State state{ State::Pending };
+        void* texture{ nullptr };       // whatever the upload function returned
+        int width{ 0 };
+        int height{ 0 };
+        bool premultiplied{ false };
+        bool fromCache{ false };
+        uint64_t bytes{ 0 };             // GPU memory of the uploaded chain
+        uint32_t placeholderColor{ 0 };  // packed like IM_COL32
+        double prepareMs{ 0.0 };
+        std::string path;               // the candidate that loaded, or the last one tried
+        const char* failureReason{ nullptr };
+    };
+
+    using Callback = std::function<void(TextureHandle, const Info&)>;
+
+private:
+    struct Completion {
+        TextureHandle handle;
+        TextureLoader::Prepared prepared;
+        std::string path;
+        double ms;
+    };
+
+    ThreadPool& pool;
+    ImageCache* cache;
+    std::mutex mutex;
+    std::condition_variable drained;
+    std::deque<Completion> completed;
+    size_t inFlight{ 0 };
+    std::function<void()> notify;
+
+    // render thread only
+    std::unordered_map<TextureHandle, Info> textures;
+    std::unordered_map<TextureHandle, Callback> callbacks;
+    TextureHandle nextHandle{ 1 };
+
+public:
+    AsyncTextureLoader(ThreadPool& pool, ImageCache* cache = nullptr) : pool(pool), cache(cache) {}
+
+    // Workers still preparing hold a pointer to this loader
+    ~AsyncTextureLoader() {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return inFlight == 0; });
+    }
+
+    AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+    AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+    // Runs on the worker after each load is queued for ProcessCompletions();
+    // set it before the first Request()
+    void SetNotify(std::function<void()> callback) { notify = std::move(callback); }
+
+    // Candidates are tried in order on the worker; the first that loads wins,
+    // so a packed container can fall back to its source image
+    TextureHandle Request(std::vector<std::string> candidates, const TextureLoader::Options& options, uint32_t placeholderColor,
+        Callback callback = nullptr) {
+        const TextureHandle handle = nextHandle++;
+        Info& info = textures[handle];
+        info.placeholderColor = placeholderColor;
+        if (callback) callbacks[handle] = std::move(callback);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight++;
+        }
+        pool.Submit([this, handle, candidates = std::move(candidates), options] {
+            const auto start = std::chrono::steady_clock::now();
+            Completion done{ handle, {}, {}, 0.0 };
+            for (const std::string& path : candidates) {
+                // no pool here: a task must not wait on the pool it runs in
+                done.prepared = TextureLoader::Load(path, options, cache, nullptr);
+                done.path = path;
+                if (done.prepared.Ok()) break;
+            }
+            done.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            completed.push_back(std::move(done));
+            if (notify) notify();
+            inFlight--;
+            drained.notify_all();
+        });
+        return handle;
+    }
+
+    // One task prepares every variant from a single decode of path (see
+    // TextureLoader::LoadVariants); each gets its own handle and callback
+    std::vector<TextureHandle> RequestVariants(const std::string& path, std::vector<TextureLoader::Options> variants, uint32_t placeholderColor,
+        std::vector<Callback> variantCallbacks = {}) {
+        std::vector<TextureHandle> handles;
+        for (size_t i = 0; i < variants.size(); i++) {
+            const TextureHandle handle = nextHandle++;
+            textures[handle].placeholderColor = placeholderColor;
+            if (i < variantCallbacks.size() && variantCallbacks[i]) callbacks[handle] = std::move(variantCallbacks[i]);
+            handles.push_back(handle);
+        }
+        if (handles.empty()) return handles;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight++;
+        }
+        pool.Submit([this, handles, path, variants = std::move(variants)] {
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<TextureLoader::Prepared> prepared = TextureLoader::LoadVariants(path, variants, cache, nullptr);
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < handles.size(); i++) completed.push_back({ handles[i], std::move(prepared[i]), path, ms });
+            if (notify) notify();
+            inFlight--;
+            drained.notify_all();
+        });
+        return handles;
+    }
+
+    // Uploads up to maxUploads finished textures. upload(const Prepared&)
+    // returns the created texture, or nullptr on failure.
+    template<typename Upload>
+    size_t ProcessCompletions(Upload&& upload, size_t maxUploads = SIZE_MAX) {
+        size_t processed = 0;
+        while (processed < maxUploads) {
+            Completion done;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (completed.empty()) break;
+                done = std::move(completed.front());
+                completed.pop_front();
+            }
+            processed++;
+
+            Info& info = textures[done.handle];
+            const TextureLoader::Prepared& prepared = done.prepared;
+            info.prepareMs = done.ms;
+            info.path = std::move(done.path);
+            info.fromCache = prepared.fromCache;
+            info.texture = prepared.Ok() ? upload(prepared) : nullptr;
+            if (info.texture) {
+                info.state = State::Ready;
+                info.width = (int)prepared.layout.width;
+                info.height = (int)prepared.layout.height;
+                info.premultiplied = prepared.layout.premultiplied;
+                info.bytes = TextureContainer::TotalSize(prepared.layout);
+            }
+            else {
+                info.state = State::Failed;
+                info.failureReason = prepared.Ok() ? "texture upload failed" : prepared.failureReason;
+            }
+
+            const auto callback = callbacks.find(done.handle);
+            if (callback != callbacks.end()) {
+                const Callback run = std::move(callback->second);
+                callbacks.erase(callback);
+                run(done.handle, info);
+            }
+        }
+        return processed;
+    }
+
+    const Info* Find(TextureHandle handle) const {
+        const auto it = textures.find(handle);
+        return it == textures.end() ? nullptr : &it->second;
+    }
+
+    size_t PendingCount() const {
+        size_t pending = 0;
+        for (const auto& entry : textures) pending += entry.second.state == State::Pending;
+        return pending;
+    }
+};
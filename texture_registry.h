@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Owns GPU textures by asset id, within a memory budget
+//
+// Textures are handed out as counted Refs. One nobody references stays
+// resident, so acquiring it again costs nothing, until the total goes over
+// budget; then unreferenced textures are released least recently used
+// first. Referenced textures are never evicted, so the total can sit above
+// the budget while everything in it is in use. The registry only counts
+// bytes and calls the release function it was given; it never touches the
+// GPU itself. Render thread only.
+class TextureRegistry {
+public:
+    using ReleaseFn = std::function<void(void* texture)>;
+
+private:
+    struct Entry {
+        std::string id;
+        void* texture{ nullptr };
+        uint64_t bytes{ 0 };
+        int width{ 0 };
+        int height{ 0 };
+        bool premultiplied{ false };
+        uint32_t refs{ 0 };
+    };
+
+    // front is the most recently used
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    ReleaseFn release;
+    uint64_t budget{ 0 };
+    uint64_t totalBytes{ 0 };
+    uint64_t evictions{ 0 };
+
+    void MoveToFront(Entry* entry) {
+        const auto it = index.find(entry->id);
+        entries.splice(entries.begin(), entries, it->second);
+    }
+
+    void Unref(Entry* entry) {
+        if (--entry->refs == 0) {
+            MoveToFront(entry);
+            Trim();
+        }
+    }
+
+public:
+    class Ref {
+        friend class TextureRegistry;
+
+        TextureRegistry* registry{ nullptr };
+        Entry* entry{ nullptr };
+
+        Ref(TextureRegistry* registry, Entry* entry) : registry(registry), entry(entry) { entry->refs++; }
+
+    public:
+        Ref() = default;
+        Ref(const Ref& other) : registry(other.registry), entry(other.entry) {
+            if (entry) entry->refs++;
+        }
+        Ref(Ref&& other) noexcept : registry(std::exchange(other.registry, nullptr)), entry(std::exchange(other.entry, nullptr)) {}
+        ~Ref() { Reset(); }
+
+        Ref& operator=(Ref other) noexcept {
+            std::swap(registry, other.registry);
+            std::swap(entry, other.entry);
+            return *this;
+        }
+
+        void Reset() {
+            if (entry) registry->Unref(entry);
+            registry = nullptr;
+            entry = nullptr;
+        }
+
+        explicit operator bool() const { return entry != nullptr; }
+        void* Get() const { return entry ? entry->texture : nullptr; }
+        const std::string& Id() const { return entry->id; }
+        int Width() const { return entry ? entry->width : 0; }
+        int Height() const { return entry ? entry->height : 0; }
+        bool Premultiplied() const { return entry && entry->premultiplied; }
+        uint64_t Bytes() const { return entry ? entry->bytes : 0; }
+    };
+
+    TextureRegistry(uint64_t budgetBytes, ReleaseFn release) : release(std::move(release)), budget(budgetBytes) {}
+
+    // Every Ref must be gone by now; whatever is left is released
+    ~TextureRegistry() {
+        for (Entry& entry : entries) release(entry.texture);
+    }
+
+    TextureRegistry(const TextureRegistry&) = delete;
+    TextureRegistry& operator=(const TextureRegistry&) = delete;
+
+    // Takes ownership of texture under id. Registering an id again swaps in
+    // the new texture and releases the old one; existing Refs follow along.
+    Ref Insert(const std::string& id, void* texture, uint64_t bytes, int width, int height, bool premultiplied = false) {
+        auto it = index.find(id);
+        if (it == index.end()) {
+            entries.push_front(Entry{});
+            it = index.emplace(id, entries.begin()).first;
+            entries.front().id = id;
+        }
+        else {
+            MoveToFront(&*it->second);
+        }
+
+        Entry& entry = *it->second;
+        if (entry.texture) release(entry.texture);
+        totalBytes = totalBytes - entry.bytes + bytes;
+        entry.texture = texture;
+        entry.bytes = bytes;
+        entry.width = width;
+        entry.height = height;
+        entry.premultiplied = premultiplied;
+
+        Ref ref(this, &entry);
+        Trim();
+        return ref;
+    }
+
+    // An empty Ref when the id isn't resident (never loaded, or evicted)
+    Ref Acquire(const std::string& id) {
+        const auto it = index.find(id);
+        if (it == index.end()) return Ref();
+        MoveToFront(&*it->second);
+        return Ref(this, &*it->second);
+    }
+
+    bool Contains(const std::string& id) const { return index.count(id) != 0; }
+
+    // Releases unreferenced textures, oldest first, until the total fits
+    // the budget. Returns how many went.
+    size_t Trim() {
+        size_t evicted = 0;
+        for (auto it = entries.end(); it != entries.begin() && totalBytes > budget;) {
+            --it;
+            if (it->refs) continue;
+            release(it->texture);
+            totalBytes -= it->bytes;
+            index.erase(it->id);
+            it = entries.erase(it);
+            evicted++;
+        }
+        evictions += evicted;
+        return evicted;
+    }
+
+    void SetBudget(uint64_t bytes) {
+        budget = bytes;
+        Trim();
+    }
+
+    uint64_t Budget() const { return budget; }
+    uint64_t TotalBytes() const { return totalBytes; }
+    uint64_t Evictions() const { return evictions; }
+    size_t Count() const { return entries.size(); }
+};
+
+using TextureRef = TextureRegistry::Ref;
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool
+//
+// Each worker owns a deque: it pops its own work LIFO (cache-warm) and steals
+// from the front of the others when it runs dry. Tasks submitted from outside
+// the pool are dealt round-robin. Wait() lets the calling thread run tasks too.
+class ThreadPool {
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> pending{ 0 };  // submitted but not finished
+    std::atomic<size_t> queued{ 0 };   // submitted but not started
+    std::atomic<size_t> nextQueue{ 0 };
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    bool stopping{ false };
+
+    static int& WorkerIndex() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    bool TryPop(size_t index, std::function<void()>& task) {
+        Queue& q = *queues[index];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return false;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        queued.fetch_sub(1);
+        return true;
+    }
+
+    bool TrySteal(size_t thief, std::function<void()>& task) {
+        const size_t count = queues.size();
+        for (size_t i = 1; i <= count; i++) {
+            Queue& q = *queues[(thief + i) % count];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void RunTask(std::function<void()>& task) {
+        task();
+        task = nullptr;
+        if (pending.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            idle.notify_all();
+        }
+    }
+
+    void WorkerLoop(int index) {
+        WorkerIndex() = index;
+        std::function<void()> task;
+        while (true) {
+            if (TryPop(index, task) || TrySteal(index, task)) {
+                RunTask(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+            if (stopping) return;
+        }
+    }
+
+public:
+    explicit ThreadPool(unsigned threadCount = 0) {
+        if (threadCount == 0) {
+            threadCount = std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 4;
+        }
+
+        for (unsigned i = 0; i < threadCount; i++) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (unsigned i = 0; i < threadCount; i++) {
+            threads.emplace_back(&ThreadPool::WorkerLoop, this, (int)i);
+        }
+    }
+
+    ~ThreadPool() {
+        Wait();
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : threads) {
+            t.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned ThreadCount() const { return (unsigned)threads.size(); }
+
+    void Submit(std::function<void()> task) {
+        const int worker = WorkerIndex();
+        const size_t index = worker >= 0 && (size_t)worker < queues.size()
+            ? (size_t)worker
+            : nextQueue.fetch_add(1) % queues.size();
+
+        pending.fetch_add(1);
+        queued.fetch_add(1);
+        {
+            Queue& q = *queues[index];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+
+    // Blocks until every submitted task has finished, helping out meanwhile.
+    // Must not be called from inside a task.
+    void Wait() {
+        std::function<void()> task;
+        while (pending.load() > 0) {
+            if (TrySteal(0, task)) {
+                RunTask(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            idle.wait(lock, [this] { return pending.load() == 0; });
+        }
+    }
+};
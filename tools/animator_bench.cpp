@@ -0,0 +1,137 @@
+// Animator benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 tools/animator_bench.cpp -o animator_bench
+//
+//   animator_bench [--frames N]
+//
+// Runs the app's 0.15-per-frame hover fade and a spring through Animator
+// at 30, 60, 144 and 240 Hz, and reports where each is half a second in
+// and how long it takes to settle. Then times Update() over N frames for
+// 16 to 4096 values that keep moving. Checks that the curves agree across
+// refresh rates to within a frame, that one long step lands where many
+// short ones do, that the 60 Hz fade matches the per-frame lerp it
+// replaced, and that the spring never overshoots. Fails on any violation.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../animator.h"
+
+struct Curve {
+    const char* name;
+    Animator::Curve curve;
+    float rate;
+};
+
+int main(int argc, char** argv) {
+    int frames = 2000;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) frames = std::max(1, atoi(argv[++i]));
+        else {
+            fprintf(stderr, "usage: %s [--frames N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const Curve curves[] = { { "ease 0.15", Animator::Curve::Ease, 0.15f }, { "spring 12", Animator::Curve::Spring, 12.0f } };
+    const int rates[] = { 30, 60, 144, 240 };
+    int failures = 0;
+
+    printf("%-10s %6s %10s %10s %10s\n", "curve", "hz", "at 0.5s", "settled", "peak");
+    for (const Curve& curve : curves) {
+        float reference = -1.0f;
+        double referenceSettle = 0.0;
+        for (const int hz : rates) {
+            Animator animator;
+            const Animator::Handle handle = animator.Add(0.0f, curve.curve, curve.rate);
+            animator.SetTarget(handle, 1.0f);
+            const float dt = 1.0f / hz;
+            float atHalf = 0.0f, peak = 0.0f;
+            int frame = 0;
+            while (animator.Update(dt) && frame < 100000) {
+                frame++;
+                if (frame == hz / 2) atHalf = animator.Value(handle);
+                peak = std::max(peak, animator.Value(handle));
+            }
+            frame++;
+            const double settled = frame * (double)dt;
+            printf("%-10s %6d %10.5f %9.3fs %10.5f\n", curve.name, hz, atHalf, settled, peak);
+
+            if (reference < 0.0f) {
+                reference = atHalf;
+                referenceSettle = settled;
+            }
+            else if (fabsf(atHalf - reference) > 1e-3f || fabs(settled - referenceSettle) > 1.0 / 30.0 + 1e-9) {
+                fprintf(stderr, "%s at %d Hz: %.5f half a second in and settled at %.3fs; at %d Hz %.5f and %.3fs\n", curve.name, hz,
+                    atHalf, settled, rates[0], reference, referenceSettle);
+                failures++;
+            }
+            if (peak > 1.0f + 1.0f / 512.0f) {
+                fprintf(stderr, "%s at %d Hz overshot to %.5f\n", curve.name, hz, peak);
+                failures++;
+            }
+        }
+
+        // one 0.25 s step against fifteen 60 Hz ones
+        Animator longStep, shortSteps;
+        const Animator::Handle a = longStep.Add(0.0f, curve.curve, curve.rate);
+        const Animator::Handle b = shortSteps.Add(0.0f, curve.curve, curve.rate);
+        longStep.SetTarget(a, 1.0f);
+        shortSteps.SetTarget(b, 1.0f);
+        longStep.Update(0.25f);
+        for (int i = 0; i < 15; i++) shortSteps.Update(1.0f / 60.0f);
+        if (fabsf(longStep.Value(a) - shortSteps.Value(b)) > 1e-4f) {
+            fprintf(stderr, "%s: one 0.25 s step reached %.5f, fifteen short ones %.5f\n", curve.name, longStep.Value(a), shortSteps.Value(b));
+            failures++;
+        }
+    }
+
+    // the 60 Hz ease against the per-frame lerp the app used to run
+    {
+        Animator animator;
+        const Animator::Handle handle = animator.Add(0.0f, Animator::Curve::Ease, 0.15f);
+        animator.SetTarget(handle, 1.0f);
+        float lerp = 0.0f, worst = 0.0f;
+        for (int i = 0; i < 30; i++) {
+            animator.Update(1.0f / 60.0f);
+            lerp += (1.0f - lerp) * 0.15f;
+            worst = std::max(worst, fabsf(animator.Value(handle) - lerp));
+        }
+        if (worst > 1e-4f) {
+            fprintf(stderr, "60 Hz ease strays %.5f from the per-frame lerp\n", worst);
+            failures++;
+        }
+    }
+
+    printf("\n%8s %12s %12s\n", "values", "per update", "per value");
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (const int count : { 16, 256, 4096 }) {
+        Animator animator;
+        std::vector<Animator::Handle> handles;
+        for (int i = 0; i < count; i++) {
+            handles.push_back(animator.Add(unit(rng), i % 2 ? Animator::Curve::Spring : Animator::Curve::Ease, i % 2 ? 12.0f : 0.15f));
+        }
+        // new targets every 8 frames keep everything moving
+        const auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            if (f % 8 == 0) {
+                for (const Animator::Handle handle : handles) animator.SetTarget(handle, unit(rng) * 400.0f);
+            }
+            animator.Update(1.0f / 144.0f);
+        }
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / frames;
+        printf("%8d %10.0fns %10.2fns\n", count, ns, ns / count);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,155 @@
+// Atlas packing benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 tools/atlas_bench.cpp -o atlas_bench
+//
+//   atlas_bench [--images N] [--page SIZE] [--rounds N]
+//
+// Packs a synthetic mix of icon and card-art sized images, then churns the
+// set (remove a third, compact, add as many new ones) for a few rounds.
+// After every step each image is checked to sit inside its page without
+// overlapping another and to still hold its own pixels.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../texture_atlas.h"
+
+struct Image {
+    uint64_t key;
+    int width, height;
+    std::vector<uint8_t> rgba;
+};
+
+static uint32_t Next(uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+static Image MakeImage(uint64_t key, uint32_t& seed) {
+    // mostly icons, some product-card art
+    static const int sizes[][2] = { { 16, 16 }, { 24, 24 }, { 32, 32 }, { 48, 48 }, { 64, 64 }, { 96, 64 }, { 128, 72 }, { 160, 90 } };
+    const int* size = sizes[Next(seed) % 8];
+    Image image{ key, size[0] + (int)(Next(seed) % 5), size[1] + (int)(Next(seed) % 5), {} };
+    image.rgba.resize((size_t)image.width * image.height * 4);
+    for (size_t i = 0; i < image.rgba.size(); i++) image.rgba[i] = (uint8_t)(key * 31 + i * 7);
+    return image;
+}
+
+static int Validate(const TextureAtlas& atlas, const std::vector<Image>& images) {
+    int errors = 0;
+    const int size = atlas.PageSize();
+    std::vector<std::vector<uint8_t>> owner(atlas.PageCount(), std::vector<uint8_t>((size_t)size * size, 0));
+    for (const Image& image : images) {
+        const AtlasRegion* region = atlas.Find(image.key);
+        if (!region || region->width != image.width || region->height != image.height) {
+            errors++;
+            continue;
+        }
+        if (region->x < 0 || region->y < 0 || region->x + region->width > size || region->y + region->height > size) {
+            errors++;
+            continue;
+        }
+        const TextureAtlas::Page& page = atlas.GetPage(region->page);
+        for (int y = 0; y < region->height; y++) {
+            for (int x = 0; x < region->width; x++) {
+                uint8_t& mark = owner[region->page][(size_t)(region->y + y) * size + region->x + x];
+                if (mark) errors++;
+                mark = 1;
+            }
+            if (memcmp(&page.rgba[((size_t)(region->y + y) * size + region->x) * 4], &image.rgba[(size_t)y * image.width * 4],
+                (size_t)image.width * 4) != 0) {
+                errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+static double Ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int count = 400, pageSize = 1024, rounds = 5;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--images" && hasValue) count = atoi(argv[++i]);
+        else if (arg == "--page" && hasValue) pageSize = atoi(argv[++i]);
+        else if (arg == "--rounds" && hasValue) rounds = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--images N] [--page SIZE] [--rounds N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    uint32_t seed = 2024;
+    uint64_t nextKey = 1;
+    std::vector<Image> images;
+    for (int i = 0; i < count; i++) images.push_back(MakeImage(nextKey++, seed));
+
+    TextureAtlas atlas(pageSize);
+    auto start = std::chrono::steady_clock::now();
+    for (const Image& image : images) {
+        if (!atlas.Add(image.key, image.rgba.data(), image.width, image.height)) {
+            fprintf(stderr, "image %llu did not fit\n", (unsigned long long)image.key);
+            return 1;
+        }
+    }
+    const double packMs = Ms(start);
+
+    auto report = [&](const char* label, double ms) {
+        int64_t area = 0;
+        for (const Image& image : images) area += (int64_t)image.width * image.height;
+        const double fill = (double)area / ((double)atlas.PageCount() * pageSize * pageSize);
+        printf("%-12s %5zu images  %2zu pages (draw batches)  %5.1f%% filled  %7.2f ms\n", label, atlas.ImageCount(), atlas.PageCount(),
+            fill * 100.0, ms);
+    };
+    report("initial", packMs);
+    int errors = Validate(atlas, images);
+
+    for (int round = 0; round < rounds; round++) {
+        for (size_t p = 0; p < atlas.PageCount(); p++) {
+            AtlasRect dirty;
+            atlas.TakeDirty(p, dirty);
+        }
+
+        start = std::chrono::steady_clock::now();
+        const size_t churn = images.size() / 3;
+        for (size_t i = 0; i < churn; i++) {
+            const size_t victim = Next(seed) % images.size();
+            atlas.Remove(images[victim].key);
+            images[victim] = images.back();
+            images.pop_back();
+        }
+        const size_t repacked = atlas.Compact();
+        for (size_t i = 0; i < churn; i++) {
+            images.push_back(MakeImage(nextKey++, seed));
+            atlas.Add(images.back().key, images.back().rgba.data(), images.back().width, images.back().height);
+        }
+
+        // what an incremental upload would send, against re-sending every page
+        int64_t uploaded = 0;
+        for (size_t p = 0; p < atlas.PageCount(); p++) {
+            AtlasRect dirty;
+            if (atlas.TakeDirty(p, dirty)) uploaded += (int64_t)(dirty.x1 - dirty.x0) * (dirty.y1 - dirty.y0);
+        }
+        char label[32];
+        snprintf(label, sizeof(label), "churn %d", round + 1);
+        report(label, Ms(start));
+        printf("             %zu pages repacked, upload %.0f%% of the atlas\n", repacked,
+            100.0 * uploaded / ((double)atlas.PageCount() * pageSize * pageSize));
+        errors += Validate(atlas, images);
+    }
+
+    if (errors) {
+        fprintf(stderr, "%d placement errors\n", errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+// Block compression benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 -pthread tools/bc_bench.cpp -o bc_bench
+//
+//   bc_bench [--size WxH] [--min-time SEC] [--threads N]
+//
+// Encodes synthetic images with BcEncoder as BC1 (opaque), BC3 and BC7
+// (a smooth alpha pattern and a cut-out), single threaded and on a
+// ThreadPool, decodes the result and reports colour and alpha PSNR. Checks
+// each against a floor, that BC1 stays opaque and BC3 keeps alpha exactly
+// where a block holds no more than two alpha levels, as cut-outs do, and
+// that the pooled encode is byte for byte the serial one. Fails on any
+// violation.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../bc_encoder.h"
+#include "image_compare.h"
+
+using BcEncoder::Format;
+
+enum class Alpha { Opaque, Ramp, CutOut };
+
+// Gradients, a soft pattern and a little noise in colour. A CutOut's alpha
+// has at most two levels per 4x4 block: a round cut-out against a
+// per-block background level.
+static std::vector<uint8_t> MakeImage(int width, int height, Alpha alphaKind) {
+    std::vector<uint8_t> rgba((size_t)width * height * 4);
+    uint32_t seed = 2024;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            uint8_t* p = &rgba[((size_t)y * width + x) * 4];
+            p[0] = (uint8_t)(x * 255 / std::max(1, width - 1));
+            p[1] = (uint8_t)(y * 255 / std::max(1, height - 1));
+            p[2] = (uint8_t)std::clamp(128.0f + 90.0f * sinf(x * 0.03f + y * 0.02f) + (float)(seed >> 29), 0.0f, 255.0f);
+            if (alphaKind == Alpha::Opaque) {
+                p[3] = 255;
+            }
+            else if (alphaKind == Alpha::Ramp) {
+                p[3] = (uint8_t)(128.0f + 127.0f * sinf(x * 0.09f) * cosf(y * 0.07f));
+            }
+            else {
+                const int dx = x - width / 2, dy = y - height / 2, radius = std::min(width, height) / 3;
+                const bool inside = dx * dx + dy * dy < radius * radius;
+                p[3] = inside ? 255 : (uint8_t)((x / 4 * 37 + y / 4 * 11) & 0x7f);
+            }
+        }
+    }
+    return rgba;
+}
+
+template<typename Body>
+static double MedianMs(double minTime, Body&& body) {
+    std::vector<double> samples;
+    const auto begin = std::chrono::steady_clock::now();
+    while (samples.size() < 3 || std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() < minTime) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// Alpha PSNR on its own: the fourth channel moved into the first
+static double AlphaPsnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    std::vector<uint8_t> alphaA(a.size()), alphaB(b.size());
+    for (size_t i = 0; i < a.size(); i += 4) {
+        alphaA[i] = a[i + 3];
+        alphaB[i] = b[i + 3];
+    }
+    return ImageCompare::Psnr(alphaA, alphaB, 1);
+}
+
+int main(int argc, char** argv) {
+    int width = 512, height = 512;
+    double minTime = 0.5;
+    unsigned threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) sscanf(argv[++i], "%dx%d", &width, &height);
+        else if (arg == "--min-time" && hasValue) minTime = atof(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--size WxH] [--min-time SEC] [--threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (width < 1 || height < 1) {
+        fprintf(stderr, "bad --size %dx%d\n", width, height);
+        return 2;
+    }
+
+    struct Case {
+        const char* name;
+        Format format;
+        Alpha alpha;
+        double colorFloor;  // dB over RGB
+        double alphaFloor;  // dB over A; 0 skips
+        bool exactAlpha;
+    };
+    const Case cases[] = {
+        { "bc1", Format::BC1, Alpha::Opaque, 38.0, 0.0, true },
+        { "bc3", Format::BC3, Alpha::Ramp, 38.0, 44.0, false },
+        { "bc3 cut-out", Format::BC3, Alpha::CutOut, 38.0, 0.0, true },
+        { "bc7", Format::BC7, Alpha::Ramp, 40.0, 43.0, false },
+        { "bc7 cut-out", Format::BC7, Alpha::CutOut, 40.0, 50.0, false },
+    };
+
+    ThreadPool pool(threads);
+    int failures = 0;
+
+    printf("%dx%d, %u pool threads\n", width, height, pool.ThreadCount());
+    printf("%-12s %10s %10s %8s %10s %10s\n", "format", "1 thread", "pool", "MP/s", "rgb", "alpha");
+    for (const Case& test : cases) {
+        const std::vector<uint8_t> image = MakeImage(width, height, test.alpha);
+        std::vector<uint8_t> serial, pooled;
+        const double serialMs = MedianMs(minTime, [&] { serial = BcEncoder::Encode(image.data(), width, height, test.format); });
+        const double pooledMs = MedianMs(minTime, [&] { pooled = BcEncoder::Encode(image.data(), width, height, test.format, &pool); });
+
+        const std::vector<uint8_t> decoded = BcEncoder::Decode(serial.data(), width, height, test.format);
+        const double color = ImageCompare::Psnr(image, decoded, 3);
+        const double alpha = AlphaPsnr(image, decoded);
+        printf("%-12s %8.2fms %8.2fms %8.1f %7.1f dB %7.1f dB\n", test.name, serialMs, pooledMs,
+            (double)width * height / (pooledMs / 1000.0) / 1e6, color, alpha);
+
+        if (serial.size() != BcEncoder::CompressedSize(test.format, width, height)) {
+            fprintf(stderr, "%s: %zu bytes, expected %zu\n", test.name, serial.size(), BcEncoder::CompressedSize(test.format, width, height));
+            failures++;
+        }
+        if (serial != pooled) {
+            size_t at = 0;
+            while (at < std::min(serial.size(), pooled.size()) && serial[at] == pooled[at]) at++;
+            fprintf(stderr, "%s: pooled encode differs from serial at byte %zu\n", test.name, at);
+            failures++;
+        }
+        if (color < test.colorFloor) {
+            fprintf(stderr, "%s: colour %.1f dB, below the %.1f dB floor\n", test.name, color, test.colorFloor);
+            failures++;
+        }
+        if (alpha < test.alphaFloor) {
+            fprintf(stderr, "%s: alpha %.1f dB, below the %.1f dB floor\n", test.name, alpha, test.alphaFloor);
+            failures++;
+        }
+        if (test.exactAlpha) {
+            size_t wrong = 0, first = 0;
+            for (size_t i = 3; i < image.size(); i += 4) {
+                if (decoded[i] != image[i] && !wrong++) first = i / 4;
+            }
+            if (wrong) {
+                fprintf(stderr, "%s: alpha changed at %zu pixels, first at (%zu, %zu): %d became %d\n", test.name, wrong,
+                    first % width, first / width, image[first * 4 + 3], decoded[first * 4 + 3]);
+                failures++;
+            }
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+// Background blur benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 -pthread tools/blur_bench.cpp -o blur_bench
+//
+//   blur_bench [--size WxH] [--min-time SEC] [--threads N]
+//
+// Checks ImageBlur::Gaussian against a direct 2D convolution in double
+// precision, then times it at full resolution for a range of sigmas, single
+// threaded and on a ThreadPool. Finally times ImageBlur::Blur, which runs
+// wide blurs on a reduced copy, and compares its bilinear upscale against
+// the same blur done at full resolution.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../image_blur.h"
+#include "image_compare.h"
+
+static std::vector<uint8_t> MakeImage(int width, int height) {
+    std::vector<uint8_t> rgba((size_t)width * height * 4);
+    uint32_t seed = 99;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            uint8_t* p = &rgba[((size_t)y * width + x) * 4];
+            p[0] = (uint8_t)(x * 255 / width);
+            p[1] = ((x / 6 + y / 6) % 2) ? 220 : 30;
+            p[2] = (uint8_t)(128 + 90 * sinf(x * 0.03f) * cosf(y * 0.05f) + (seed >> 28));
+            p[3] = 255;
+        }
+    }
+    return rgba;
+}
+
+// Largest difference between Gaussian() and a direct 2D sum with clamped edges
+static double CheckReference(float sigma) {
+    const int width = 64, height = 48;
+    const std::vector<uint8_t> rgba = MakeImage(width, height);
+    const ImageResample::LinearImage source = ImageResample::ToLinear(rgba.data(), width, height, true);
+    ImageResample::LinearImage blurred = source;
+    ImageBlur::Gaussian(blurred, sigma);
+
+    const int radius = (int)ceilf(sigma * 3.0f);
+    double total = 0.0;
+    for (int k = -radius; k <= radius; k++) total += exp(-0.5 * k * k / ((double)sigma * sigma));
+
+    double worst = 0.0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double sum[4] = {};
+            for (int dy = -radius; dy <= radius; dy++) {
+                for (int dx = -radius; dx <= radius; dx++) {
+                    const double w = exp(-0.5 * (dx * dx + dy * dy) / ((double)sigma * sigma)) / (total * total);
+                    const float* p = source.Row(std::clamp(y + dy, 0, height - 1)) + std::clamp(x + dx, 0, width - 1) * 4;
+                    for (int c = 0; c < 4; c++) sum[c] += p[c] * w;
+                }
+            }
+            for (int c = 0; c < 4; c++) worst = std::max(worst, fabs(sum[c] - blurred.Row(y)[x * 4 + c]));
+        }
+    }
+    return worst;
+}
+
+// Bilinear upscale of an RGBA8 image, texel centres aligned like the GPU's
+static std::vector<uint8_t> Upscale(const ImageResample::Level& level, int width, int height) {
+    std::vector<uint8_t> out((size_t)width * height * 4);
+    for (int y = 0; y < height; y++) {
+        const float fy = std::clamp((y + 0.5f) * level.height / height - 0.5f, 0.0f, (float)level.height - 1);
+        const int y0 = (int)fy, y1 = std::min(y0 + 1, level.height - 1);
+        for (int x = 0; x < width; x++) {
+            const float fx = std::clamp((x + 0.5f) * level.width / width - 0.5f, 0.0f, (float)level.width - 1);
+            const int x0 = (int)fx, x1 = std::min(x0 + 1, level.width - 1);
+            for (int c = 0; c < 4; c++) {
+                auto at = [&](int px, int py) { return (float)level.rgba[((size_t)py * level.width + px) * 4 + c]; };
+                const float top = at(x0, y0) + (at(x1, y0) - at(x0, y0)) * (fx - x0);
+                const float bottom = at(x0, y1) + (at(x1, y1) - at(x0, y1)) * (fx - x0);
+                out[((size_t)y * width + x) * 4 + c] = (uint8_t)lrintf(top + (bottom - top) * (fy - y0));
+            }
+        }
+    }
+    return out;
+}
+
+template<typename Body>
+static double MedianMs(double minTime, Body&& body) {
+    std::vector<double> samples;
+    const auto begin = std::chrono::steady_clock::now();
+    while (samples.size() < 3 || std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() < minTime) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    int width = 604, height = 400;
+    double minTime = 0.5;
+    unsigned threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) sscanf(argv[++i], "%dx%d", &width, &height);
+        else if (arg == "--min-time" && hasValue) minTime = atof(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--size WxH] [--min-time SEC] [--threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int failures = 0;
+    for (float sigma : { 1.0f, 2.5f, 6.0f }) {
+        const double worst = CheckReference(sigma);
+        printf("sigma %4.1f vs direct 2D sum: max error %.2e\n", sigma, worst);
+        if (worst > 1e-5) failures++;
+    }
+
+    const std::vector<uint8_t> image = MakeImage(width, height);
+    ThreadPool pool(threads);
+    const ImageResample::LinearImage linear = ImageResample::ToLinear(image.data(), width, height, true);
+
+    printf("\n%dx%d, %u pool threads\n", width, height, pool.ThreadCount());
+    printf("%-16s %10s %10s %10s\n", "full resolution", "1 thread", "pool", "MP/s");
+    for (float sigma : { 2.0f, 4.0f, 8.0f, 16.0f }) {
+        ImageResample::LinearImage work;
+        const double serial = MedianMs(minTime, [&] { work = linear; ImageBlur::Gaussian(work, sigma); });
+        const double pooled = MedianMs(minTime, [&] { work = linear; ImageBlur::Gaussian(work, sigma, &pool); });
+        char label[32];
+        snprintf(label, sizeof(label), "sigma %.0f", sigma);
+        printf("%-16s %8.2fms %8.2fms %10.1f\n", label, serial, pooled, (double)width * height / (pooled / 1000.0) / 1e6);
+    }
+
+    printf("\n%-16s %10s %10s %10s %10s\n", "Blur (8-bit)", "1 thread", "pool", "size", "vs full");
+    for (float sigma : { 3.0f, 6.0f, 12.0f, 24.0f }) {
+        ImageResample::Level level;
+        const double serial = MedianMs(minTime, [&] { level = ImageBlur::Blur(image.data(), width, height, sigma); });
+        const double pooled = MedianMs(minTime, [&] { level = ImageBlur::Blur(image.data(), width, height, sigma, true, &pool); });
+
+        ImageResample::LinearImage full = linear;
+        ImageBlur::Gaussian(full, sigma, &pool);
+        std::vector<uint8_t> reference(image.size());
+        ImageResample::FromLinear(full, true, reference.data(), &pool);
+        const double psnr = ImageCompare::Psnr(Upscale(level, width, height), reference);
+
+        char label[32], size[32];
+        snprintf(label, sizeof(label), "sigma %.0f", sigma);
+        snprintf(size, sizeof(size), "%dx%d", level.width, level.height);
+        printf("%-16s %8.2fms %8.2fms %10s %7.1f dB\n", label, serial, pooled, size, psnr);
+        if (psnr < 35.0) failures++;
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,126 @@
+// Simulation clock check
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 tools/clock_bench.cpp -o clock_bench
+//
+//   clock_bench [--seeds N]
+//
+// Runs the app's timed sequences (the 2.5 second loading page and the
+// 6 second launch notification) on SimClock in each mode, against a
+// platform clock whose frames take a random 5 to 40 ms with an occasional
+// 2 second stall. Reports the frames each sequence takes. Checks that Real
+// keeps to wall time apart from capped stalls, that FixedStep takes the
+// same frames for every seed, and that Manual gets to the end of either
+// sequence in one frame. Fails on any violation.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "../sim_clock.h"
+
+struct Run {
+    int frames{ 0 };
+    double wallSeconds{ 0.0 };
+    double largestStep{ 0.0 };
+};
+
+// Ticks until the clock has moved duration past its first frame, as the
+// app measures elapsed time from the frame that starts a sequence
+static Run RunSequence(SimClock& clock, double duration, unsigned seed, bool stalls) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> frameTime(0.005, 0.040);
+    std::uniform_int_distribution<int> stall(0, 99);
+    Run run;
+    double wall = 0.0;
+    clock.Tick(wall);
+    const double start = clock.Now();
+    while (clock.Now() - start < duration && run.frames < 100000) {
+        wall += stalls && stall(rng) == 0 ? 2.0 : frameTime(rng);
+        if (clock.GetOptions().mode == SimClock::Mode::Manual) clock.Advance(duration);
+        const double before = clock.Now();
+        clock.Tick(wall);
+        run.largestStep = std::max(run.largestStep, clock.Now() - before);
+        run.frames++;
+    }
+    run.wallSeconds = wall;
+    return run;
+}
+
+static const char* ModeName(SimClock::Mode mode) {
+    switch (mode) {
+    case SimClock::Mode::Real: return "real";
+    case SimClock::Mode::FixedStep: return "fixed";
+    default: return "manual";
+    }
+}
+
+int main(int argc, char** argv) {
+    int seeds = 20;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--seeds" && hasValue) seeds = std::max(1, atoi(argv[++i]));
+        else {
+            fprintf(stderr, "usage: %s [--seeds N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    struct Sequence {
+        const char* name;
+        double duration;
+    };
+    const Sequence sequences[] = { { "loading", 2.5 }, { "notification", 6.0 } };
+    int failures = 0;
+
+    printf("%-13s %-7s %10s %10s %12s %12s %10s\n", "sequence", "mode", "min frames", "max frames", "wall (max)", "largest step", "time");
+    for (const Sequence& sequence : sequences) {
+        for (const SimClock::Mode mode : { SimClock::Mode::Real, SimClock::Mode::FixedStep, SimClock::Mode::Manual }) {
+            SimClock::Options options;
+            options.mode = mode;
+            int minFrames = 1 << 30, maxFrames = 0;
+            double maxWall = 0.0, largestStep = 0.0;
+            const auto start = std::chrono::steady_clock::now();
+            for (int seed = 1; seed <= seeds; seed++) {
+                SimClock clock(options);
+                const Run run = RunSequence(clock, sequence.duration, (unsigned)seed, true);
+                minFrames = std::min(minFrames, run.frames);
+                maxFrames = std::max(maxFrames, run.frames);
+                maxWall = std::max(maxWall, run.wallSeconds);
+                largestStep = std::max(largestStep, run.largestStep);
+
+                // without stalls, Real ends within a frame of wall time
+                SimClock smooth(options);
+                const Run calm = RunSequence(smooth, sequence.duration, (unsigned)seed, false);
+                if (mode == SimClock::Mode::Real && fabs(calm.wallSeconds - sequence.duration) > 0.040 + 1e-9) {
+                    fprintf(stderr, "%s real: ended %.3f s of wall time in, expected %.1f\n", sequence.name, calm.wallSeconds, sequence.duration);
+                    failures++;
+                }
+            }
+            const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / (2.0 * seeds);
+            printf("%-13s %-7s %10d %10d %11.2fs %11.3fs %8.2fus\n", sequence.name, ModeName(mode), minFrames, maxFrames, maxWall,
+                largestStep, us);
+
+            if (mode == SimClock::Mode::Real && largestStep > options.maxStep + 1e-9) {
+                fprintf(stderr, "%s real: a %.3f s step, above the %.2f s cap\n", sequence.name, largestStep, options.maxStep);
+                failures++;
+            }
+            const int fixedFrames = (int)std::ceil(sequence.duration / options.step - 1e-6);
+            if (mode == SimClock::Mode::FixedStep && (minFrames != maxFrames || std::abs(minFrames - fixedFrames) > 1)) {
+                fprintf(stderr, "%s fixed: %d to %d frames, expected %d for every seed\n", sequence.name, minFrames, maxFrames, fixedFrames);
+                failures++;
+            }
+            if (mode == SimClock::Mode::Manual && maxFrames != 1) {
+                fprintf(stderr, "%s manual: %d frames, expected 1\n", sequence.name, maxFrames);
+                failures++;
+            }
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,190 @@
+// DDS and KTX2 container check
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 tools/container_check.cpp -o container_check
+//
+//   container_check [--fixtures DIR]
+//
+// Parses the fixtures in tools/fixtures with TextureContainer and checks
+// the format, size, premultiplied flag and every mip level's offset, size
+// and pitch. Then checks that parsing fails, with the expected reason, for
+// every truncated prefix of each file and for copies patched to carry a
+// bad mip count, an array, a cube map, a volume or KTX2 supercompression.
+// Fails on any violation.
+//
+// The fixtures are a 16x8 image with a round cut-out, five levels each:
+//   bc3_dx10_premultiplied.dds  texture_pack --format bc3 --premultiply
+//   bc7_premultiplied.ktx2      texture_pack --format bc7 --premultiply
+//   dxt1_legacy.dds             texture_pack --format bc1, with the DX10
+//                               header removed and FourCC set to DXT1
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../texture_container.h"
+
+using TextureContainer::Format;
+using Bytes = std::vector<unsigned char>;
+
+struct Expected {
+    const char* file;
+    Format format;
+    bool premultiplied;
+    uint32_t width;
+    uint32_t height;
+    std::vector<size_t> offsets;
+    std::vector<size_t> sizes;
+};
+
+// A copy of a fixture with one 32-bit field replaced or OR-ed in
+struct Patch {
+    const char* file;
+    const char* name;
+    size_t offset;
+    uint32_t value;
+    bool orIn;
+    const char* reason;  // nullptr when the copy should still parse
+};
+
+static int failures = 0;
+
+static bool ReadFile(const std::string& path, Bytes& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static void Fail(const char* file, const char* what) {
+    fprintf(stderr, "%s: %s\n", file, what);
+    failures++;
+}
+
+static void CheckLayout(const Expected& expected, const TextureContainer::Layout& layout) {
+    char what[160];
+    if (layout.format != expected.format) Fail(expected.file, "wrong format");
+    if (layout.srgb) Fail(expected.file, "reported as sRGB");
+    if (layout.premultiplied != expected.premultiplied) Fail(expected.file, "wrong premultiplied flag");
+    if (layout.width != expected.width || layout.height != expected.height) {
+        snprintf(what, sizeof(what), "%ux%u, expected %ux%u", layout.width, layout.height, expected.width, expected.height);
+        Fail(expected.file, what);
+    }
+    if (layout.levels.size() != expected.offsets.size()) {
+        snprintf(what, sizeof(what), "%zu levels, expected %zu", layout.levels.size(), expected.offsets.size());
+        Fail(expected.file, what);
+        return;
+    }
+    for (size_t i = 0; i < layout.levels.size(); i++) {
+        const TextureContainer::MipLevel& level = layout.levels[i];
+        const uint32_t width = std::max(1u, expected.width >> i), height = std::max(1u, expected.height >> i);
+        if (level.offset != expected.offsets[i] || level.size != expected.sizes[i] || level.width != width || level.height != height ||
+            level.rowPitch != TextureContainer::RowPitch(expected.format, width)) {
+            snprintf(what, sizeof(what), "level %zu at %zu, %zu bytes, %ux%u, pitch %u; expected %zu, %zu bytes, %ux%u", i, level.offset,
+                level.size, level.width, level.height, level.rowPitch, expected.offsets[i], expected.sizes[i], width, height);
+            Fail(expected.file, what);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string directory = "tools/fixtures";
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--fixtures" && hasValue) directory = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--fixtures DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const Expected fixtures[] = {
+        { "dxt1_legacy.dds", Format::BC1, false, 16, 8, { 128, 192, 208, 216, 224 }, { 64, 16, 8, 8, 8 } },
+        { "bc3_dx10_premultiplied.dds", Format::BC3, true, 16, 8, { 148, 276, 308, 324, 340 }, { 128, 32, 16, 16, 16 } },
+        // KTX2 stores the smallest level first
+        { "bc7_premultiplied.ktx2", Format::BC7, true, 16, 8, { 336, 304, 288, 272, 256 }, { 128, 32, 16, 16, 16 } },
+    };
+
+    // DDS: mip count at 28, caps2 at 112, DX10 misc flags at 136, array size at 140, alpha mode at 144.
+    // KTX2: layers at 32, faces at 36, levels at 40, supercompression at 44, level index from 80,
+    // descriptor model and flags at 212.
+    const char* singleDds = "DDS must hold a single 2D texture";
+    const char* singleKtx2 = "KTX2 must hold a single 2D texture";
+    const Patch patches[] = {
+        { "dxt1_legacy.dds", "6 mips", 28, 6, false, "bad mip count" },
+        { "dxt1_legacy.dds", "cube map", 112, 0x200, true, "DDS cube maps and volumes are not supported" },
+        { "dxt1_legacy.dds", "volume", 112, 0x200000, true, "DDS cube maps and volumes are not supported" },
+        { "dxt1_legacy.dds", "unknown FourCC", 84, TextureContainer::FourCC('A', 'B', 'C', 'D'), false, "unsupported DDS FourCC" },
+        { "bc3_dx10_premultiplied.dds", "6 mips", 28, 6, false, "bad mip count" },
+        { "bc3_dx10_premultiplied.dds", "cube map", 112, 0x200, true, "DDS cube maps and volumes are not supported" },
+        { "bc3_dx10_premultiplied.dds", "DX10 cube flag", 136, 0x4, true, singleDds },
+        { "bc3_dx10_premultiplied.dds", "array of 2", 140, 2, false, singleDds },
+        { "bc3_dx10_premultiplied.dds", "3D dimension", 132, 4, false, singleDds },
+        { "bc3_dx10_premultiplied.dds", "straight alpha", 144, 0, false, nullptr },
+        { "bc7_premultiplied.ktx2", "6 levels", 40, 6, false, "bad mip count" },
+        { "bc7_premultiplied.ktx2", "array of 2", 32, 2, false, singleKtx2 },
+        { "bc7_premultiplied.ktx2", "cube map", 36, 6, false, singleKtx2 },
+        { "bc7_premultiplied.ktx2", "depth 2", 28, 2, false, singleKtx2 },
+        { "bc7_premultiplied.ktx2", "BasisLZ", 44, 1, false, "KTX2 supercompression is not supported" },
+        { "bc7_premultiplied.ktx2", "Zstandard", 44, 2, false, "KTX2 supercompression is not supported" },
+        { "bc7_premultiplied.ktx2", "short level 0", 88, 64, false, "KTX2 level has the wrong size" },
+        { "bc7_premultiplied.ktx2", "level 0 past the end", 80, 400, false, "KTX2 truncated" },
+        { "bc7_premultiplied.ktx2", "straight alpha", 212, 134 | 1 << 8 | 1 << 16, false, nullptr },
+    };
+
+    std::vector<Bytes> files;
+    printf("%-28s %6s %7s %8s %10s\n", "fixture", "bytes", "levels", "prefixes", "patches");
+    for (const Expected& expected : fixtures) {
+        Bytes data;
+        if (!ReadFile(directory + "/" + expected.file, data)) {
+            Fail(expected.file, "cannot read");
+            continue;
+        }
+
+        TextureContainer::Layout layout;
+        const char* reason = "";
+        if (TextureContainer::Parse(data.data(), data.size(), layout, reason)) CheckLayout(expected, layout);
+        else Fail(expected.file, reason);
+
+        // every byte of the file belongs to the header or a level, so any shorter prefix must fail
+        int prefixes = 0;
+        for (size_t size = 0; size < data.size(); size++) {
+            const Bytes prefix(data.begin(), data.begin() + size);
+            TextureContainer::Layout partial;
+            if (TextureContainer::Parse(prefix.data(), prefix.size(), partial, reason)) {
+                char what[64];
+                snprintf(what, sizeof(what), "parsed when cut to %zu bytes", size);
+                Fail(expected.file, what);
+            }
+            prefixes++;
+        }
+
+        int patched = 0;
+        for (const Patch& patch : patches) {
+            if (strcmp(patch.file, expected.file) != 0) continue;
+            Bytes copy = data;
+            const uint32_t value = patch.orIn ? TextureContainer::Read32(&copy[patch.offset]) | patch.value : patch.value;
+            memcpy(&copy[patch.offset], &value, 4);
+            TextureContainer::Layout result;
+            reason = "";
+            const bool parsed = TextureContainer::Parse(copy.data(), copy.size(), result, reason);
+            char what[160];
+            if (patch.reason && (parsed || strcmp(reason, patch.reason) != 0)) {
+                snprintf(what, sizeof(what), "%s: %s, expected \"%s\"", patch.name, parsed ? "parsed" : reason, patch.reason);
+                Fail(expected.file, what);
+            }
+            else if (!patch.reason && (!parsed || result.premultiplied)) {
+                snprintf(what, sizeof(what), "%s: %s", patch.name, parsed ? "still premultiplied" : reason);
+                Fail(expected.file, what);
+            }
+            patched++;
+        }
+        printf("%-28s %6zu %7zu %8d %10d\n", expected.file, data.size(), layout.levels.size(), prefixes, patched);
+    }
+    return failures ? 1 : 0;
+}
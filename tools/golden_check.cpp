@@ -0,0 +1,247 @@
+// Golden image check of every screen
+//
+// Standalone Linux tool. It needs ImGui's core sources (no backends) and
+// is built from the repository root with, IMGUI being the ImGui v1.91.3
+// checkout described in README.md:
+//   g++ -O2 -std=c++17 -pthread -I $IMGUI tools/golden_check.cpp $IMGUI/imgui*.cpp -o golden_check
+//
+//   golden_check [--golden DIR] [--update] [--assets DIR]... [--threshold T] [--max-diff FRACTION]
+//                [--threads N] [--only NAME]
+//
+// Drives ImGuiApp on HeadlessPlatform through each screen in turn: login,
+// loading, the products list, a product's page, the launch notification
+// and the updates page. It renders every frame with SoftwareRenderer.
+// Time is virtual and every texture is loaded before the script starts,
+// so each screen renders the same pixels on every run. Each screen is
+// held for a while once reached; the tool reports the p50 and max of its
+// frame time and the rasterizer time of its last frame.
+//
+// The last frame is compared to DIR/NAME.png (default tools/golden). The
+// comparison is perceptual, as pixelmatch does it: two pixels differ when
+// their YIQ distance, blended over white, exceeds T (0 to 1, default 0.1)
+// of the largest possible. A screen fails when more than FRACTION of its
+// pixels differ (default 0.001), which absorbs edge antialiasing that
+// moved slightly. A failure writes NAME-actual.png and NAME-diff.png next
+// to the golden; the diff greys the frame and marks differing pixels red.
+// A missing golden is a failure too. --update writes every golden from
+// this run instead of comparing, creating DIR if needed. Without DIR the
+// tool stops before rendering: the goldens depend on the ImGui version and
+// the fonts, so they are made with --update on the machine that checks.
+// Exits 1 if any screen fails.
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../headless.h"
+#include "../software_renderer.h"
+#include "../app.h"
+#include "png_write.h"
+
+struct Screen {
+    const char* name;
+    int settleFrames;  // frames from its first input until it is held; the golden is the last held frame
+    std::function<void(HeadlessPlatform&, int)> input;
+};
+
+struct Result {
+    std::vector<double> frameMs;
+    double rasterMs{ 0.0 };
+    size_t differing{ 0 };
+    size_t pixels{ 0 };
+    const char* status{ "ok" };
+};
+
+static double Percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+}
+
+// pixelmatch's colour distance: YIQ with Y weighted most, after blending
+// both pixels over white so transparency differences count
+static float ColorDelta(const uint8_t* a, const uint8_t* b) {
+    auto blend = [](uint8_t c, uint8_t alpha) { return 255.0f + (c - 255.0f) * (alpha / 255.0f); };
+    const float r1 = blend(a[0], a[3]), g1 = blend(a[1], a[3]), b1 = blend(a[2], a[3]);
+    const float r2 = blend(b[0], b[3]), g2 = blend(b[1], b[3]), b2 = blend(b[2], b[3]);
+    const float y = (r1 - r2) * 0.29889531f + (g1 - g2) * 0.58662247f + (b1 - b2) * 0.11448223f;
+    const float i = (r1 - r2) * 0.59597799f - (g1 - g2) * 0.27417610f - (b1 - b2) * 0.32180189f;
+    const float q = (r1 - r2) * 0.21147017f - (g1 - g2) * 0.52261711f + (b1 - b2) * 0.31114694f;
+    return 0.5053f * y * y + 0.299f * i * i + 0.1957f * q * q;
+}
+
+// Counts differing pixels and fills diff with the frame greyed and faded,
+// differing pixels in red
+static size_t Compare(const uint8_t* actual, const uint8_t* expected, size_t pixels, float threshold, std::vector<uint8_t>& diff) {
+    const float maxDelta = 35215.0f * threshold * threshold;
+    diff.resize(pixels * 4);
+    size_t differing = 0;
+    for (size_t p = 0; p < pixels; p++) {
+        const uint8_t* a = actual + p * 4;
+        uint8_t* d = diff.data() + p * 4;
+        if (ColorDelta(a, expected + p * 4) > maxDelta) {
+            differing++;
+            d[0] = 255;
+            d[1] = d[2] = 0;
+        }
+        else {
+            const float luma = a[0] * 0.29889531f + a[1] * 0.58662247f + a[2] * 0.11448223f;
+            d[0] = d[1] = d[2] = (uint8_t)(255.0f + (luma - 255.0f) * 0.1f * (a[3] / 255.0f));
+        }
+        d[3] = 255;
+    }
+    return differing;
+}
+
+int main(int argc, char** argv) {
+    HeadlessPlatform::Options options;
+    options.assetDirectories.clear();
+    std::string goldenDir = "tools/golden";
+    bool update = false;
+    float threshold = 0.1f;
+    double maxDiff = 0.001;
+    unsigned threads = 0;
+    std::string only;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--golden" && hasValue) goldenDir = argv[++i];
+        else if (arg == "--update") update = true;
+        else if (arg == "--assets" && hasValue) options.assetDirectories.push_back(argv[++i]);
+        else if (arg == "--threshold" && hasValue) threshold = std::clamp((float)atof(argv[++i]), 0.0f, 1.0f);
+        else if (arg == "--max-diff" && hasValue) maxDiff = std::max(0.0, atof(argv[++i]));
+        else if (arg == "--threads" && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else if (arg == "--only" && hasValue) only = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--golden DIR] [--update] [--assets DIR]... [--threshold T] [--max-diff FRACTION]\n"
+                "       [--threads N] [--only NAME]\n",
+                argv[0]);
+            return 2;
+        }
+    }
+    if (options.assetDirectories.empty()) options.assetDirectories = { "assets/fonts", "assets/images" };
+
+    // Each screen starts where the previous one was left
+    const std::vector<Screen> screens = {
+        { "login", 30, nullptr },
+        { "loading", 90, [](HeadlessPlatform& platform, int i) {
+            switch (i) {
+            case 0: platform.Click(200.0f, 190.0f); break;
+            case 4: platform.Type("admin"); break;
+            case 10: platform.Click(200.0f, 262.0f); break;
+            case 14: platform.Type("123"); break;
+            case 20: platform.Key(ImGuiKey_Enter, true); break;
+            case 22: platform.Key(ImGuiKey_Enter, false); break;
+            }
+        } },
+        // the loading screen lasts 2.5 seconds, then the window widens
+        { "products", 240, [](HeadlessPlatform& platform, int i) { if (i == 0) platform.MoveMouse(300.0f, 390.0f); } },
+        { "product", 60, [](HeadlessPlatform& platform, int i) { if (i == 0) platform.Click(535.0f, 97.0f); } },
+        // 1.1 seconds into the first of its 1.5 second stages, slid in and not yet fading
+        { "notification", 36, [](HeadlessPlatform& platform, int i) { if (i == 0) platform.Click(535.0f, 367.0f); } },
+        // the notification runs for 6 seconds
+        { "updates", 360, [](HeadlessPlatform& platform, int i) { if (i == 300) platform.Click(40.0f, 105.0f); } },
+    };
+    constexpr int HoldFrames = 30;
+
+    std::error_code ec;
+    if (update) {
+        std::filesystem::create_directories(goldenDir, ec);
+    }
+    else if (!std::filesystem::is_directory(goldenDir, ec)) {
+        fprintf(stderr, "no goldens in %s; write them with --update first\n", goldenDir.c_str());
+        return 1;
+    }
+
+    HeadlessPlatform platform(options);
+    SoftwareRenderer renderer(threads);
+    ImGuiApp app(platform, renderer);
+    if (!app.Initialize()) {
+        fprintf(stderr, "initialization failed\n");
+        return 1;
+    }
+
+    // Loads finish on worker threads; a texture arriving mid-script would
+    // change the screens it lands in from run to run
+    const auto loadStart = std::chrono::steady_clock::now();
+    do {
+        app.Frame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } while (app.PendingTextures() > 0 && std::chrono::steady_clock::now() - loadStart < std::chrono::seconds(30));
+    if (app.PendingTextures() > 0) {
+        fprintf(stderr, "textures still loading after 30 seconds\n");
+        return 1;
+    }
+
+    int failures = 0;
+    printf("%-14s %9s %9s %11s %10s  %s\n", "screen", "p50", "max", "raster", "differing", "status");
+    for (const Screen& screen : screens) {
+        Result result;
+        for (int i = 0; i < screen.settleFrames + HoldFrames; i++) {
+            if (screen.input && i < screen.settleFrames) screen.input(platform, i);
+            const auto start = std::chrono::steady_clock::now();
+            app.Frame();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (i >= screen.settleFrames) result.frameMs.push_back(ms);
+        }
+        // unchanged frames are not rasterized again, so this is the frame on screen
+        const SoftRaster::Stats& raster = renderer.LastStats();
+        result.rasterMs = raster.setupMs + raster.rasterMs;
+
+        const int width = renderer.Width(), height = renderer.Height();
+        result.pixels = (size_t)width * height;
+        const std::string golden = goldenDir + "/" + screen.name + ".png";
+        if (!only.empty() && only != screen.name) {
+            result.status = "skipped";
+        }
+        else if (update) {
+            result.status = Png::Write(golden, renderer.Pixels(), width, height) ? "updated" : "can't write";
+            if (strcmp(result.status, "updated") != 0) failures++;
+        }
+        else {
+            int goldenWidth = 0, goldenHeight = 0, channels = 0;
+            stbi_uc* expected = stbi_load(golden.c_str(), &goldenWidth, &goldenHeight, &channels, 4);
+            if (!expected) result.status = "no golden";
+            else if (goldenWidth != width || goldenHeight != height) result.status = "size differs";
+            else {
+                std::vector<uint8_t> diff;
+                result.differing = Compare(renderer.Pixels(), expected, result.pixels, threshold, diff);
+                if (result.differing > maxDiff * result.pixels) {
+                    result.status = "differs";
+                    Png::Write(goldenDir + "/" + screen.name + "-diff.png", diff.data(), width, height);
+                }
+            }
+            stbi_image_free(expected);
+            if (strcmp(result.status, "ok") != 0) {
+                Png::Write(goldenDir + "/" + screen.name + "-actual.png", renderer.Pixels(), width, height);
+                fprintf(stderr, "%s: %s; rerun with --update if the change is intended\n", screen.name, result.status);
+                failures++;
+            }
+        }
+
+        printf("%-14s %7.3fms %7.3fms %9.3fms %9.3f%%  %s\n", screen.name, Percentile(result.frameMs, 0.5),
+            Percentile(result.frameMs, 1.0), result.rasterMs, 100.0 * result.differing / std::max<size_t>(1, result.pixels), result.status);
+    }
+
+    // the menu window is wider than the login one
+    if (platform.GetWindowRect().width <= 400) {
+        fprintf(stderr, "the script did not get past the login page\n");
+        failures++;
+    }
+    app.Cleanup();
+    if (renderer.LiveTextures() != 0) {
+        fprintf(stderr, "%zu textures still alive after cleanup\n", renderer.LiveTextures());
+        failures++;
+    }
+    return failures ? 1 : 0;
+}
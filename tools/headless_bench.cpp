@@ -0,0 +1,195 @@
+// Headless UI benchmark
+//
+// Standalone Linux tool. It needs ImGui's core sources (no backends) and
+// is built from the repository root with, IMGUI being the ImGui v1.91.3
+// checkout described in README.md:
+//   g++ -O2 -std=c++17 -pthread -I $IMGUI tools/headless_bench.cpp $IMGUI/imgui*.cpp -o headless_bench
+//
+//   headless_bench [--assets DIR]... [--repeat N] [--resize exact|buckets|maximum]
+//                  [--software [--threads N] [--ppm PREFIX]] [--capture FILE]
+//
+// Runs ImGuiApp on HeadlessPlatform and NullRenderer through a fixed
+// script: the login page idle, typing the credentials, the loading screen,
+// then the menu with the mouse sweeping over it, a product opened and
+// launched. Time is virtual (60 steps a second), so every run draws the same
+// frames. Reports the CPU cost of each phase's frames, what they submitted,
+// what fingerprinting the draw data cost and how many frames it found
+// identical to the one before, which a renderer skips, and the swapchain
+// reallocations its resizes would cost under the --resize policy (maximum
+// by default, as main.cpp uses). With --software the frames are also
+// rasterized by SoftwareRenderer, whose share of the frame time is
+// reported, and --ppm writes each phase's last frame to PREFIX-N.ppm.
+// --capture records the first run's frames for tools/replay_bench.
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../headless.h"
+#include "../software_renderer.h"
+#include "../capture_renderer.h"
+#include "../app.h"
+
+struct Phase {
+    const char* name{ nullptr };
+    std::vector<double> frameMs;
+    std::vector<double> rasterMs;
+    std::vector<double> hashMs;
+    int skipped{ 0 };
+    uint64_t reallocations{ 0 };
+    double vertices{ 0.0 };
+    double commands{ 0.0 };
+    int width{ 0 };
+};
+
+static void WritePpm(const std::string& path, const uint8_t* rgba, int width, int height) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return;
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    for (size_t i = 0; i < (size_t)width * height; i++) fwrite(rgba + i * 4, 1, 3, file);
+    fclose(file);
+}
+
+static double Percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+}
+
+int main(int argc, char** argv) {
+    HeadlessPlatform::Options options;
+    options.assetDirectories.clear();
+    int repeat = 1;
+    bool software = false;
+    unsigned threads = 0;
+    std::string ppmPrefix;
+    std::string capturePath;
+    ResizePolicy::Options resize;
+    resize.mode = ResizePolicy::Mode::Maximum;
+    resize.maxWidth = ImGuiApp::LargestWindowWidth;
+    resize.maxHeight = ImGuiApp::LargestWindowHeight;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--assets" && hasValue) options.assetDirectories.push_back(argv[++i]);
+        else if (arg == "--repeat" && hasValue) repeat = std::max(1, atoi(argv[++i]));
+        else if (arg == "--software") software = true;
+        else if (arg == "--threads" && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else if (arg == "--ppm" && hasValue) ppmPrefix = argv[++i];
+        else if (arg == "--capture" && hasValue) capturePath = argv[++i];
+        else if (arg == "--resize" && hasValue && !strcmp(argv[i + 1], "exact")) { resize.mode = ResizePolicy::Mode::Exact; i++; }
+        else if (arg == "--resize" && hasValue && !strcmp(argv[i + 1], "buckets")) { resize.mode = ResizePolicy::Mode::Buckets; i++; }
+        else if (arg == "--resize" && hasValue && !strcmp(argv[i + 1], "maximum")) { resize.mode = ResizePolicy::Mode::Maximum; i++; }
+        else {
+            fprintf(stderr, "usage: %s [--assets DIR]... [--repeat N] [--resize exact|buckets|maximum] [--software [--threads N] [--ppm PREFIX]]\n"
+                "       [--capture FILE]\n",
+                argv[0]);
+            return 2;
+        }
+    }
+    if (options.assetDirectories.empty()) options.assetDirectories = { "assets/fonts", "assets/images" };
+
+    std::vector<Phase> phases;
+    int failures = 0;
+    for (int run = 0; run < repeat; run++) {
+        HeadlessPlatform platform(options);
+        NullRenderer nullRenderer(true, resize);
+        std::unique_ptr<SoftwareRenderer> softwareRenderer;
+        if (software) softwareRenderer = std::make_unique<SoftwareRenderer>(threads);
+        IRenderer& backend = software ? (IRenderer&)*softwareRenderer : nullRenderer;
+        std::unique_ptr<CaptureRenderer> capture;
+        if (!capturePath.empty() && run == 0) capture = std::make_unique<CaptureRenderer>(backend, capturePath);
+        IRenderer& renderer = capture ? (IRenderer&)*capture : backend;
+        ImGuiApp app(platform, renderer);
+        if (!app.Initialize()) {
+            fprintf(stderr, "initialization failed\n");
+            return 1;
+        }
+
+        size_t phaseIndex = 0;
+        auto frames = [&](const char* name, int count, const std::function<void(int)>& input = nullptr) {
+            if (phases.size() <= phaseIndex) {
+                phases.emplace_back();
+                phases.back().name = name;
+            }
+            Phase& phase = phases[phaseIndex++];
+            const uint64_t reallocationsBefore = nullRenderer.ResizeStats().reallocations;
+            for (int i = 0; i < count; i++) {
+                if (input) input(i);
+                const auto start = std::chrono::steady_clock::now();
+                app.Frame();
+                phase.frameMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                const ImDrawData* data = ImGui::GetDrawData();
+                phase.vertices += data->TotalVtxCount;
+                for (int l = 0; l < data->CmdListsCount; l++) phase.commands += data->CmdLists[l]->CmdBuffer.Size;
+                const DrawFingerprint::Stats& fingerprint = software ? softwareRenderer->FingerprintStats() : nullRenderer.FingerprintStats();
+                phase.hashMs.push_back(fingerprint.lastHashMs);
+                phase.skipped += fingerprint.lastSkipped;
+                if (software) {
+                    const SoftRaster::Stats& raster = softwareRenderer->LastStats();
+                    phase.rasterMs.push_back(fingerprint.lastSkipped ? 0.0 : raster.setupMs + raster.rasterMs);
+                }
+            }
+            phase.width = platform.GetWindowRect().width;
+            phase.reallocations += nullRenderer.ResizeStats().reallocations - reallocationsBefore;
+            if (software && !ppmPrefix.empty() && run == 0) {
+                WritePpm(ppmPrefix + "-" + std::to_string(phaseIndex) + ".ppm", softwareRenderer->Pixels(), softwareRenderer->Width(), softwareRenderer->Height());
+            }
+        };
+
+        frames("login idle", 60, [&](int i) { platform.MoveMouse(40.0f + i * 5.0f, 320.0f); });
+        frames("login typing", 30, [&](int i) {
+            switch (i) {
+            case 0: platform.Click(200.0f, 190.0f); break;
+            case 4: platform.Type("admin"); break;
+            case 10: platform.Click(200.0f, 262.0f); break;
+            case 14: platform.Type("123"); break;
+            case 20: platform.Key(ImGuiKey_Enter, true); break;
+            case 22: platform.Key(ImGuiKey_Enter, false); break;
+            }
+        });
+        frames("loading", 180);
+        frames("menu hover", 120, [&](int i) { platform.MoveMouse(40.0f + (i % 60) * 9.0f, 80.0f + (i / 60) * 150.0f); });
+        frames("product page", 60, [&](int i) { if (i == 0) platform.Click(535.0f, 97.0f); });
+        frames("launching", 420, [&](int i) { if (i == 0) platform.Click(535.0f, 367.0f); });
+
+        // the menu window is wider than the login one
+        if (phases[2].width <= 400) {
+            fprintf(stderr, "the script did not get past the login page\n");
+            failures++;
+        }
+        app.Cleanup();
+        if (capture) {
+            printf("captured %llu frames (%llu repeated) in %.2f MB, %.2f MB before compression\n", (unsigned long long)capture->Frames(),
+                (unsigned long long)capture->RepeatedFrames(), capture->Bytes() / 1048576.0, capture->RawBytes() / 1048576.0);
+        }
+        const size_t liveTextures = software ? softwareRenderer->LiveTextures() : nullRenderer.LiveTextures();
+        if (liveTextures != 0) {
+            fprintf(stderr, "%zu textures still alive after cleanup\n", liveTextures);
+            failures++;
+        }
+    }
+
+    printf("%-14s %7s %9s %9s %9s %10s %9s %6s %9s %8s", "phase", "frames", "p50", "p95", "max", "vertices", "commands", "width",
+        "hash p50", "skipped");
+    printf(software ? " %12s\n" : " %8s\n", software ? "raster p50" : "reallocs");
+    for (const Phase& phase : phases) {
+        const double count = (double)phase.frameMs.size();
+        printf("%-14s %7zu %7.3fms %7.3fms %7.3fms %10.0f %9.1f %6d", phase.name, phase.frameMs.size(),
+            Percentile(phase.frameMs, 0.5), Percentile(phase.frameMs, 0.95), Percentile(phase.frameMs, 1.0),
+            phase.vertices / count, phase.commands / count, phase.width);
+        printf(" %7.3fms %7.1f%%", Percentile(phase.hashMs, 0.5), 100.0 * phase.skipped / count);
+        if (software) printf(" %10.3fms\n", Percentile(phase.rasterMs, 0.5));
+        else printf(" %8.1f\n", (double)phase.reallocations / repeat);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,1384 @@
+// Image decoder benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 -pthread tools/image_bench.cpp -o image_bench
+//
+// Generates a synthetic corpus (PNG at every colour type and bit depth,
+// baseline and progressive JPEG, GIF, HDR, BMP, TGA, PSD, QOI), optionally
+// adds every file from --corpus DIR along with a QOI transcode of it, and
+// reports per-image throughput, peak heap use and allocation counts for
+// stb_image. Lossless entries are checked against their source pixels.
+// Then decodes the whole selection with DecodeBatch, on one pool thread
+// and on --threads (default every core), checking that results come back
+// in order, and reports the wall time of each and the speedup.
+//
+//   image_bench [--size WxH] [--min-time SEC] [--filter TEXT] [--corpus DIR]
+//               [--save-baseline FILE] [--baseline FILE] [--tolerance PCT]
+//               [--threads N]
+//
+// With --baseline, any entry whose megapixels/s fell more than --tolerance
+// percent (default 10) below the stored value is reported and the process
+// exits with status 1.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Counting allocator so we can report the peak heap footprint of a decode;
+// atomic because the batch decode runs on several threads at once
+namespace BenchAlloc {
+    constexpr size_t HeaderSize = 16;
+    std::atomic<size_t> live{ 0 };
+    std::atomic<size_t> peak{ 0 };
+
+    void RaisePeak(size_t now) {
+        size_t seen = peak;
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+    }
+
+    void* Malloc(size_t size) {
+        unsigned char* p = (unsigned char*)malloc(size + HeaderSize);
+        if (!p) return nullptr;
+        *(size_t*)p = size;
+        RaisePeak(live += size);
+        return p + HeaderSize;
+    }
+
+    void Free(void* ptr) {
+        if (!ptr) return;
+        unsigned char* p = (unsigned char*)ptr - HeaderSize;
+        live -= *(size_t*)p;
+        free(p);
+    }
+
+    void* Realloc(void* ptr, size_t size) {
+        if (!ptr) return Malloc(size);
+        unsigned char* p = (unsigned char*)ptr - HeaderSize;
+        const size_t old = *(size_t*)p;
+        unsigned char* q = (unsigned char*)realloc(p, size + HeaderSize);
+        if (!q) return nullptr;
+        *(size_t*)q = size;
+        RaisePeak(live += size - old);
+        return q + HeaderSize;
+    }
+}
+
+#define STBI_MALLOC(sz)       BenchAlloc::Malloc(sz)
+#define STBI_REALLOC(p, sz)   BenchAlloc::Realloc(p, sz)
+#define STBI_FREE(p)          BenchAlloc::Free(p)
+#define STB_IMAGE_IMPLEMENTATION
+#include "../stb_image.h"
+#include "../image_decode.h"
+#include "qoi_write.h"
+
+using Bytes = std::vector<uint8_t>;
+
+// Byte and bit writers
+struct ByteWriter {
+    Bytes data;
+
+    void Put8(int v) { data.push_back((uint8_t)v); }
+    void Put16BE(int v) { Put8(v >> 8); Put8(v); }
+    void Put16LE(int v) { Put8(v); Put8(v >> 8); }
+    void Put32BE(uint32_t v) { Put16BE(v >> 16); Put16BE(v & 0xffff); }
+    void Put32LE(uint32_t v) { Put16LE(v & 0xffff); Put16LE(v >> 16); }
+    void Put(const void* p, size_t n) { data.insert(data.end(), (const uint8_t*)p, (const uint8_t*)p + n); }
+    void Put(const char* s) { Put(s, strlen(s)); }
+    void Put(const Bytes& b) { Put(b.data(), b.size()); }
+};
+
+// LSB-first bit packing, as used by deflate and GIF LZW
+struct BitWriterLsb {
+    Bytes& out;
+    uint32_t acc{ 0 };
+    int count{ 0 };
+
+    explicit BitWriterLsb(Bytes& o) : out(o) {}
+
+    void Put(uint32_t bits, int n) {
+        acc |= bits << count;
+        count += n;
+        while (count >= 8) {
+            out.push_back((uint8_t)acc);
+            acc >>= 8;
+            count -= 8;
+        }
+    }
+
+    void Flush() {
+        if (count > 0) out.push_back((uint8_t)acc);
+        acc = 0;
+        count = 0;
+    }
+};
+
+// Synthetic content: gradients, waves, hard-edged shapes and a little noise,
+// so every format sees a realistic mix of flat runs, edges and texture
+struct SourceImage {
+    int width{ 0 };
+    int height{ 0 };
+    std::vector<uint16_t> rgba;  // 16 bits per channel
+
+    uint16_t At(int x, int y, int c) const { return rgba[((size_t)y * width + x) * 4 + c]; }
+    uint8_t At8(int x, int y, int c) const { return (uint8_t)(At(x, y, c) >> 8); }
+};
+
+static SourceImage MakeSource(int width, int height) {
+    SourceImage img;
+    img.width = width;
+    img.height = height;
+    img.rgba.resize((size_t)width * height * 4);
+
+    uint32_t seed = 12345;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            const float fx = (float)x / width;
+            const float fy = (float)y / height;
+            const float noise = ((seed >> 24) & 15) / 15.0f - 0.5f;
+            const bool inBox = ((x / 64) + (y / 48)) % 3 == 0;
+
+            float r = fx;
+            float g = fy;
+            float b = 0.5f + 0.5f * sinf(fx * 12.0f) * cosf(fy * 9.0f);
+            if (inBox) {
+                r = 0.9f;
+                g = 0.2f;
+                b = 0.2f;
+            }
+            else {
+                r += noise * 0.03f;
+                g += noise * 0.03f;
+            }
+            const float a = ((x / 32 + y / 32) % 4 == 0) ? 0.5f + 0.5f * fx : 1.0f;
+
+            const float v[4] = { r, g, b, a };
+            for (int c = 0; c < 4; c++) {
+                const float clamped = std::min(1.0f, std::max(0.0f, v[c]));
+                img.rgba[((size_t)y * width + x) * 4 + c] = (uint16_t)lrintf(clamped * 65535.0f);
+            }
+        }
+    }
+    return img;
+}
+
+static uint8_t Luma8(const SourceImage& img, int x, int y) {
+    return (uint8_t)((img.At8(x, y, 0) * 77 + img.At8(x, y, 1) * 150 + img.At8(x, y, 2) * 29) >> 8);
+}
+
+// zlib stream: fixed-Huffman deflate with a small hash-chain LZ77 matcher
+namespace Deflate {
+    constexpr int LengthBase[29] = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258 };
+    constexpr int LengthExtra[29] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+    constexpr int DistBase[30] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+    constexpr int DistExtra[30] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+
+    static uint32_t Reverse(uint32_t code, int len) {
+        uint32_t r = 0;
+        for (int i = 0; i < len; i++) {
+            r = (r << 1) | ((code >> i) & 1);
+        }
+        return r;
+    }
+
+    static void PutLiteral(BitWriterLsb& bw, int sym) {
+        if (sym < 144) bw.Put(Reverse(0x30 + sym, 8), 8);
+        else if (sym < 256) bw.Put(Reverse(0x190 + sym - 144, 9), 9);
+        else if (sym < 280) bw.Put(Reverse(sym - 256, 7), 7);
+        else bw.Put(Reverse(0xc0 + sym - 280, 8), 8);
+    }
+
+    static void PutMatch(BitWriterLsb& bw, int length, int dist) {
+        int li = 28;
+        while (LengthBase[li] > length) li--;
+        PutLiteral(bw, 257 + li);
+        bw.Put(length - LengthBase[li], LengthExtra[li]);
+
+        int di = 29;
+        while (DistBase[di] > dist) di--;
+        bw.Put(Reverse(di, 5), 5);
+        bw.Put(dist - DistBase[di], DistExtra[di]);
+    }
+
+    static Bytes Zlib(const Bytes& in) {
+        Bytes out = { 0x78, 0x01 };
+        BitWriterLsb bw(out);
+        bw.Put(1, 1);  // final block
+        bw.Put(1, 2);  // fixed Huffman
+
+        constexpr int HashBits = 15;
+        constexpr int Window = 32768;
+        std::vector<int> head(1 << HashBits, -1);
+        std::vector<int> prev(in.size(), -1);
+        const int n = (int)in.size();
+
+        auto hash = [&](int i) {
+            return ((in[i] << 10) ^ (in[i + 1] << 5) ^ in[i + 2]) & ((1 << HashBits) - 1);
+        };
+
+        int i = 0;
+        while (i < n) {
+            int bestLen = 0, bestDist = 0;
+            if (i + 2 < n) {
+                const int h = hash(i);
+                int cand = head[h];
+                for (int chain = 0; chain < 16 && cand >= 0 && i - cand <= Window; chain++) {
+                    int len = 0;
+                    while (len < 258 && i + len < n && in[cand + len] == in[i + len]) len++;
+                    if (len > bestLen) {
+                        bestLen = len;
+                        bestDist = i - cand;
+                    }
+                    cand = prev[cand];
+                }
+                prev[i] = head[h];
+                head[h] = i;
+            }
+
+            if (bestLen >= 3) {
+                PutMatch(bw, bestLen, bestDist);
+                for (int k = 1; k < bestLen; k++) {
+                    if (i + k + 2 < n) {
+                        const int h = hash(i + k);
+                        prev[i + k] = head[h];
+                        head[h] = i + k;
+                    }
+                }
+                i += bestLen;
+            }
+            else {
+                PutLiteral(bw, in[i]);
+                i++;
+            }
+        }
+        PutLiteral(bw, 256);
+        bw.Flush();
+
+        uint32_t a = 1, b = 0;
+        for (uint8_t v : in) {
+            a = (a + v) % 65521;
+            b = (b + a) % 65521;
+        }
+        ByteWriter w;
+        w.data = std::move(out);
+        w.Put32BE((b << 16) | a);
+        return std::move(w.data);
+    }
+}
+
+// PNG
+namespace Png {
+    static uint32_t Crc(const uint8_t* p, size_t n, uint32_t crc = 0xffffffffu) {
+        static uint32_t table[256];
+        static bool ready = false;
+        if (!ready) {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                table[i] = c;
+            }
+            ready = true;
+        }
+        for (size_t i = 0; i < n; i++) crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+        return crc;
+    }
+
+    static void Chunk(ByteWriter& w, const char* type, const Bytes& data) {
+        w.Put32BE((uint32_t)data.size());
+        const size_t start = w.data.size();
+        w.Put(type, 4);
+        w.Put(data);
+        w.Put32BE(Crc(w.data.data() + start, data.size() + 4) ^ 0xffffffffu);
+    }
+
+    static int Channels(int colorType) {
+        switch (colorType) {
+        case 0: return 1;
+        case 2: return 3;
+        case 3: return 1;
+        case 4: return 2;
+        default: return 4;
+        }
+    }
+
+    static uint8_t Paeth(int a, int b, int c) {
+        const int p = a + b - c;
+        const int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+        if (pa <= pb && pa <= pc) return (uint8_t)a;
+        return (uint8_t)(pb <= pc ? b : c);
+    }
+
+    // Encodes 'img' at the given colour type and depth. 'expected' receives the
+    // RGBA8 pixels stb should produce for it.
+    static Bytes Encode(const SourceImage& img, int colorType, int depth, Bytes& expected) {
+        const int w = img.width, h = img.height;
+        const int channels = Channels(colorType);
+        const int bitsPerPixel = channels * depth;
+        const size_t rowBytes = ((size_t)w * bitsPerPixel + 7) / 8;
+        const int filterBpp = std::max(1, bitsPerPixel / 8);
+        const int maxValue = (1 << depth) - 1;
+
+        expected.assign((size_t)w * h * 4, 0);
+        std::vector<Bytes> rows(h, Bytes(rowBytes, 0));
+        for (int y = 0; y < h; y++) {
+            Bytes& row = rows[y];
+            for (int x = 0; x < w; x++) {
+                uint16_t samples[4];
+                uint8_t* ex = &expected[((size_t)y * w + x) * 4];
+                if (colorType == 0 || colorType == 3 || colorType == 4) {
+                    const uint16_t luma = (uint16_t)(Luma8(img, x, y) * 257);
+                    samples[0] = (uint16_t)(luma >> (16 - depth));
+                    samples[1] = (uint16_t)(img.At(x, y, 3) >> (16 - depth));
+                    uint8_t g8;
+                    if (colorType == 3) {
+                        g8 = (uint8_t)(samples[0] * 255 / maxValue);
+                    }
+                    else if (depth == 16) {
+                        g8 = (uint8_t)(samples[0] >> 8);
+                    }
+                    else {
+                        g8 = (uint8_t)(samples[0] * (255 / maxValue));
+                    }
+                    ex[0] = ex[1] = ex[2] = g8;
+                    ex[3] = colorType == 4 ? (uint8_t)(depth == 16 ? samples[1] >> 8 : samples[1]) : 255;
+                }
+                else {
+                    for (int c = 0; c < channels; c++) {
+                        samples[c] = (uint16_t)(img.At(x, y, c) >> (16 - depth));
+                        ex[c] = (uint8_t)(depth == 16 ? samples[c] >> 8 : samples[c]);
+                    }
+                    if (channels == 3) ex[3] = 255;
+                }
+
+                for (int c = 0; c < channels; c++) {
+                    const size_t bit = (size_t)x * bitsPerPixel + (size_t)c * depth;
+                    if (depth == 16) {
+                        row[bit / 8] = (uint8_t)(samples[c] >> 8);
+                        row[bit / 8 + 1] = (uint8_t)samples[c];
+                    }
+                    else if (depth == 8) {
+                        row[bit / 8] = (uint8_t)samples[c];
+                    }
+                    else {
+                        row[bit / 8] |= (uint8_t)(samples[c] << (8 - depth - bit % 8));
+                    }
+                }
+            }
+        }
+
+        // Cycle through all five filter types so every unfilter path runs
+        Bytes raw;
+        raw.reserve((rowBytes + 1) * h);
+        Bytes zero(rowBytes, 0);
+        for (int y = 0; y < h; y++) {
+            const Bytes& cur = rows[y];
+            const Bytes& up = y > 0 ? rows[y - 1] : zero;
+            const int filter = y % 5;
+            raw.push_back((uint8_t)filter);
+            for (size_t i = 0; i < rowBytes; i++) {
+                const int a = i >= (size_t)filterBpp ? cur[i - filterBpp] : 0;
+                const int b = up[i];
+                const int c = i >= (size_t)filterBpp ? up[i - filterBpp] : 0;
+                int pred = 0;
+                switch (filter) {
+                case 1: pred = a; break;
+                case 2: pred = b; break;
+                case 3: pred = (a + b) / 2; break;
+                case 4: pred = Paeth(a, b, c); break;
+                }
+                raw.push_back((uint8_t)(cur[i] - pred));
+            }
+        }
+
+        ByteWriter out;
+        const uint8_t signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+        out.Put(signature, 8);
+
+        ByteWriter ihdr;
+        ihdr.Put32BE(img.width);
+        ihdr.Put32BE(img.height);
+        ihdr.Put8(depth);
+        ihdr.Put8(colorType);
+        ihdr.Put8(0);
+        ihdr.Put8(0);
+        ihdr.Put8(0);
+        Chunk(out, "IHDR", ihdr.data);
+
+        if (colorType == 3) {
+            ByteWriter plte;
+            for (int i = 0; i <= maxValue; i++) {
+                const uint8_t v = (uint8_t)(i * 255 / maxValue);
+                plte.Put8(v);
+                plte.Put8(v);
+                plte.Put8(v);
+            }
+            Chunk(out, "PLTE", plte.data);
+        }
+
+        Chunk(out, "IDAT", Deflate::Zlib(raw));
+        Chunk(out, "IEND", {});
+        return std::move(out.data);
+    }
+}
+
+// GIF89a with a 6x7x6 colour cube and LZW compression
+namespace Gif {
+    static Bytes Encode(const SourceImage& img, Bytes& expected) {
+        const int w = img.width, h = img.height;
+        uint8_t palette[256][3] = {};
+        for (int i = 0; i < 252; i++) {
+            palette[i][0] = (uint8_t)((i / 42) * 51);
+            palette[i][1] = (uint8_t)(((i / 6) % 7) * 255 / 6);
+            palette[i][2] = (uint8_t)((i % 6) * 51);
+        }
+
+        std::vector<int> indices((size_t)w * h);
+        expected.resize((size_t)w * h * 4);
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                const int r = (img.At8(x, y, 0) * 5 + 127) / 255;
+                const int g = (img.At8(x, y, 1) * 6 + 127) / 255;
+                const int b = (img.At8(x, y, 2) * 5 + 127) / 255;
+                const int index = r * 42 + g * 6 + b;
+                indices[(size_t)y * w + x] = index;
+                uint8_t* ex = &expected[((size_t)y * w + x) * 4];
+                ex[0] = palette[index][0];
+                ex[1] = palette[index][1];
+                ex[2] = palette[index][2];
+                ex[3] = 255;
+            }
+        }
+
+        ByteWriter out;
+        out.Put("GIF89a");
+        out.Put16LE(w);
+        out.Put16LE(h);
+        out.Put8(0xf7);
+        out.Put8(0);
+        out.Put8(0);
+        out.Put(palette, sizeof(palette));
+        out.Put8(0x2c);
+        out.Put16LE(0);
+        out.Put16LE(0);
+        out.Put16LE(w);
+        out.Put16LE(h);
+        out.Put8(0);
+
+        constexpr int MinCodeSize = 8;
+        constexpr int ClearCode = 1 << MinCodeSize;
+        Bytes codes;
+        BitWriterLsb bw(codes);
+        std::vector<int16_t> dict(4096 * 256, -1);
+        int codeSize = MinCodeSize + 1;
+        int maxCode = ClearCode + 1;
+
+        bw.Put(ClearCode, codeSize);
+        int cur = indices[0];
+        for (size_t i = 1; i < indices.size(); i++) {
+            const int next = indices[i];
+            int16_t& slot = dict[(size_t)cur * 256 + next];
+            if (slot >= 0) {
+                cur = slot;
+                continue;
+            }
+            bw.Put(cur, codeSize);
+            slot = (int16_t)++maxCode;
+            if (maxCode >= (1 << codeSize)) codeSize++;
+            if (maxCode == 4095) {
+                bw.Put(ClearCode, codeSize);
+                std::fill(dict.begin(), dict.end(), -1);
+                codeSize = MinCodeSize + 1;
+                maxCode = ClearCode + 1;
+            }
+            cur = next;
+        }
+        bw.Put(cur, codeSize);
+        bw.Put(ClearCode + 1, codeSize);
+        bw.Flush();
+
+        out.Put8(MinCodeSize);
+        for (size_t i = 0; i < codes.size(); i += 255) {
+            const size_t n = std::min<size_t>(255, codes.size() - i);
+            out.Put8((int)n);
+            out.Put(codes.data() + i, n);
+        }
+        out.Put8(0);
+        out.Put8(0x3b);
+        return std::move(out.data);
+    }
+}
+
+// Radiance HDR with new-style per-channel RLE scanlines
+namespace Hdr {
+    static void RleChannel(ByteWriter& w, const uint8_t* data, int n) {
+        int i = 0;
+        while (i < n) {
+            int run = 1;
+            while (i + run < n && run < 127 && data[i + run] == data[i]) run++;
+            if (run >= 4) {
+                w.Put8(128 + run);
+                w.Put8(data[i]);
+                i += run;
+                continue;
+            }
+            int lit = 0;
+            while (i + lit < n && lit < 128) {
+                int ahead = 1;
+                while (i + lit + ahead < n && ahead < 4 && data[i + lit + ahead] == data[i + lit]) ahead++;
+                if (ahead >= 4) break;
+                lit++;
+            }
+            w.Put8(lit);
+            w.Put(data + i, lit);
+            i += lit;
+        }
+    }
+
+    static Bytes Encode(const SourceImage& img) {
+        const int w = img.width, h = img.height;
+        ByteWriter out;
+        char header[128];
+        snprintf(header, sizeof(header), "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y %d +X %d\n", h, w);
+        out.Put(header);
+
+        std::vector<uint8_t> planes[4];
+        for (auto& p : planes) p.resize(w);
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                float rgb[3];
+                for (int c = 0; c < 3; c++) rgb[c] = img.At(x, y, c) / 65535.0f * 4.0f;
+                const float m = std::max(rgb[0], std::max(rgb[1], rgb[2]));
+                if (m < 1e-32f) {
+                    for (auto& p : planes) p[x] = 0;
+                    continue;
+                }
+                int e;
+                const float scale = frexpf(m, &e) * 256.0f / m;
+                for (int c = 0; c < 3; c++) planes[c][x] = (uint8_t)(rgb[c] * scale);
+                planes[3][x] = (uint8_t)(e + 128);
+            }
+            out.Put8(2);
+            out.Put8(2);
+            out.Put8(w >> 8);
+            out.Put8(w & 0xff);
+            for (auto& p : planes) RleChannel(out, p.data(), w);
+        }
+        return std::move(out.data);
+    }
+}
+
+// BMP (8-bit palettised, 24-bit and 32-bit, bottom-up)
+namespace Bmp {
+    static Bytes Encode(const SourceImage& img, int bpp, Bytes& expected) {
+        const int w = img.width, h = img.height;
+        const int paletteBytes = bpp == 8 ? 1024 : 0;
+        const size_t stride = (((size_t)w * bpp / 8) + 3) & ~(size_t)3;
+        const uint32_t offset = 54 + paletteBytes;
+
+        ByteWriter out;
+        out.Put("BM");
+        out.Put32LE((uint32_t)(offset + stride * h));
+        out.Put32LE(0);
+        out.Put32LE(offset);
+        out.Put32LE(40);
+        out.Put32LE(w);
+        out.Put32LE(h);
+        out.Put16LE(1);
+        out.Put16LE(bpp);
+        out.Put32LE(0);
+        out.Put32LE((uint32_t)(stride * h));
+        out.Put32LE(2835);
+        out.Put32LE(2835);
+        out.Put32LE(bpp == 8 ? 256 : 0);
+        out.Put32LE(0);
+        if (bpp == 8) {
+            for (int i = 0; i < 256; i++) {
+                out.Put8(i);
+                out.Put8(i);
+                out.Put8(i);
+                out.Put8(0);
+            }
+        }
+
+        expected.resize((size_t)w * h * 4);
+        for (int y = h - 1; y >= 0; y--) {
+            const size_t start = out.data.size();
+            for (int x = 0; x < w; x++) {
+                uint8_t* ex = &expected[((size_t)y * w + x) * 4];
+                if (bpp == 8) {
+                    const uint8_t g = Luma8(img, x, y);
+                    out.Put8(g);
+                    ex[0] = ex[1] = ex[2] = g;
+                    ex[3] = 255;
+                    continue;
+                }
+                out.Put8(img.At8(x, y, 2));
+                out.Put8(img.At8(x, y, 1));
+                out.Put8(img.At8(x, y, 0));
+                for (int c = 0; c < 3; c++) ex[c] = img.At8(x, y, c);
+                ex[3] = 255;
+                if (bpp == 32) {
+                    out.Put8(img.At8(x, y, 3));
+                    ex[3] = img.At8(x, y, 3);
+                }
+            }
+            while (out.data.size() - start < stride) out.Put8(0);
+        }
+        return std::move(out.data);
+    }
+}
+
+// TGA (uncompressed 24-bit, RLE 32-bit, top-left origin)
+namespace Tga {
+    static Bytes Encode(const SourceImage& img, int bpp, bool rle, Bytes& expected) {
+        const int w = img.width, h = img.height;
+        const int bytesPerPixel = bpp / 8;
+        ByteWriter out;
+        out.Put8(0);
+        out.Put8(0);
+        out.Put8(rle ? 10 : 2);
+        for (int i = 0; i < 5; i++) out.Put8(0);
+        out.Put16LE(0);
+        out.Put16LE(0);
+        out.Put16LE(w);
+        out.Put16LE(h);
+        out.Put8(bpp);
+        out.Put8(0x20 | (bpp == 32 ? 8 : 0));
+
+        expected.resize((size_t)w * h * 4);
+        std::vector<uint32_t> row(w);
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                uint8_t* ex = &expected[((size_t)y * w + x) * 4];
+                for (int c = 0; c < 4; c++) ex[c] = img.At8(x, y, c);
+                if (bpp == 24) ex[3] = 255;
+                row[x] = ex[2] | (ex[1] << 8) | (ex[0] << 16) | ((uint32_t)ex[3] << 24);
+            }
+
+            auto putPixel = [&](uint32_t p) { out.Put(&p, bytesPerPixel); };
+            if (!rle) {
+                for (uint32_t p : row) putPixel(p);
+                continue;
+            }
+
+            int x = 0;
+            while (x < w) {
+                int run = 1;
+                while (x + run < w && run < 128 && row[x + run] == row[x]) run++;
+                if (run >= 2) {
+                    out.Put8(0x80 | (run - 1));
+                    putPixel(row[x]);
+                    x += run;
+                    continue;
+                }
+                int lit = 1;
+                while (x + lit < w && lit < 128 && !(x + lit + 1 < w && row[x + lit + 1] == row[x + lit])) lit++;
+                out.Put8(lit - 1);
+                for (int i = 0; i < lit; i++) putPixel(row[x + i]);
+                x += lit;
+            }
+        }
+        return std::move(out.data);
+    }
+}
+
+// PSD (RGBA, 8 bits, raw or PackBits)
+namespace Psd {
+    static void PackBits(Bytes& out, const uint8_t* data, int n) {
+        int i = 0;
+        while (i < n) {
+            int run = 1;
+            while (i + run < n && run < 128 && data[i + run] == data[i]) run++;
+            if (run >= 3) {
+                out.push_back((uint8_t)(257 - run));
+                out.push_back(data[i]);
+                i += run;
+                continue;
+            }
+            int lit = 0;
+            while (i + lit < n && lit < 128) {
+                if (i + lit + 2 < n && data[i + lit] == data[i + lit + 1] && data[i + lit] == data[i + lit + 2]) break;
+                lit++;
+            }
+            out.push_back((uint8_t)(lit - 1));
+            out.insert(out.end(), data + i, data + i + lit);
+            i += lit;
+        }
+    }
+
+    // stb removes Photoshop's white matte from translucent pixels, so the
+    // alpha plane is written opaque to keep the output exactly comparable
+    static uint8_t Sample(const SourceImage& img, int x, int y, int c) {
+        return c == 3 ? 255 : img.At8(x, y, c);
+    }
+
+    static Bytes Encode(const SourceImage& img, bool rle, Bytes& expected) {
+        const int w = img.width, h = img.height;
+        ByteWriter out;
+        out.Put("8BPS");
+        out.Put16BE(1);
+        for (int i = 0; i < 6; i++) out.Put8(0);
+        out.Put16BE(4);
+        out.Put32BE(h);
+        out.Put32BE(w);
+        out.Put16BE(8);
+        out.Put16BE(3);
+        out.Put32BE(0);
+        out.Put32BE(0);
+        out.Put32BE(0);
+        out.Put16BE(rle ? 1 : 0);
+
+        expected.resize((size_t)w * h * 4);
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                for (int c = 0; c < 4; c++) expected[((size_t)y * w + x) * 4 + c] = Sample(img, x, y, c);
+            }
+        }
+
+        std::vector<uint8_t> line(w);
+        if (!rle) {
+            for (int c = 0; c < 4; c++) {
+                for (int y = 0; y < h; y++) {
+                    for (int x = 0; x < w; x++) out.Put8(Sample(img, x, y, c));
+                }
+            }
+            return std::move(out.data);
+        }
+
+        Bytes packed;
+        std::vector<uint16_t> counts;
+        for (int c = 0; c < 4; c++) {
+            for (int y = 0; y < h; y++) {
+                for (int x = 0; x < w; x++) line[x] = Sample(img, x, y, c);
+                const size_t before = packed.size();
+                PackBits(packed, line.data(), w);
+                counts.push_back((uint16_t)(packed.size() - before));
+            }
+        }
+        for (uint16_t n : counts) out.Put16BE(n);
+        out.Put(packed);
+        return std::move(out.data);
+    }
+}
+
+// JPEG: baseline (4:2:0 or 4:4:4) and spectral-selection progressive (4:4:4)
+namespace Jpeg {
+    constexpr uint8_t LumaQuant[64] = {
+        16, 11, 10, 16, 24, 40, 51, 61,   12, 12, 14, 19, 26, 58, 60, 55,
+        14, 13, 16, 24, 40, 57, 69, 56,   14, 17, 22, 29, 51, 87, 80, 62,
+        18, 22, 37, 56, 68, 109, 103, 77, 24, 35, 55, 64, 81, 104, 113, 92,
+        49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99
+    };
+    constexpr uint8_t ChromaQuant[64] = {
+        17, 18, 24, 47, 99, 99, 99, 99,   18, 21, 26, 66, 99, 99, 99, 99,
+        24, 26, 56, 99, 99, 99, 99, 99,   47, 66, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,   99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,   99, 99, 99, 99, 99, 99, 99, 99
+    };
+
+    struct HuffTable {
+        uint8_t counts[16]{};
+        std::vector<uint8_t> symbols;
+        uint16_t code[256]{};
+        uint8_t length[256]{};
+    };
+
+    // Synthetic canonical tables: lengths doubling in steps of two so codes
+    // span 2..14 bits and the decoder's slow path (codes over 9 bits) runs too
+    static HuffTable BuildTable(std::vector<uint8_t> symbols, const int* perLength) {
+        HuffTable t;
+        t.symbols = symbols;
+        size_t next = 0;
+        for (int len = 1; len <= 16 && next < symbols.size(); len++) {
+            const int n = std::min<int>(perLength[len - 1], (int)(symbols.size() - next));
+            t.counts[len - 1] = (uint8_t)n;
+            next += n;
+        }
+        uint16_t code = 0;
+        size_t k = 0;
+        for (int len = 1; len <= 16; len++) {
+            for (int i = 0; i < t.counts[len - 1]; i++) {
+                t.code[t.symbols[k]] = code++;
+                t.length[t.symbols[k]] = (uint8_t)len;
+                k++;
+            }
+            code <<= 1;
+        }
+        return t;
+    }
+
+    static HuffTable DcTable() {
+        std::vector<uint8_t> symbols;
+        for (int i = 0; i < 12; i++) symbols.push_back((uint8_t)i);
+        const int perLength[16] = { 0, 2, 0, 4, 6 };
+        return BuildTable(symbols, perLength);
+    }
+
+    static HuffTable AcTable() {
+        std::vector<std::pair<float, uint8_t>> weighted;
+        weighted.push_back({ 0.0f, 0x00 });
+        weighted.push_back({ 9.0f, 0xf0 });
+        for (int run = 0; run < 16; run++) {
+            for (int size = 1; size <= 10; size++) {
+                weighted.push_back({ run * 1.5f + size, (uint8_t)(run << 4 | size) });
+            }
+        }
+        std::stable_sort(weighted.begin(), weighted.end(), [](auto& a, auto& b) { return a.first < b.first; });
+        std::vector<uint8_t> symbols;
+        for (auto& w : weighted) symbols.push_back(w.second);
+        const int perLength[16] = { 0, 2, 0, 4, 0, 8, 0, 16, 0, 32, 0, 64, 0, 36 };
+        return BuildTable(symbols, perLength);
+    }
+
+    struct BitWriterMsb {
+        Bytes& out;
+        uint32_t acc{ 0 };
+        int count{ 0 };
+
+        explicit BitWriterMsb(Bytes& o) : out(o) {}
+
+        void Put(uint32_t bits, int n) {
+            for (int i = n - 1; i >= 0; i--) {
+                acc = (acc << 1) | ((bits >> i) & 1);
+                if (++count == 8) {
+                    out.push_back((uint8_t)acc);
+                    if (acc == 0xff) out.push_back(0);
+                    acc = 0;
+                    count = 0;
+                }
+            }
+        }
+
+        void Flush() {
+            while (count != 0) Put(1, 1);
+        }
+    };
+
+    static int Category(int v) {
+        v = abs(v);
+        int n = 0;
+        while (v) {
+            n++;
+            v >>= 1;
+        }
+        return n;
+    }
+
+    static void PutValue(BitWriterMsb& bw, int v, int size) {
+        if (size == 0) return;
+        bw.Put(v < 0 ? (uint32_t)(v - 1) & ((1u << size) - 1) : (uint32_t)v, size);
+    }
+
+    static void PutSymbol(BitWriterMsb& bw, const HuffTable& t, int sym) {
+        bw.Put(t.code[sym], t.length[sym]);
+    }
+
+    static int ZigZag(int k) {
+        static int order[64];
+        static bool ready = false;
+        if (!ready) {
+            int i = 0;
+            for (int s = 0; s < 15; s++) {
+                const int lo = std::max(0, s - 7), hi = std::min(s, 7);
+                for (int j = 0; j <= hi - lo; j++) {
+                    const int row = s % 2 ? lo + j : hi - j;
+                    order[i++] = row * 8 + (s - row);
+                }
+            }
+            ready = true;
+        }
+        return order[k];
+    }
+
+    using Block = std::array<int16_t, 64>;
+
+    struct Component {
+        int blocksW{ 0 };
+        int blocksH{ 0 };
+        std::vector<Block> blocks;
+    };
+
+    static void ForwardDct(const float in[64], const uint8_t quant[64], Block& out) {
+        static float cosTable[8][8];
+        static bool ready = false;
+        if (!ready) {
+            for (int x = 0; x < 8; x++) {
+                for (int u = 0; u < 8; u++) cosTable[x][u] = cosf((2 * x + 1) * u * 3.14159265f / 16.0f);
+            }
+            ready = true;
+        }
+        float tmp[64];
+        for (int y = 0; y < 8; y++) {
+            for (int u = 0; u < 8; u++) {
+                float s = 0;
+                for (int x = 0; x < 8; x++) s += in[y * 8 + x] * cosTable[x][u];
+                tmp[y * 8 + u] = s * (u == 0 ? 0.70710678f : 1.0f) * 0.5f;
+            }
+        }
+        for (int u = 0; u < 8; u++) {
+            for (int v = 0; v < 8; v++) {
+                float s = 0;
+                for (int y = 0; y < 8; y++) s += tmp[y * 8 + u] * cosTable[y][v];
+                s *= (v == 0 ? 0.70710678f : 1.0f) * 0.5f;
+                out[v * 8 + u] = (int16_t)lrintf(s / quant[v * 8 + u]);
+            }
+        }
+    }
+
+    // Quantized coefficients for Y, Cb, Cr; 'h'/'v' are luma sampling factors
+    static std::array<Component, 3> Transform(const SourceImage& img, int hv) {
+        const int w = img.width, h = img.height;
+        const int mcu = 8 * hv;
+        const int mcusX = (w + mcu - 1) / mcu, mcusY = (h + mcu - 1) / mcu;
+        std::array<Component, 3> comps;
+        for (int c = 0; c < 3; c++) {
+            const int f = c == 0 ? hv : 1;
+            comps[c].blocksW = mcusX * f;
+            comps[c].blocksH = mcusY * f;
+            comps[c].blocks.resize((size_t)comps[c].blocksW * comps[c].blocksH);
+        }
+
+        auto ycc = [&](int x, int y, int c) {
+            x = std::min(x, w - 1);
+            y = std::min(y, h - 1);
+            const float r = img.At8(x, y, 0), g = img.At8(x, y, 1), b = img.At8(x, y, 2);
+            if (c == 0) return 0.299f * r + 0.587f * g + 0.114f * b;
+            if (c == 1) return -0.168736f * r - 0.331264f * g + 0.5f * b + 128.0f;
+            return 0.5f * r - 0.418688f * g - 0.081312f * b + 128.0f;
+        };
+
+        float in[64];
+        for (int c = 0; c < 3; c++) {
+            Component& comp = comps[c];
+            const int scale = c == 0 ? 1 : hv;
+            for (int by = 0; by < comp.blocksH; by++) {
+                for (int bx = 0; bx < comp.blocksW; bx++) {
+                    for (int y = 0; y < 8; y++) {
+                        for (int x = 0; x < 8; x++) {
+                            float sum = 0;
+                            for (int sy = 0; sy < scale; sy++) {
+                                for (int sx = 0; sx < scale; sx++) {
+                                    sum += ycc((bx * 8 + x) * scale + sx, (by * 8 + y) * scale + sy, c);
+                                }
+                            }
+                            in[y * 8 + x] = sum / (scale * scale) - 128.0f;
+                        }
+                    }
+                    ForwardDct(in, c == 0 ? LumaQuant : ChromaQuant, comp.blocks[(size_t)by * comp.blocksW + bx]);
+                }
+            }
+        }
+        return comps;
+    }
+
+    static void EncodeBlock(BitWriterMsb& bw, const Block& block, int& dcPred, int ss, int se, const HuffTable& dc, const HuffTable& ac) {
+        if (ss == 0) {
+            const int diff = block[0] - dcPred;
+            dcPred = block[0];
+            const int size = Category(diff);
+            PutSymbol(bw, dc, size);
+            PutValue(bw, diff, size);
+            if (se == 0) return;
+            ss = 1;
+        }
+
+        int run = 0;
+        for (int k = ss; k <= se; k++) {
+            const int v = block[ZigZag(k)];
+            if (v == 0) {
+                run++;
+                continue;
+            }
+            while (run > 15) {
+                PutSymbol(bw, ac, 0xf0);
+                run -= 16;
+            }
+            const int size = Category(v);
+            PutSymbol(bw, ac, (run << 4) | size);
+            PutValue(bw, v, size);
+            run = 0;
+        }
+        if (run > 0) PutSymbol(bw, ac, 0x00);
+    }
+
+    static void Segment(ByteWriter& w, int marker, const Bytes& payload) {
+        w.Put8(0xff);
+        w.Put8(marker);
+        w.Put16BE((int)payload.size() + 2);
+        w.Put(payload);
+    }
+
+    static Bytes Encode(const SourceImage& img, bool progressive, bool subsample) {
+        const int hv = subsample ? 2 : 1;
+        const std::array<Component, 3> comps = Transform(img, hv);
+        const HuffTable dc = DcTable();
+        const HuffTable ac = AcTable();
+
+        ByteWriter out;
+        out.Put8(0xff);
+        out.Put8(0xd8);
+
+        for (int t = 0; t < 2; t++) {
+            ByteWriter dqt;
+            dqt.Put8(t);
+            for (int k = 0; k < 64; k++) dqt.Put8((t == 0 ? LumaQuant : ChromaQuant)[ZigZag(k)]);
+            Segment(out, 0xdb, dqt.data);
+        }
+
+        ByteWriter sof;
+        sof.Put8(8);
+        sof.Put16BE(img.height);
+        sof.Put16BE(img.width);
+        sof.Put8(3);
+        for (int c = 0; c < 3; c++) {
+            sof.Put8(c + 1);
+            sof.Put8(c == 0 ? (hv << 4 | hv) : 0x11);
+            sof.Put8(c == 0 ? 0 : 1);
+        }
+        Segment(out, progressive ? 0xc2 : 0xc0, sof.data);
+
+        ByteWriter dht;
+        for (int t = 0; t < 2; t++) {
+            const HuffTable& table = t == 0 ? dc : ac;
+            dht.Put8(t << 4);
+            dht.Put(table.counts, 16);
+            dht.Put(table.symbols);
+        }
+        Segment(out, 0xc4, dht.data);
+
+        auto scan = [&](const std::vector<int>& compIds, int ss, int se) {
+            ByteWriter sos;
+            sos.Put8((int)compIds.size());
+            for (int c : compIds) {
+                sos.Put8(c + 1);
+                sos.Put8(0x00);
+            }
+            sos.Put8(ss);
+            sos.Put8(se);
+            sos.Put8(0);
+            Segment(out, 0xda, sos.data);
+
+            BitWriterMsb bw(out.data);
+            int pred[3] = { 0, 0, 0 };
+            if (compIds.size() == 1) {
+                const Component& comp = comps[compIds[0]];
+                for (const Block& block : comp.blocks) EncodeBlock(bw, block, pred[0], ss, se, dc, ac);
+            }
+            else {
+                const int mcusX = comps[1].blocksW, mcusY = comps[1].blocksH;
+                for (int my = 0; my < mcusY; my++) {
+                    for (int mx = 0; mx < mcusX; mx++) {
+                        for (int c : compIds) {
+                            const int f = c == 0 ? hv : 1;
+                            const Component& comp = comps[c];
+                            for (int v = 0; v < f; v++) {
+                                for (int u = 0; u < f; u++) {
+                                    const Block& block = comp.blocks[(size_t)(my * f + v) * comp.blocksW + mx * f + u];
+                                    EncodeBlock(bw, block, pred[c], ss, se, dc, ac);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            bw.Flush();
+        };
+
+        if (!progressive) {
+            scan({ 0, 1, 2 }, 0, 63);
+        }
+        else {
+            scan({ 0, 1, 2 }, 0, 0);
+            for (int c = 0; c < 3; c++) {
+                scan({ c }, 1, 5);
+                scan({ c }, 6, 63);
+            }
+        }
+
+        out.Put8(0xff);
+        out.Put8(0xd9);
+        return std::move(out.data);
+    }
+}
+
+struct CorpusEntry {
+    std::string name;
+    Bytes bytes;
+    Bytes expected;  // RGBA8; empty for lossy or external files
+};
+
+static std::vector<CorpusEntry> BuildSyntheticCorpus(int width, int height) {
+    const SourceImage img = MakeSource(width, height);
+    std::vector<CorpusEntry> corpus;
+    auto add = [&](std::string name, Bytes bytes, Bytes expected) {
+        corpus.push_back({ std::move(name), std::move(bytes), std::move(expected) });
+    };
+
+    const struct { int colorType; std::vector<int> depths; } pngModes[] = {
+        { 0, { 1, 2, 4, 8, 16 } },
+        { 2, { 8, 16 } },
+        { 3, { 1, 2, 4, 8 } },
+        { 4, { 8, 16 } },
+        { 6, { 8, 16 } },
+    };
+    for (const auto& mode : pngModes) {
+        for (int depth : mode.depths) {
+            Bytes expected;
+            Bytes bytes = Png::Encode(img, mode.colorType, depth, expected);
+            add("png_ct" + std::to_string(mode.colorType) + "_" + std::to_string(depth) + "bit", std::move(bytes), std::move(expected));
+        }
+    }
+
+    add("jpeg_baseline_420", Jpeg::Encode(img, false, true), {});
+    add("jpeg_baseline_444", Jpeg::Encode(img, false, false), {});
+    add("jpeg_progressive_444", Jpeg::Encode(img, true, false), {});
+
+    Bytes expected;
+    Bytes bytes = Gif::Encode(img, expected);
+    add("gif_8bit", std::move(bytes), std::move(expected));
+
+    add("hdr_rle", Hdr::Encode(img), {});
+
+    for (int bpp : { 8, 24, 32 }) {
+        bytes = Bmp::Encode(img, bpp, expected);
+        add("bmp_" + std::to_string(bpp) + "bit", std::move(bytes), std::move(expected));
+    }
+
+    bytes = Tga::Encode(img, 24, false, expected);
+    add("tga_24bit_raw", std::move(bytes), std::move(expected));
+    bytes = Tga::Encode(img, 32, true, expected);
+    add("tga_32bit_rle", std::move(bytes), std::move(expected));
+
+    bytes = Psd::Encode(img, false, expected);
+    add("psd_raw", std::move(bytes), std::move(expected));
+    bytes = Psd::Encode(img, true, expected);
+    add("psd_rle", std::move(bytes), std::move(expected));
+
+    // same pixels as png_ct2_8bit / png_ct6_8bit, for a like-for-like comparison
+    for (int channels : { 3, 4 }) {
+        Bytes pixels;
+        expected.clear();
+        for (int y = 0; y < img.height; y++) {
+            for (int x = 0; x < img.width; x++) {
+                for (int c = 0; c < 4; c++) {
+                    const uint8_t v = c < channels ? img.At8(x, y, c) : 255;
+                    if (c < channels) pixels.push_back(v);
+                    expected.push_back(v);
+                }
+            }
+        }
+        add(channels == 3 ? "qoi_rgb" : "qoi_rgba", Qoi::Encode(pixels.data(), img.width, img.height, channels), std::move(expected));
+    }
+
+    return corpus;
+}
+
+static void AddCorpusDirectory(std::vector<CorpusEntry>& corpus, const std::string& dir) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (!entry.is_regular_file()) continue;
+        std::ifstream file(entry.path(), std::ios::binary);
+        Bytes bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        const std::string name = "file:" + entry.path().filename().string();
+
+        // transcode to QOI so every external image is also measured in that format
+        int w = 0, h = 0, comp = 0;
+        Bytes qoi;
+        Bytes expected;
+        if (stbi_info_from_memory(bytes.data(), (int)bytes.size(), &w, &h, &comp) && entry.path().extension() != ".qoi") {
+            const int channels = (comp == 2 || comp == 4) ? 4 : 3;
+            stbi_uc* pixels = stbi_load_from_memory(bytes.data(), (int)bytes.size(), &w, &h, &comp, channels);
+            if (pixels) {
+                qoi = Qoi::Encode(pixels, w, h, channels);
+                for (size_t i = 0; i < (size_t)w * h; i++) {
+                    for (int c = 0; c < 4; c++) expected.push_back(c < channels ? pixels[i * channels + c] : 255);
+                }
+                stbi_image_free(pixels);
+            }
+        }
+
+        corpus.push_back({ name, std::move(bytes), {} });
+        if (!qoi.empty()) corpus.push_back({ name + ".qoi", std::move(qoi), std::move(expected) });
+    }
+    if (ec) fprintf(stderr, "cannot read corpus directory %s\n", dir.c_str());
+}
+
+struct BenchResult {
+    std::string name;
+    bool ok{ false };
+    bool matches{ true };
+    int width{ 0 };
+    int height{ 0 };
+    double msPerDecode{ 0.0 };
+    double mbPerSec{ 0.0 };
+    double mpixPerSec{ 0.0 };
+    size_t peakBytes{ 0 };
+    unsigned allocs{ 0 };
+};
+
+static BenchResult RunEntry(const CorpusEntry& entry, double minTime) {
+    BenchResult r;
+    r.name = entry.name;
+    int w = 0, h = 0, comp = 0;
+
+    // One instrumented decode for correctness, peak memory and allocation count
+    const size_t liveBefore = BenchAlloc::live;
+    BenchAlloc::peak = liveBefore;
+    stbi_uc* pixels = stbi_load_from_memory(entry.bytes.data(), (int)entry.bytes.size(), &w, &h, &comp, 4);
+    r.peakBytes = BenchAlloc::peak - liveBefore;
+    stbi_alloc_stats stats;
+    stbi_get_decode_alloc_stats(&stats);
+    r.allocs = stats.allocs + stats.reallocs;
+    if (!pixels) {
+        fprintf(stderr, "%s: decode failed: %s\n", entry.name.c_str(), stbi_failure_reason());
+        return r;
+    }
+    r.ok = true;
+    r.width = w;
+    r.height = h;
+    if (!entry.expected.empty()) {
+        r.matches = entry.expected.size() == (size_t)w * h * 4 && memcmp(entry.expected.data(), pixels, entry.expected.size()) == 0;
+    }
+    stbi_image_free(pixels);
+
+    std::vector<double> samples;
+    const auto begin = std::chrono::steady_clock::now();
+    while (samples.size() < 3 || std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() < minTime) {
+        const auto start = std::chrono::steady_clock::now();
+        pixels = stbi_load_from_memory(entry.bytes.data(), (int)entry.bytes.size(), &w, &h, &comp, 4);
+        samples.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        stbi_image_free(pixels);
+    }
+    std::sort(samples.begin(), samples.end());
+    const double median = samples[samples.size() / 2];
+    r.msPerDecode = median * 1000.0;
+    r.mbPerSec = entry.bytes.size() / median / 1e6;
+    r.mpixPerSec = (double)w * h / median / 1e6;
+    return r;
+}
+
+static std::map<std::string, double> LoadBaseline(const std::string& path) {
+    std::map<std::string, double> values;
+    std::ifstream file(path);
+    std::string name;
+    double value;
+    while (file >> name >> value) values[name] = value;
+    return values;
+}
+
+int main(int argc, char** argv) {
+    int width = 1024, height = 768;
+    double minTime = 0.25;
+    double tolerance = 10.0;
+    std::string filter, corpusDir, baselinePath, saveBaselinePath;
+    unsigned threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) sscanf(argv[++i], "%dx%d", &width, &height);
+        else if (arg == "--min-time" && hasValue) minTime = atof(argv[++i]);
+        else if (arg == "--filter" && hasValue) filter = argv[++i];
+        else if (arg == "--corpus" && hasValue) corpusDir = argv[++i];
+        else if (arg == "--baseline" && hasValue) baselinePath = argv[++i];
+        else if (arg == "--save-baseline" && hasValue) saveBaselinePath = argv[++i];
+        else if (arg == "--tolerance" && hasValue) tolerance = atof(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--size WxH] [--min-time SEC] [--filter TEXT] [--corpus DIR]\n"
+                "       [--save-baseline FILE] [--baseline FILE] [--tolerance PCT] [--threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<CorpusEntry> corpus = BuildSyntheticCorpus(width, height);
+    if (!corpusDir.empty()) AddCorpusDirectory(corpus, corpusDir);
+
+    const std::map<std::string, double> baseline = baselinePath.empty() ? std::map<std::string, double>{} : LoadBaseline(baselinePath);
+    std::vector<BenchResult> results;
+    std::vector<ImageSource> batch;
+    int failures = 0;
+
+    printf("%-24s %9s %11s %9s %9s %9s %10s %7s\n", "image", "size KB", "dims", "ms", "MB/s", "MP/s", "peak KB", "allocs");
+    for (const CorpusEntry& entry : corpus) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) continue;
+
+        const BenchResult r = RunEntry(entry, minTime);
+        results.push_back(r);
+        batch.push_back({ entry.bytes.data(), entry.bytes.size() });
+        if (!r.ok) {
+            printf("%-24s FAILED\n", r.name.c_str());
+            failures++;
+            continue;
+        }
+
+        char dims[32];
+        snprintf(dims, sizeof(dims), "%dx%d", r.width, r.height);
+        printf("%-24s %9.1f %11s %9.3f %9.1f %9.1f %10.1f %7u%s",
+            r.name.c_str(), entry.bytes.size() / 1024.0, dims, r.msPerDecode, r.mbPerSec, r.mpixPerSec,
+            r.peakBytes / 1024.0, r.allocs, r.matches ? "" : "  PIXEL MISMATCH");
+        if (!r.matches) failures++;
+
+        const auto it = baseline.find(r.name);
+        if (it != baseline.end()) {
+            const double change = (r.mpixPerSec / it->second - 1.0) * 100.0;
+            printf("  %+6.1f%%", change);
+            if (change < -tolerance) {
+                printf(" REGRESSION");
+                failures++;
+            }
+        }
+        printf("\n");
+    }
+
+    // the whole selection at once, as a startup with many images would load it
+    if (batch.size() > 1) {
+        ThreadPool serialPool(1), pool(threads);
+        std::vector<DecodedImage> decoded;
+        auto wallMs = [&](ThreadPool& on) {
+            std::vector<double> samples;
+            const auto begin = std::chrono::steady_clock::now();
+            while (samples.size() < 3 || std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() < minTime) {
+                const auto start = std::chrono::steady_clock::now();
+                decoded = DecodeBatch(batch, 4, on);
+                samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            }
+            std::sort(samples.begin(), samples.end());
+            return samples[samples.size() / 2];
+        };
+        const double serialMs = wallMs(serialPool);
+        const double pooledMs = wallMs(pool);
+
+        double decodeMs = 0.0;
+        for (size_t i = 0; i < decoded.size(); i++) {
+            decodeMs += decoded[i].decodeMs;
+            if (decoded[i].Ok() != results[i].ok || (decoded[i].Ok() && (decoded[i].width != results[i].width ||
+                decoded[i].height != results[i].height))) {
+                fprintf(stderr, "batch result %zu is not %s\n", i, results[i].name.c_str());
+                failures++;
+            }
+        }
+        printf("\nbatch of %zu: %.2f ms on 1 thread, %.2f ms on %u (%.2fx); %.2f ms of decoding in the last\n", batch.size(),
+            serialMs, pooledMs, pool.ThreadCount(), serialMs / pooledMs, decodeMs);
+    }
+
+    if (!saveBaselinePath.empty()) {
+        std::ofstream file(saveBaselinePath);
+        for (const BenchResult& r : results) {
+            if (r.ok) file << r.name << " " << r.mpixPerSec << "\n";
+        }
+    }
+
+    return failures ? 1 : 0;
+}
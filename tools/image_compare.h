@@ -0,0 +1,28 @@
+#pragma once
+
+// Image comparisons shared by the benchmarks
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace ImageCompare {
+    // Peak signal-to-noise ratio in dB over the first `channels` of each RGBA8 pixel
+    inline double Psnr(const uint8_t* a, const uint8_t* b, size_t pixelCount, int channels = 4) {
+        double sum = 0.0;
+        for (size_t i = 0; i < pixelCount; i++) {
+            for (int c = 0; c < channels; c++) {
+                const double d = (double)a[i * 4 + c] - b[i * 4 + c];
+                sum += d * d;
+            }
+        }
+        if (sum == 0.0) return INFINITY;
+        const double mse = sum / ((double)pixelCount * channels);
+        return 10.0 * log10(255.0 * 255.0 / mse);
+    }
+
+    inline double Psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int channels = 4) {
+        return Psnr(a.data(), b.data(), std::min(a.size(), b.size()) / 4, channels);
+    }
+}
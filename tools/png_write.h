@@ -0,0 +1,207 @@
+#pragma once
+
+// PNG encoder for tool output (golden images, diffs); stb_image reads them.
+// RGBA8 only. Each row takes the None, Sub or Up filter that leaves the
+// smallest residuals, and the zlib stream is a single fixed-Huffman deflate
+// block with greedy LZ77 matching, which is plenty for flat UI images.
+// Spec: https://www.w3.org/TR/png/ and RFC 1951
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Png {
+    inline uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+        static uint32_t table[256];
+        static bool ready = false;
+        if (!ready) {
+            for (uint32_t n = 0; n < 256; n++) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++) c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+            ready = true;
+        }
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    class BitWriter {
+        std::vector<uint8_t>& out;
+        uint32_t bits{ 0 };
+        int count{ 0 };
+
+    public:
+        explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+        // value's low n bits, least significant first
+        void Put(uint32_t value, int n) {
+            bits |= value << count;
+            count += n;
+            while (count >= 8) {
+                out.push_back((uint8_t)bits);
+                bits >>= 8;
+                count -= 8;
+            }
+        }
+
+        // Huffman codes go most significant bit first
+        void PutCode(uint32_t code, int n) {
+            uint32_t reversed = 0;
+            for (int i = 0; i < n; i++) reversed |= ((code >> i) & 1) << (n - 1 - i);
+            Put(reversed, n);
+        }
+
+        void Flush() {
+            if (count > 0) out.push_back((uint8_t)bits);
+            bits = 0;
+            count = 0;
+        }
+    };
+
+    // Fixed literal/length code (RFC 1951 3.2.6)
+    inline void PutLiteral(BitWriter& writer, int symbol) {
+        if (symbol < 144) writer.PutCode(0x30 + symbol, 8);
+        else if (symbol < 256) writer.PutCode(0x190 + symbol - 144, 9);
+        else if (symbol < 280) writer.PutCode(symbol - 256, 7);
+        else writer.PutCode(0xc0 + symbol - 280, 8);
+    }
+
+    inline void PutMatch(BitWriter& writer, int length, int distance) {
+        static const int lengthBase[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115,
+            131, 163, 195, 227, 258 };
+        static const int lengthExtra[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const int distanceBase[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537,
+            2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        static const int distanceExtra[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12,
+            13, 13 };
+
+        int l = 28;
+        while (lengthBase[l] > length) l--;
+        PutLiteral(writer, 257 + l);
+        writer.Put(length - lengthBase[l], lengthExtra[l]);
+
+        int d = 29;
+        while (distanceBase[d] > distance) d--;
+        writer.PutCode(d, 5);
+        writer.Put(distance - distanceBase[d], distanceExtra[d]);
+    }
+
+    inline std::vector<uint8_t> Zlib(const uint8_t* data, size_t size) {
+        std::vector<uint8_t> out = { 0x78, 0x01 };
+        BitWriter writer(out);
+        writer.Put(1, 1);  // final block
+        writer.Put(1, 2);  // fixed Huffman
+
+        constexpr int HashBits = 15;
+        constexpr size_t Window = 32768;
+        std::vector<int64_t> table((size_t)1 << HashBits, -1);
+        auto hash = [&](size_t i) {
+            const uint32_t v = data[i] | data[i + 1] << 8 | data[i + 2] << 16;
+            return (v * 2654435761u) >> (32 - HashBits);
+        };
+
+        size_t i = 0;
+        while (i < size) {
+            size_t length = 0, distance = 0;
+            if (i + 3 <= size) {
+                int64_t& slot = table[hash(i)];
+                const int64_t candidate = slot;
+                slot = (int64_t)i;
+                if (candidate >= 0 && i - (size_t)candidate <= Window) {
+                    const size_t limit = std::min<size_t>(258, size - i);
+                    while (length < limit && data[candidate + length] == data[i + length]) length++;
+                    distance = i - (size_t)candidate;
+                }
+            }
+            if (length >= 3) {
+                PutMatch(writer, (int)length, (int)distance);
+                i += length;
+            }
+            else {
+                PutLiteral(writer, data[i]);
+                i++;
+            }
+        }
+        PutLiteral(writer, 256);
+        writer.Flush();
+
+        uint32_t a = 1, b = 0;
+        for (size_t k = 0; k < size; k++) {
+            a = (a + data[k]) % 65521;
+            b = (b + a) % 65521;
+        }
+        const uint32_t adler = b << 16 | a;
+        for (int shift = 24; shift >= 0; shift -= 8) out.push_back((uint8_t)(adler >> shift));
+        return out;
+    }
+
+    inline std::vector<uint8_t> Encode(const uint8_t* rgba, int width, int height) {
+        std::vector<uint8_t> out;
+        if (!rgba || width <= 0 || height <= 0) return out;
+
+        const size_t stride = (size_t)width * 4;
+        std::vector<uint8_t> filtered;
+        filtered.reserve((stride + 1) * height);
+        std::vector<uint8_t> candidates[3];
+        for (int y = 0; y < height; y++) {
+            const uint8_t* row = rgba + y * stride;
+            const uint8_t* above = y ? row - stride : nullptr;
+            int best = 0;
+            uint64_t bestCost = UINT64_MAX;
+            for (int f = 0; f < 3; f++) {
+                std::vector<uint8_t>& c = candidates[f];
+                c.resize(stride);
+                uint64_t cost = 0;
+                for (size_t x = 0; x < stride; x++) {
+                    const uint8_t left = x >= 4 ? row[x - 4] : 0;
+                    const uint8_t up = above ? above[x] : 0;
+                    c[x] = (uint8_t)(row[x] - (f == 1 ? left : f == 2 ? up : 0));
+                    cost += (uint64_t)std::abs((int8_t)c[x]);
+                }
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    best = f;
+                }
+            }
+            filtered.push_back((uint8_t)best);
+            filtered.insert(filtered.end(), candidates[best].begin(), candidates[best].end());
+        }
+
+        auto put32 = [&](uint32_t v) {
+            for (int shift = 24; shift >= 0; shift -= 8) out.push_back((uint8_t)(v >> shift));
+        };
+        auto chunk = [&](const char* type, const std::vector<uint8_t>& data) {
+            put32((uint32_t)data.size());
+            const size_t start = out.size();
+            out.insert(out.end(), type, type + 4);
+            out.insert(out.end(), data.begin(), data.end());
+            put32(Crc32(out.data() + start, out.size() - start));
+        };
+
+        static const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+        out.insert(out.end(), signature, signature + sizeof(signature));
+        std::vector<uint8_t> header;
+        for (const uint32_t v : { (uint32_t)width, (uint32_t)height }) {
+            for (int shift = 24; shift >= 0; shift -= 8) header.push_back((uint8_t)(v >> shift));
+        }
+        header.insert(header.end(), { 8, 6, 0, 0, 0 });  // 8 bits, RGBA, deflate, adaptive filters, no interlace
+        chunk("IHDR", header);
+        chunk("IDAT", Zlib(filtered.data(), filtered.size()));
+        chunk("IEND", {});
+        return out;
+    }
+
+    inline bool Write(const std::string& path, const uint8_t* rgba, int width, int height) {
+        const std::vector<uint8_t> png = Encode(rgba, width, height);
+        if (png.empty()) return false;
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) return false;
+        const bool ok = fwrite(png.data(), 1, png.size(), file) == png.size();
+        return fclose(file) == 0 && ok;
+    }
+}
@@ -0,0 +1,64 @@
+// Asset converter: any format stb_image reads -> QOI
+//
+// Standalone tool, built from the repository root with:
+//   g++ -O2 -std=c++17 tools/qoi_convert.cpp -o qoi_convert
+//
+//   qoi_convert INPUT [OUTPUT]
+//
+// OUTPUT defaults to INPUT with its extension replaced by .qoi. Images
+// without alpha are written as 3-channel QOI. The result is decoded again
+// and compared against the source pixels before the tool reports success.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../stb_image.h"
+#include "qoi_write.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "usage: %s INPUT [OUTPUT]\n", argv[0]);
+        return 2;
+    }
+
+    const std::string input = argv[1];
+    std::string output = argc == 3 ? argv[2] : input.substr(0, input.find_last_of('.')) + ".qoi";
+
+    int width = 0, height = 0, fileChannels = 0;
+    if (!stbi_info(input.c_str(), &width, &height, &fileChannels)) {
+        fprintf(stderr, "%s: %s\n", input.c_str(), stbi_failure_reason());
+        return 1;
+    }
+    const int channels = (fileChannels == 2 || fileChannels == 4) ? 4 : 3;
+
+    stbi_uc* pixels = stbi_load(input.c_str(), &width, &height, &fileChannels, channels);
+    if (!pixels) {
+        fprintf(stderr, "%s: %s\n", input.c_str(), stbi_failure_reason());
+        return 1;
+    }
+
+    const std::vector<uint8_t> bytes = Qoi::Encode(pixels, width, height, channels);
+    int w = 0, h = 0, c = 0;
+    stbi_uc* check = stbi_load_from_memory(bytes.data(), (int)bytes.size(), &w, &h, &c, channels);
+    const bool roundTrips = check && w == width && h == height &&
+        memcmp(check, pixels, (size_t)width * height * channels) == 0;
+    stbi_image_free(check);
+    stbi_image_free(pixels);
+    if (!roundTrips) {
+        fprintf(stderr, "%s: QOI round trip mismatch\n", input.c_str());
+        return 1;
+    }
+
+    FILE* file = fopen(output.c_str(), "wb");
+    if (!file || fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+        fprintf(stderr, "%s: cannot write\n", output.c_str());
+        if (file) fclose(file);
+        return 1;
+    }
+    fclose(file);
+
+    printf("%s -> %s (%dx%d, %d channels, %zu bytes)\n", input.c_str(), output.c_str(), width, height, channels, bytes.size());
+    return 0;
+}
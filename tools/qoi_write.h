@@ -0,0 +1,91 @@
+#pragma once
+
+// QOI encoder for the asset pipeline; stb_image reads the result at runtime.
+// Spec: https://qoiformat.org/qoi-specification.pdf
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Qoi {
+    constexpr uint8_t OpIndex = 0x00;
+    constexpr uint8_t OpDiff = 0x40;
+    constexpr uint8_t OpLuma = 0x80;
+    constexpr uint8_t OpRun = 0xc0;
+    constexpr uint8_t OpRgb = 0xfe;
+    constexpr uint8_t OpRgba = 0xff;
+
+    // pixels are tightly packed RGB (channels == 3) or RGBA (channels == 4)
+    inline std::vector<uint8_t> Encode(const uint8_t* pixels, int width, int height, int channels, bool linear = false) {
+        std::vector<uint8_t> out;
+        if (!pixels || width <= 0 || height <= 0 || (channels != 3 && channels != 4)) return out;
+
+        const size_t pixelCount = (size_t)width * height;
+        out.reserve(14 + pixelCount * (channels + 1) / 2 + 8);
+        auto put32 = [&](uint32_t v) {
+            for (int shift = 24; shift >= 0; shift -= 8) out.push_back((uint8_t)(v >> shift));
+        };
+        out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+        put32((uint32_t)width);
+        put32((uint32_t)height);
+        out.push_back((uint8_t)channels);
+        out.push_back(linear ? 1 : 0);
+
+        uint8_t index[64][4] = {};
+        uint8_t prev[4] = { 0, 0, 0, 255 };
+        uint8_t px[4] = { 0, 0, 0, 255 };
+        int run = 0;
+
+        for (size_t i = 0; i < pixelCount; i++) {
+            const uint8_t* src = pixels + i * channels;
+            px[0] = src[0];
+            px[1] = src[1];
+            px[2] = src[2];
+            if (channels == 4) px[3] = src[3];
+
+            if (memcmp(px, prev, 4) == 0) {
+                if (++run == 62 || i + 1 == pixelCount) {
+                    out.push_back((uint8_t)(OpRun | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                out.push_back((uint8_t)(OpRun | (run - 1)));
+                run = 0;
+            }
+
+            const int slot = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63;
+            if (memcmp(index[slot], px, 4) == 0) {
+                out.push_back((uint8_t)(OpIndex | slot));
+            }
+            else {
+                memcpy(index[slot], px, 4);
+                if (px[3] == prev[3]) {
+                    const int dr = (int8_t)(px[0] - prev[0]);
+                    const int dg = (int8_t)(px[1] - prev[1]);
+                    const int db = (int8_t)(px[2] - prev[2]);
+                    const int drg = dr - dg;
+                    const int dbg = db - dg;
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                        out.push_back((uint8_t)(OpDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                    }
+                    else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                        out.push_back((uint8_t)(OpLuma | (dg + 32)));
+                        out.push_back((uint8_t)((drg + 8) << 4 | (dbg + 8)));
+                    }
+                    else {
+                        out.insert(out.end(), { OpRgb, px[0], px[1], px[2] });
+                    }
+                }
+                else {
+                    out.insert(out.end(), { OpRgba, px[0], px[1], px[2], px[3] });
+                }
+            }
+            memcpy(prev, px, 4);
+        }
+
+        out.insert(out.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+        return out;
+    }
+}
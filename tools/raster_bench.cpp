@@ -0,0 +1,415 @@
+// Software rasterizer benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 -pthread tools/raster_bench.cpp -o raster_bench
+//
+//   raster_bench [--size WxH] [--min-time SEC] [--ppm FILE]
+//
+// Builds a frame shaped like ImGui's output without needing ImGui: a
+// premultiplied background image, anti-aliased rounded panels (fringe
+// vertices fading to transparent), rows of glyph quads from a font atlas,
+// thin lines and scissored card grids, in triangles of both windings.
+// Checks SoftRaster against a per-pixel reference written directly from
+// the D3D11 rules in double precision, checks that a tessellated surface
+// drawn at half alpha blends every pixel exactly once, then times frames
+// on 1..N threads.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../soft_raster.h"
+
+using SoftRaster::Blend;
+using SoftRaster::Command;
+using SoftRaster::Mesh;
+using SoftRaster::Texture;
+using SoftRaster::Vertex;
+
+static uint32_t Rgba(int r, int g, int b, int a) { return (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | (uint32_t)a << 24; }
+
+struct DrawList {
+    std::vector<Vertex> vertices;
+    std::vector<uint16_t> indices;
+    std::vector<Command> commands;
+
+    void Begin(const Texture* texture, float x0, float y0, float x1, float y1, Blend blend = Blend::Alpha) {
+        commands.push_back({ { x0, y0, x1, y1 }, texture, (uint32_t)indices.size(), 0, 0, blend });
+    }
+
+    void Triangle(uint16_t a, uint16_t b, uint16_t c, bool flip) {
+        indices.insert(indices.end(), { a, flip ? c : b, flip ? b : c });
+        commands.back().indexCount += 3;
+    }
+
+    void Quad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, uint32_t col, bool flip = false) {
+        const uint16_t base = (uint16_t)vertices.size();
+        vertices.push_back({ x0, y0, u0, v0, col });
+        vertices.push_back({ x1, y0, u1, v0, col });
+        vertices.push_back({ x1, y1, u1, v1, col });
+        vertices.push_back({ x0, y1, u0, v1, col });
+        Triangle(base, base + 1, base + 2, flip);
+        Triangle(base, base + 2, base + 3, flip);
+    }
+
+    // Convex polygon the way ImGui fills one with anti-aliasing: an opaque
+    // core half a pixel inside the outline, a fringe half a pixel outside
+    void ConvexPoly(const std::vector<float>& points, float u, float v, uint32_t col, bool flip) {
+        const size_t n = points.size() / 2;
+        float cx = 0.0f, cy = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            cx += points[i * 2] / n;
+            cy += points[i * 2 + 1] / n;
+        }
+        const uint16_t base = (uint16_t)vertices.size();
+        for (size_t i = 0; i < n; i++) {
+            const float dx = points[i * 2] - cx, dy = points[i * 2 + 1] - cy;
+            const float length = std::max(1e-3f, sqrtf(dx * dx + dy * dy));
+            vertices.push_back({ points[i * 2] - dx / length * 0.5f, points[i * 2 + 1] - dy / length * 0.5f, u, v, col });
+            vertices.push_back({ points[i * 2] + dx / length * 0.5f, points[i * 2 + 1] + dy / length * 0.5f, u, v, col & 0x00ffffff });
+        }
+        for (size_t i = 2; i < n; i++) Triangle(base, (uint16_t)(base + (i - 1) * 2), (uint16_t)(base + i * 2), flip);
+        for (size_t i = 0; i < n; i++) {
+            const uint16_t a = (uint16_t)(base + i * 2), b = (uint16_t)(base + (i + 1) % n * 2);
+            Triangle(a, b, b + 1, !flip);
+            Triangle(a, b + 1, a + 1, !flip);
+        }
+    }
+
+    void RoundedRect(float x0, float y0, float x1, float y1, float radius, float u, float v, uint32_t col, bool flip) {
+        std::vector<float> points;
+        const float centres[4][2] = { { x1 - radius, y0 + radius }, { x1 - radius, y1 - radius }, { x0 + radius, y1 - radius }, { x0 + radius, y0 + radius } };
+        for (int corner = 0; corner < 4; corner++) {
+            for (int step = 0; step <= 6; step++) {
+                const float angle = (corner - 1 + step / 6.0f) * 1.5707963f;
+                points.push_back(centres[corner][0] + cosf(angle) * radius);
+                points.push_back(centres[corner][1] + sinf(angle) * radius);
+            }
+        }
+        ConvexPoly(points, u, v, col, flip);
+    }
+
+    Mesh AsMesh() const {
+        Mesh mesh;
+        mesh.vertices = vertices.data();
+        mesh.indices = indices.data();
+        mesh.indexSize = 2;
+        mesh.commands = commands;
+        return mesh;
+    }
+};
+
+struct Scene {
+    Texture font;
+    Texture background;
+    std::vector<DrawList> lists;
+    std::vector<Mesh> meshes;
+};
+
+// Glyph cells are 8x16 texels; the white texel ImGui draws shapes with is at (1, 1)
+constexpr int FontWidth = 512, FontHeight = 128;
+constexpr float WhiteU = 1.5f / FontWidth, WhiteV = 1.5f / FontHeight;
+
+static void BuildScene(Scene& scene, int width, int height) {
+    uint32_t seed = 7;
+    auto random = [&seed] { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / 16777216.0f; };
+
+    scene.font.width = FontWidth;
+    scene.font.height = FontHeight;
+    scene.font.rgba.assign((size_t)FontWidth * FontHeight * 4, 255);
+    for (int y = 0; y < FontHeight; y++) {
+        for (int x = 0; x < FontWidth; x++) {
+            const bool white = x < 4 && y < 4;
+            const float gx = (x % 8) - 3.5f, gy = (y % 16) - 7.5f;
+            const float ink = sinf(gx * (1.3f + (x / 8 % 5) * 0.2f)) * cosf(gy * (0.4f + (y / 16 % 3) * 0.15f));
+            scene.font.rgba[((size_t)y * FontWidth + x) * 4 + 3] = white ? 255 : (uint8_t)std::clamp((int)(ink * 400.0f), 0, 255);
+        }
+    }
+
+    scene.background.width = width;
+    scene.background.height = height;
+    scene.background.rgba.resize((size_t)width * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = &scene.background.rgba[((size_t)y * width + x) * 4];
+            const int a = 160 + (x + y) % 96;
+            p[0] = (uint8_t)(x * 255 / width * a / 255);
+            p[1] = (uint8_t)(y * 255 / height * a / 255);
+            p[2] = (uint8_t)(((x / 16 + y / 16) % 2 ? 200 : 60) * a / 255);
+            p[3] = (uint8_t)a;
+        }
+    }
+
+    scene.lists.assign(3, {});
+    const float w = (float)width, h = (float)height;
+
+    // background, faded like the frosted notification
+    DrawList& back = scene.lists[0];
+    back.Begin(&scene.background, 0.0f, 0.0f, w, h, Blend::Premultiplied);
+    back.Quad(0.0f, 0.0f, w, h, 0.0f, 0.0f, 1.0f, 1.0f, Rgba(230, 230, 230, 230));
+
+    // the page: panels, separators and text
+    DrawList& page = scene.lists[1];
+    page.Begin(&scene.font, 0.0f, 0.0f, w, h);
+    page.RoundedRect(8.5f, 8.5f, w - 8.5f, h - 8.5f, 12.0f, WhiteU, WhiteV, Rgba(14, 14, 14, 235), false);
+    page.Quad(20.0f, 46.0f, w - 20.0f, 47.0f, WhiteU, WhiteV, WhiteU, WhiteV, Rgba(40, 40, 40, 255));
+    for (int line = 0; line < 18; line++) {
+        const float y = 58.0f + line * 18.0f;
+        const int glyphs = 20 + (int)(random() * 40);
+        for (int g = 0; g < glyphs; g++) {
+            const int cell = (int)(random() * 400) + 1;
+            const float u = (cell % 64) * 8.0f / FontWidth, v = (cell / 64) * 16.0f / FontHeight;
+            const float x = 24.0f + g * 8.0f;
+            page.Quad(x, y, x + 8.0f, y + 16.0f, u, v, u + 8.0f / FontWidth, v + 16.0f / FontHeight, Rgba(235, 235, 235, 255), g % 3 == 0);
+        }
+    }
+    for (int i = 0; i < 40; i++) {
+        // thin anti-aliased lines
+        const float x0 = random() * w, y0 = random() * h, x1 = random() * w, y1 = random() * h;
+        const float length = sqrtf((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0)) + 1e-3f;
+        const float nx = -(y1 - y0) / length, ny = (x1 - x0) / length;
+        std::vector<float> points = { x0 + nx, y0 + ny, x1 + nx, y1 + ny, x1 - nx, y1 - ny, x0 - nx, y0 - ny };
+        page.ConvexPoly(points, WhiteU, WhiteV, Rgba(90, 160, 255, 200), i % 2 == 0);
+    }
+
+    // a scissored, scrolled card grid
+    DrawList& cards = scene.lists[2];
+    const float clipX0 = 30.0f, clipY0 = 70.0f, clipX1 = w - 30.0f, clipY1 = h - 40.0f;
+    cards.Begin(&scene.font, clipX0, clipY0, clipX1, clipY1);
+    for (int row = 0; row < 6; row++) {
+        for (int column = 0; column < 4; column++) {
+            const float x = 34.0f + column * (w - 60.0f) / 4.0f, y = 40.0f + row * 70.0f + 0.37f;
+            const float cw = (w - 60.0f) / 4.0f - 8.0f;
+            cards.RoundedRect(x, y, x + cw, y + 60.0f, 8.0f, WhiteU, WhiteV, Rgba(24, 24, 24, 240), (row + column) % 2 == 1);
+            cards.RoundedRect(x + cw - 50.0f, y + 15.0f, x + cw - 10.0f, y + 45.0f, 6.0f, WhiteU, WhiteV, Rgba(255, 255, 255, 40), false);
+            for (int g = 0; g < 10; g++) {
+                const int cell = (int)(random() * 400) + 1;
+                const float u = (cell % 64) * 8.0f / FontWidth, v = (cell / 64) * 16.0f / FontHeight;
+                cards.Quad(x + 10.0f + g * 8.0f, y + 10.0f, x + 18.0f + g * 8.0f, y + 26.0f, u, v, u + 8.0f / FontWidth, v + 16.0f / FontHeight,
+                    Rgba(200, 200, 200, 255));
+            }
+        }
+    }
+
+    for (const DrawList& list : scene.lists) scene.meshes.push_back(list.AsMesh());
+}
+
+// Per-pixel reference, straight from the rules: snapped integer edge
+// functions with the top-left rule, barycentric attributes, bilinear
+// wrapped sampling and blending, all in double
+static void ReferenceDraw(const std::vector<Mesh>& meshes, const float clear[4], int width, int height, std::vector<uint8_t>& out) {
+    out.resize((size_t)width * height * 4);
+    for (size_t i = 0; i < out.size(); i++) out[i] = (uint8_t)lrintf(clear[i % 4] * 255.0f);
+
+    auto sample = [](const Texture* texture, double u, double v, double texel[4]) {
+        if (!texture) {
+            std::fill(texel, texel + 4, 1.0);
+            return;
+        }
+        const double fx = u * texture->width - 0.5, fy = v * texture->height - 0.5;
+        const double ix = floor(fx), iy = floor(fy);
+        auto wrap = [](long long i, int n) { return (int)(((i % n) + n) % n); };
+        const int x0 = wrap((long long)ix, texture->width), x1 = wrap((long long)ix + 1, texture->width);
+        const int y0 = wrap((long long)iy, texture->height), y1 = wrap((long long)iy + 1, texture->height);
+        for (int c = 0; c < 4; c++) {
+            auto at = [&](int x, int y) { return texture->rgba[((size_t)y * texture->width + x) * 4 + c] / 255.0; };
+            const double top = at(x0, y0) + (at(x1, y0) - at(x0, y0)) * (fx - ix);
+            const double bottom = at(x0, y1) + (at(x1, y1) - at(x0, y1)) * (fx - ix);
+            texel[c] = top + (bottom - top) * (fy - iy);
+        }
+    };
+
+    for (const Mesh& mesh : meshes) {
+        for (const Command& command : mesh.commands) {
+            const int cx0 = std::max(0, (int)command.clip[0]), cy0 = std::max(0, (int)command.clip[1]);
+            const int cx1 = std::min(width, (int)command.clip[2]), cy1 = std::min(height, (int)command.clip[3]);
+            const uint16_t* indices = (const uint16_t*)mesh.indices + command.firstIndex;
+            for (uint32_t t = 0; t + 2 < command.indexCount; t += 3) {
+                const Vertex* v[3];
+                long long sx[3], sy[3];
+                for (int i = 0; i < 3; i++) {
+                    v[i] = mesh.vertices + command.vertexOffset + indices[t + i];
+                    sx[i] = llrint((double)v[i]->x * 256.0);
+                    sy[i] = llrint((double)v[i]->y * 256.0);
+                }
+                const long long area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+                if (area == 0) continue;
+                const int sign = area > 0 ? 1 : -1;
+
+                for (int y = cy0; y < cy1; y++) {
+                    for (int x = cx0; x < cx1; x++) {
+                        const long long px = x * 256LL + 128, py = y * 256LL + 128;
+                        long long e[3];
+                        bool inside = true;
+                        for (int k = 0; k < 3; k++) {
+                            // edge opposite vertex k, walked in the winding that has the triangle on its left
+                            int i = (k + 1) % 3, j = (k + 2) % 3;
+                            if (sign < 0) std::swap(i, j);
+                            const long long dx = sx[j] - sx[i], dy = sy[j] - sy[i];
+                            e[k] = dx * (py - sy[i]) - dy * (px - sx[i]);
+                            const bool topLeft = dy < 0 || (dy == 0 && dx > 0);
+                            if (e[k] < 0 || (e[k] == 0 && !topLeft)) inside = false;
+                        }
+                        if (!inside) continue;
+
+                        const double l[3] = { (double)e[0] / (sign * area), (double)e[1] / (sign * area), (double)e[2] / (sign * area) };
+                        double u = 0.0, vv = 0.0, src[4] = {};
+                        for (int i = 0; i < 3; i++) {
+                            u += l[i] * v[i]->u;
+                            vv += l[i] * v[i]->v;
+                            for (int c = 0; c < 4; c++) src[c] += l[i] * (v[i]->col >> (c * 8) & 0xff) / 255.0;
+                        }
+                        double texel[4];
+                        sample(command.texture, u, vv, texel);
+                        for (int c = 0; c < 4; c++) src[c] = std::clamp(src[c] * texel[c], 0.0, 1.0);
+                        const double alpha = src[3];
+                        if (command.blend == Blend::Alpha) {
+                            for (int c = 0; c < 3; c++) src[c] *= alpha;
+                        }
+                        uint8_t* dst = &out[((size_t)y * width + x) * 4];
+                        for (int c = 0; c < 4; c++) dst[c] = (uint8_t)std::clamp((int)lrint((src[c] + dst[c] / 255.0 * (1.0 - alpha)) * 255.0), 0, 255);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// A jittered grid of triangles in both windings, drawn at half alpha over
+// black: covered pixels must all read the single-blend value
+static bool CheckWatertight(int width, int height) {
+    DrawList list;
+    list.Begin(nullptr, 0.0f, 0.0f, (float)width, (float)height);
+    const int columns = 37, rows = 23;
+    const float x0 = 20.25f, y0 = 15.6f, x1 = width - 20.4f, y1 = height - 15.3f;
+    uint32_t seed = 3;
+    for (int j = 0; j <= rows; j++) {
+        for (int i = 0; i <= columns; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            const bool edge = i == 0 || j == 0 || i == columns || j == rows;
+            const float jx = edge ? 0.0f : ((seed >> 8 & 255) / 255.0f - 0.5f) * 0.8f;
+            const float jy = edge ? 0.0f : ((seed >> 16 & 255) / 255.0f - 0.5f) * 0.8f;
+            list.vertices.push_back({ x0 + (x1 - x0) * (i + jx) / columns, y0 + (y1 - y0) * (j + jy) / rows, 0.0f, 0.0f, Rgba(255, 255, 255, 128) });
+        }
+    }
+    for (int j = 0; j < rows; j++) {
+        for (int i = 0; i < columns; i++) {
+            const uint16_t a = (uint16_t)(j * (columns + 1) + i), b = a + 1, c = a + columns + 1, d = c + 1;
+            list.Triangle(a, b, d, (i + j) % 2 == 0);
+            list.Triangle(a, d, c, (i * j) % 3 == 0);
+        }
+    }
+
+    SoftRaster::Rasterizer raster;
+    raster.Resize(width, height);
+    const float black[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    raster.Draw({ list.AsMesh() }, black);
+
+    const uint8_t single = (uint8_t)lrintf(128.0f / 255.0f * 255.0f);
+    int holes = 0, doubles = 0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const uint8_t value = raster.Pixels()[((size_t)y * width + x) * 4];
+            const bool interior = x > x0 + 1 && x < x1 - 2 && y > y0 + 1 && y < y1 - 2;
+            if (value != 0 && value != single) doubles++;
+            else if (interior && value != single) holes++;
+        }
+    }
+    printf("tessellated surface: %d pixels missed, %d blended more than once\n", holes, doubles);
+    return holes == 0 && doubles == 0;
+}
+
+template<typename Body>
+static double MedianMs(double minTime, Body&& body) {
+    std::vector<double> samples;
+    const auto begin = std::chrono::steady_clock::now();
+    while (samples.size() < 5 || std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() < minTime) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    int width = 600, height = 400;
+    double minTime = 0.5;
+    std::string ppmPath;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) sscanf(argv[++i], "%dx%d", &width, &height);
+        else if (arg == "--min-time" && hasValue) minTime = atof(argv[++i]);
+        else if (arg == "--ppm" && hasValue) ppmPath = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--size WxH] [--min-time SEC] [--ppm FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Scene scene;
+    BuildScene(scene, width, height);
+    const float clear[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    size_t vertices = 0, indices = 0, commands = 0;
+    for (const DrawList& list : scene.lists) {
+        vertices += list.vertices.size();
+        indices += list.indices.size();
+        commands += list.commands.size();
+    }
+    printf("%dx%d frame: %zu vertices, %zu triangles, %zu commands\n", width, height, vertices, indices / 3, commands);
+
+    int failures = 0;
+    SoftRaster::Rasterizer raster;
+    raster.Resize(width, height);
+    raster.Draw(scene.meshes, clear);
+    std::vector<uint8_t> reference;
+    ReferenceDraw(scene.meshes, clear, width, height, reference);
+    int worst = 0;
+    size_t off = 0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        const int diff = abs(reference[i] - raster.Pixels()[i]);
+        worst = std::max(worst, diff);
+        if (diff > 0) off++;
+    }
+    printf("vs reference: max difference %d, %.3f%% of channels differ\n", worst, 100.0 * off / reference.size());
+    if (worst > 2) failures++;
+    if (!CheckWatertight(width, height)) failures++;
+
+    if (!ppmPath.empty()) {
+        if (FILE* file = fopen(ppmPath.c_str(), "wb")) {
+            fprintf(file, "P6\n%d %d\n255\n", width, height);
+            for (size_t i = 0; i < (size_t)width * height; i++) fwrite(raster.Pixels() + i * 4, 1, 3, file);
+            fclose(file);
+        }
+    }
+
+    printf("\n%-8s %10s %10s %10s %10s %8s\n", "threads", "frame", "setup", "raster", "MP/s", "binned");
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= cores; threads = threads < cores && threads * 2 > cores ? cores : threads * 2) {
+        SoftRaster::Rasterizer timed(threads);
+        timed.Resize(width, height);
+        double setup = 0.0, rasterize = 0.0;
+        int frames = 0;
+        const double frame = MedianMs(minTime, [&] {
+            timed.Draw(scene.meshes, clear);
+            setup += timed.LastStats().setupMs;
+            rasterize += timed.LastStats().rasterMs;
+            frames++;
+        });
+        printf("%-8u %8.3fms %8.3fms %8.3fms %10.1f %8zu\n", threads, frame, setup / frames, rasterize / frames,
+            (double)width * height / (frame / 1000.0) / 1e6, timed.LastStats().binned);
+        if (memcmp(timed.Pixels(), raster.Pixels(), reference.size()) != 0) {
+            printf("  output differs from the default thread count\n");
+            failures++;
+        }
+    }
+
+    return failures ? 1 : 0;
+}
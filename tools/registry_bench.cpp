@@ -0,0 +1,192 @@
+// Texture registry check and benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 tools/registry_bench.cpp -o registry_bench
+//
+//   registry_bench [--assets N] [--budget MB] [--frames N]
+//
+// Runs TextureRegistry against a fake GPU that only counts live textures
+// and bytes. First a set of scripted cases (LRU order, pinned textures,
+// replacement, Ref copies and moves, teardown), then a long random
+// workload with a skewed access pattern, checking after every frame that
+// the registry's byte count matches what the fake GPU holds and that the
+// budget is met whenever nothing is referenced.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../texture_registry.h"
+
+struct FakeGpu {
+    std::unordered_map<void*, uint64_t> live;
+    uint64_t liveBytes{ 0 };
+    uint64_t uploads{ 0 };
+    uint64_t releases{ 0 };
+
+    void* Create(uint64_t bytes) {
+        void* texture = new uint64_t(bytes);
+        live[texture] = bytes;
+        liveBytes += bytes;
+        uploads++;
+        return texture;
+    }
+
+    void Release(void* texture) {
+        const auto it = live.find(texture);
+        if (it == live.end()) {
+            fprintf(stderr, "release of an unknown texture\n");
+            exit(1);
+        }
+        liveBytes -= it->second;
+        live.erase(it);
+        delete (uint64_t*)texture;
+        releases++;
+    }
+};
+
+static int failures = 0;
+
+static void Check(bool ok, const char* what) {
+    if (!ok) {
+        fprintf(stderr, "FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static void ScriptedCases() {
+    FakeGpu gpu;
+    {
+        TextureRegistry registry(250, [&](void* t) { gpu.Release(t); });
+        auto insert = [&](const char* id, uint64_t bytes) { return registry.Insert(id, gpu.Create(bytes), bytes, 16, 16); };
+
+        insert("a", 100);
+        insert("b", 100);
+        Check(registry.Count() == 2 && registry.TotalBytes() == 200, "unreferenced textures stay resident under budget");
+
+        insert("c", 100);
+        Check(!registry.Contains("a") && registry.Contains("b") && registry.Contains("c"), "least recently used goes first");
+        Check(registry.TotalBytes() == 200 && gpu.liveBytes == 200, "evicted bytes are released");
+
+        registry.Acquire("b");
+        insert("d", 100);
+        Check(registry.Contains("b") && !registry.Contains("c"), "Acquire refreshes recency");
+
+        {
+            TextureRef b = registry.Acquire("b");
+            TextureRef d = registry.Acquire("d");
+            TextureRef e = insert("e", 100);
+            TextureRef f = insert("f", 100);
+            Check(registry.Count() == 4 && registry.TotalBytes() == 400, "referenced textures are never evicted");
+            Check(b && e.Width() == 16 && f.Bytes() == 100, "refs resolve");
+
+            TextureRef copy = b;
+            TextureRef moved = std::move(copy);
+            Check(!copy && moved.Get() == b.Get(), "copy and move keep the texture");
+            b.Reset();
+            Check(registry.Contains("b"), "still referenced through the moved copy");
+        }
+        Check(registry.TotalBytes() <= 250, "dropping the last refs trims to budget");
+
+        TextureRef g = insert("g", 50);
+        void* old = g.Get();
+        TextureRef again = insert("g", 80);
+        Check(g.Get() == again.Get() && g.Get() != old && !gpu.live.count(old), "replacing an id releases the old texture, refs follow");
+        Check(g.Bytes() == 80 && registry.TotalBytes() == gpu.liveBytes, "replacement is re-accounted");
+
+        Check(!registry.Acquire("missing"), "a missing id gives an empty ref");
+
+        g.Reset();
+        again.Reset();
+        registry.SetBudget(0);
+        Check(registry.Count() == 0 && gpu.live.empty(), "a zero budget releases everything unreferenced");
+        insert("h", 10);
+    }
+    Check(gpu.live.empty() && gpu.uploads == gpu.releases, "teardown releases what is left");
+}
+
+static uint32_t Next(uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+int main(int argc, char** argv) {
+    int assets = 400, frames = 20000;
+    double budgetMB = 32.0;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--assets" && hasValue) assets = atoi(argv[++i]);
+        else if (arg == "--budget" && hasValue) budgetMB = atof(argv[++i]);
+        else if (arg == "--frames" && hasValue) frames = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--assets N] [--budget MB] [--frames N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    ScriptedCases();
+
+    // icons to card art, roughly what a BC7 chain of each costs
+    std::vector<uint64_t> sizes(assets);
+    uint64_t allBytes = 0;
+    uint32_t seed = 7;
+    for (int i = 0; i < assets; i++) {
+        static const uint64_t kinds[] = { 1400, 5500, 22000, 87000, 350000, 1400000 };
+        sizes[i] = kinds[Next(seed) % 6];
+        allBytes += sizes[i];
+    }
+
+    FakeGpu gpu;
+    const uint64_t budget = (uint64_t)(budgetMB * 1048576.0);
+    uint64_t acquires = 0, misses = 0, peak = 0;
+    double acquireNs = 0.0;
+    {
+        TextureRegistry registry(budget, [&](void* t) { gpu.Release(t); });
+        std::vector<TextureRef> frame;
+        for (int f = 0; f < frames; f++) {
+            // a screen draws 20-60 textures, drawn from a skewed popularity
+            const int draws = 20 + (int)(Next(seed) % 41);
+            const auto start = std::chrono::steady_clock::now();
+            for (int d = 0; d < draws; d++) {
+                const double u = (Next(seed) & 0xFFFF) / 65536.0;
+                const int asset = (int)(assets * u * u * u);
+                const std::string id = "asset" + std::to_string(asset);
+                TextureRef ref = registry.Acquire(id);
+                if (!ref) {
+                    misses++;
+                    ref = registry.Insert(id, gpu.Create(sizes[asset]), sizes[asset], 64, 64);
+                }
+                frame.push_back(std::move(ref));
+            }
+            acquireNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            acquires += draws;
+            peak = std::max(peak, registry.TotalBytes());
+
+            frame.clear();
+            if (registry.TotalBytes() != gpu.liveBytes || registry.TotalBytes() > budget) {
+                fprintf(stderr, "FAIL: frame %d holds %llu bytes, gpu %llu, budget %llu\n", f, (unsigned long long)registry.TotalBytes(),
+                    (unsigned long long)gpu.liveBytes, (unsigned long long)budget);
+                failures++;
+                break;
+            }
+        }
+
+        printf("%d assets (%.1f MB all resident), budget %.1f MB, %d frames\n", assets, allBytes / 1048576.0, budgetMB, frames);
+        printf("  hit rate %.1f%%  uploads %llu  evictions %llu\n", 100.0 * (acquires - misses) / acquires, (unsigned long long)gpu.uploads,
+            (unsigned long long)registry.Evictions());
+        printf("  peak %.1f MB  %.0f ns per acquire (misses included)\n", peak / 1048576.0, acquireNs / acquires);
+    }
+    Check(gpu.live.empty(), "workload teardown releases everything");
+
+    if (failures) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
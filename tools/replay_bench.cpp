@@ -0,0 +1,174 @@
+// Captured frame replay benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 -pthread tools/replay_bench.cpp -o replay_bench
+//
+//   replay_bench CAPTURE [--threads N,N,...] [--repeat N] [--all] [--ppm FILE]
+//
+// Replays a DrawCapture file, written by the app with --capture or by
+// headless_bench, through SoftRaster, once per thread count (default 1 and
+// every core). Frames the capture recorded as repeats are skipped as the
+// renderers skip them, unless --all draws them too. Reports the capture's
+// contents, then per configuration the frames drawn and their p50/p95/max
+// time. --ppm writes the last frame drawn to FILE.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../draw_capture.h"
+#include "../soft_raster.h"
+
+static void WritePpm(const std::string& path, const uint8_t* rgba, int width, int height) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return;
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    for (size_t i = 0; i < (size_t)width * height; i++) fwrite(rgba + i * 4, 1, 3, file);
+    fclose(file);
+}
+
+static double Percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+}
+
+// What SoftwareRenderer::Render() builds from ImDrawData, from the capture
+static void BuildMeshes(const DrawCapture::Capture& capture, const DrawCapture::Frame& frame,
+    const std::unordered_map<uint32_t, SoftRaster::Texture>& textures, std::vector<SoftRaster::Mesh>& meshes) {
+    meshes.resize(frame.lists.size());
+    for (size_t i = 0; i < frame.lists.size(); i++) {
+        const DrawCapture::Frame::List& list = frame.lists[i];
+        SoftRaster::Mesh& mesh = meshes[i];
+        mesh.vertices = (const SoftRaster::Vertex*)list.vertices.data();
+        mesh.indices = list.indices.data();
+        mesh.indexSize = (int)capture.indexSize;
+        mesh.commands.clear();
+
+        SoftRaster::Blend blend = SoftRaster::Blend::Alpha;
+        for (const DrawCapture::Command& cmd : list.commands) {
+            switch ((DrawCapture::Callback)cmd.callback) {
+            case DrawCapture::Callback::ResetRenderState: blend = SoftRaster::Blend::Alpha; continue;
+            case DrawCapture::Callback::PremultipliedBlend: blend = SoftRaster::Blend::Premultiplied; continue;
+            case DrawCapture::Callback::Other: continue;
+            default: break;
+            }
+            if (cmd.clip[2] <= cmd.clip[0] || cmd.clip[3] <= cmd.clip[1]) continue;
+            const auto texture = textures.find(cmd.texture);
+            mesh.commands.push_back({ { cmd.clip[0], cmd.clip[1], cmd.clip[2], cmd.clip[3] },
+                texture != textures.end() ? &texture->second : nullptr, cmd.indexOffset, cmd.elementCount, cmd.vertexOffset, blend });
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path;
+    std::vector<unsigned> threadCounts;
+    int repeat = 1;
+    bool all = false;
+    std::string ppmPath;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--threads" && hasValue) {
+            for (const char* p = argv[++i]; *p;) {
+                char* end = nullptr;
+                const long count = strtol(p, &end, 10);
+                if (end == p) break;
+                threadCounts.push_back((unsigned)std::max(1L, count));
+                p = *end == ',' ? end + 1 : end;
+            }
+        }
+        else if (arg == "--repeat" && hasValue) repeat = std::max(1, atoi(argv[++i]));
+        else if (arg == "--all") all = true;
+        else if (arg == "--ppm" && hasValue) ppmPath = argv[++i];
+        else if (path.empty() && arg[0] != '-') path = arg;
+        else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        fprintf(stderr, "usage: %s CAPTURE [--threads N,N,...] [--repeat N] [--all] [--ppm FILE]\n", argv[0]);
+        return 2;
+    }
+    if (threadCounts.empty()) {
+        threadCounts = { 1 };
+        const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        if (cores > 1) threadCounts.push_back(cores);
+    }
+
+    DrawCapture::Capture capture;
+    const char* failureReason = nullptr;
+    if (!DrawCapture::Load(path, capture, failureReason)) {
+        fprintf(stderr, "%s: %s\n", path.c_str(), failureReason);
+        return 1;
+    }
+    if (capture.vertexSize != sizeof(SoftRaster::Vertex) || (capture.indexSize != 2 && capture.indexSize != 4)) {
+        fprintf(stderr, "%s: vertices of %u bytes and indices of %u don't match SoftRaster's layout\n", path.c_str(),
+            capture.vertexSize, capture.indexSize);
+        return 1;
+    }
+
+    // Textures recorded without pixels sample as opaque white, like a null texture
+    std::unordered_map<uint32_t, SoftRaster::Texture> textures;
+    uint64_t textureBytes = 0;
+    for (const auto& entry : capture.textures) {
+        if (entry.second.rgba.empty()) continue;
+        SoftRaster::Texture& texture = textures[entry.first];
+        texture.width = entry.second.width;
+        texture.height = entry.second.height;
+        texture.rgba = entry.second.rgba;
+        textureBytes += texture.rgba.size();
+    }
+
+    uint64_t vertices = 0, commands = 0;
+    for (const DrawCapture::Frame& frame : capture.frames) {
+        for (const DrawCapture::Frame::List& list : frame.lists) {
+            vertices += list.header.vertexCount;
+            commands += list.header.commandCount;
+        }
+    }
+    const double distinct = (double)std::max<size_t>(1, capture.frames.size());
+    printf("%s: %.2f MB, %zu frames (%zu distinct), %zu textures (%.2f MB of pixels), %.0f vertices and %.1f commands per frame\n",
+        path.c_str(), capture.fileBytes / 1048576.0, capture.sequence.size(), capture.frames.size(), capture.textures.size(),
+        textureBytes / 1048576.0, vertices / distinct, commands / distinct);
+    if (capture.sequence.empty()) return 0;
+
+    printf("%8s %8s %9s %9s %9s %10s\n", "threads", "frames", "p50", "p95", "max", "total");
+    std::vector<SoftRaster::Mesh> meshes;
+    for (size_t c = 0; c < threadCounts.size(); c++) {
+        SoftRaster::Rasterizer raster(threadCounts[c]);
+        std::vector<double> frameMs;
+        double totalMs = 0.0;
+        for (int r = 0; r < repeat; r++) {
+            for (size_t i = 0; i < capture.sequence.size(); i++) {
+                if (!all && i > 0 && capture.sequence[i] == capture.sequence[i - 1]) continue;
+                const DrawCapture::Frame& frame = capture.frames[capture.sequence[i]];
+                const DrawCapture::FrameHeader& header = frame.header;
+
+                const auto start = std::chrono::steady_clock::now();
+                const int width = (int)header.displaySize[0], height = (int)header.displaySize[1];
+                if (width != raster.Width() || height != raster.Height()) raster.Resize(width, height);
+                BuildMeshes(capture, frame, textures, meshes);
+                SoftRaster::Transform transform;
+                transform.offsetX = -header.displayPos[0];
+                transform.offsetY = -header.displayPos[1];
+                raster.Draw(meshes, header.clearColor, transform);
+                const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                frameMs.push_back(ms);
+                totalMs += ms;
+            }
+        }
+        printf("%8u %8zu %7.3fms %7.3fms %7.3fms %8.1fms\n", raster.ThreadCount(), frameMs.size() / repeat,
+            Percentile(frameMs, 0.5), Percentile(frameMs, 0.95), Percentile(frameMs, 1.0), totalMs / repeat);
+        if (c == 0 && !ppmPath.empty()) WritePpm(ppmPath, raster.Pixels(), raster.Width(), raster.Height());
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Mip-chain and resampling benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 -pthread tools/resample_bench.cpp -o resample_bench
+//
+//   resample_bench [--size WxH] [--source WxH] [--min-time SEC] [--threads N]
+//
+// Times ImageResample::BuildMipChain with each filter, single-threaded and
+// on a ThreadPool, and checks the box chain's first level against a plain
+// double-precision reference (exact sRGB transfer, per-pixel pow).
+//
+// Then downscales a --source image (default 3840x2160) to cover --size the
+// way the loader does, and compares the box pre-halving shortcut against a
+// single full-footprint pass.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../image_resample.h"
+#include "image_compare.h"
+
+using ImageResample::Filter;
+
+static std::vector<uint8_t> MakeImage(int width, int height) {
+    std::vector<uint8_t> rgba((size_t)width * height * 4);
+    uint32_t seed = 12345;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            uint8_t* p = &rgba[((size_t)y * width + x) * 4];
+            const bool stripe = (x / 3 + y / 3) % 2 == 0;  // fine detail that aliases without mips
+            p[0] = (uint8_t)(x * 255 / width);
+            p[1] = stripe ? 230 : 20;
+            p[2] = (uint8_t)(128 + 100 * sinf(x * 0.05f) * cosf(y * 0.04f) + (seed >> 29));
+            p[3] = ((x / 32 + y / 32) % 4 == 0) ? (uint8_t)(x * 255 / width) : 255;
+        }
+    }
+    return rgba;
+}
+
+static double SrgbToLinear(double c) { return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4); }
+static double LinearToSrgb(double l) { return l <= 0.0031308 ? l * 12.92 : 1.055 * pow(l, 1.0 / 2.4) - 0.055; }
+
+// Largest channel difference between level 1 of the chain and an exact 2x2 premultiplied box
+static int CheckBoxLevel(const std::vector<uint8_t>& src, int width, const ImageResample::Level& level) {
+    int worst = 0;
+    for (int y = 0; y < level.height; y++) {
+        for (int x = 0; x < level.width; x++) {
+            double sum[4] = {};
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    const uint8_t* p = &src[((size_t)(y * 2 + dy) * width + x * 2 + dx) * 4];
+                    const double a = p[3] / 255.0;
+                    for (int c = 0; c < 3; c++) sum[c] += SrgbToLinear(p[c] / 255.0) * a;
+                    sum[3] += a;
+                }
+            }
+            const uint8_t* q = &level.rgba[((size_t)y * level.width + x) * 4];
+            const double a = sum[3] / 4.0;
+            // colour is meaningless under (near-)zero alpha, so only compare where it survives quantization
+            for (int c = 0; c < 3 && a >= 8.0 / 255.0; c++) {
+                const int expected = (int)lround(std::clamp(LinearToSrgb(sum[c] / sum[3]), 0.0, 1.0) * 255.0);
+                worst = std::max(worst, abs(expected - q[c]));
+            }
+            worst = std::max(worst, abs((int)lround(a * 255.0) - q[3]));
+        }
+    }
+    return worst;
+}
+
+template<typename Body>
+static double MedianMs(double minTime, Body&& body) {
+    std::vector<double> samples;
+    const auto begin = std::chrono::steady_clock::now();
+    while (samples.size() < 3 || std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() < minTime) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    int width = 600, height = 400;
+    int sourceWidth = 3840, sourceHeight = 2160;
+    double minTime = 0.5;
+    unsigned threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) sscanf(argv[++i], "%dx%d", &width, &height);
+        else if (arg == "--source" && hasValue) sscanf(argv[++i], "%dx%d", &sourceWidth, &sourceHeight);
+        else if (arg == "--min-time" && hasValue) minTime = atof(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--size WxH] [--source WxH] [--min-time SEC] [--threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::vector<uint8_t> image = MakeImage(width, height);
+    ThreadPool pool(threads);
+    int failures = 0;
+
+    printf("%dx%d, %d levels, %u pool threads\n", width, height, ImageResample::MipCount(width, height), pool.ThreadCount());
+    printf("%-16s %10s %10s %10s\n", "mip chain", "1 thread", "pool", "MP/s");
+    for (Filter filter : { Filter::Box, Filter::Kaiser, Filter::Lanczos }) {
+        const char* name = filter == Filter::Box ? "box" : filter == Filter::Kaiser ? "kaiser" : "lanczos";
+        std::vector<ImageResample::Level> levels;
+        const double serial = MedianMs(minTime, [&] { levels = ImageResample::BuildMipChain(image.data(), width, height, filter); });
+        const double pooled = MedianMs(minTime, [&] { levels = ImageResample::BuildMipChain(image.data(), width, height, filter, true, &pool); });
+        printf("%-16s %8.2fms %8.2fms %10.1f\n", name, serial, pooled, (double)width * height / (pooled / 1000.0) / 1e6);
+
+        if (filter == Filter::Box && width % 2 == 0 && height % 2 == 0) {
+            const int worst = CheckBoxLevel(image, width, levels[0]);
+            printf("  box level 1 vs exact reference: max error %d\n", worst);
+            if (worst > 1) failures++;
+        }
+    }
+
+    int coverWidth = sourceWidth, coverHeight = sourceHeight;
+    if (ImageResample::CoverSize(sourceWidth, sourceHeight, width, height, coverWidth, coverHeight)) {
+        const std::vector<uint8_t> source = MakeImage(sourceWidth, sourceHeight);
+        ImageResample::Level scaled;
+        const double serial = MedianMs(minTime, [&] {
+            scaled = ImageResample::Downscale(source.data(), sourceWidth, sourceHeight, coverWidth, coverHeight, Filter::Lanczos);
+        });
+        const double pooled = MedianMs(minTime, [&] {
+            scaled = ImageResample::Downscale(source.data(), sourceWidth, sourceHeight, coverWidth, coverHeight, Filter::Lanczos, true, &pool);
+        });
+
+        // one pass over the full-resolution image, no box pre-halving
+        const ImageResample::LinearImage direct = ImageResample::Resample(
+            ImageResample::ToLinear(source.data(), sourceWidth, sourceHeight, true, &pool), coverWidth, coverHeight, Filter::Lanczos, &pool);
+        std::vector<uint8_t> reference((size_t)coverWidth * coverHeight * 4);
+        ImageResample::FromLinear(direct, true, reference.data(), &pool);
+
+        printf("\ndownscale %dx%d -> %dx%d (lanczos)\n", sourceWidth, sourceHeight, coverWidth, coverHeight);
+        printf("%-16s %8.2fms %8.2fms\n", "time", serial, pooled);
+        printf("  vs single pass: %.1f dB\n", ImageCompare::Psnr(scaled.rgba, reference));
+        printf("  texture memory with mips: %.1f MB -> %.1f MB\n",
+            sourceWidth * (double)sourceHeight * 4 * 4 / 3 / 1048576.0, coverWidth * (double)coverHeight * 4 * 4 / 3 / 1048576.0);
+    }
+
+    return failures ? 1 : 0;
+}
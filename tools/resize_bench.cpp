@@ -0,0 +1,132 @@
+// Swapchain resize policy benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 tools/resize_bench.cpp -o resize_bench
+//
+//   resize_bench [--transitions N] [--bucket PX]
+//
+// Replays ImGuiApp's window width animation (400 to 600 px and back, eased
+// 8% per 60 Hz frame and truncated to whole pixels as RenderUI does) through
+// ResizePolicy in each mode, and reports the buffer reallocations each
+// transition costs and the buffer memory held. Then checks over random
+// sizes that the buffers always cover the visible area, that Exact always
+// matches it and that Maximum never shrinks. Fails on any violation.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../resize_policy.h"
+
+// Widths RenderUI passes to Resize() while easing from one width to another
+static std::vector<int> WidthAnimation(float from, float to) {
+    std::vector<int> widths;
+    float current = from;
+    while (fabsf(current - to) > 0.5f) {
+        current += (to - current) * 0.08f;
+        widths.push_back((int)current);
+    }
+    return widths;
+}
+
+static const char* ModeName(ResizePolicy::Mode mode) {
+    switch (mode) {
+    case ResizePolicy::Mode::Exact: return "exact";
+    case ResizePolicy::Mode::Buckets: return "buckets";
+    default: return "maximum";
+    }
+}
+
+int main(int argc, char** argv) {
+    int transitions = 10;
+    int bucket = 128;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--transitions" && hasValue) transitions = std::max(1, atoi(argv[++i]));
+        else if (arg == "--bucket" && hasValue) bucket = std::max(1, atoi(argv[++i]));
+        else {
+            fprintf(stderr, "usage: %s [--transitions N] [--bucket PX]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::vector<int> widen = WidthAnimation(400.0f, 600.0f);
+    const std::vector<int> narrow = WidthAnimation(600.0f, 400.0f);
+    constexpr int Height = 400;
+    int failures = 0;
+
+    printf("%-8s %11s %12s %12s %10s %12s\n", "mode", "resizes", "first", "per trans.", "buffers", "peak memory");
+    for (const ResizePolicy::Mode mode : { ResizePolicy::Mode::Exact, ResizePolicy::Mode::Buckets, ResizePolicy::Mode::Maximum }) {
+        ResizePolicy::Options options;
+        options.mode = mode;
+        options.bucket = bucket;
+        options.maxWidth = 600;
+        options.maxHeight = Height;
+        ResizePolicy policy(options);
+        policy.Resize(400, Height);
+
+        uint64_t firstTransition = 0;
+        uint64_t peakBytes = 0;
+        for (int t = 0; t < transitions; t++) {
+            const uint64_t before = policy.GetStats().reallocations;
+            for (const int width : (t % 2 == 0) ? widen : narrow) {
+                policy.Resize(width, Height);
+                const ResizePolicy::Size allocated = policy.Allocated();
+                peakBytes = std::max(peakBytes, (uint64_t)allocated.width * allocated.height * 4 * 2);
+            }
+            if (t == 0) firstTransition = policy.GetStats().reallocations - before;
+        }
+
+        // the startup allocation is not part of any transition
+        const uint64_t reallocations = policy.GetStats().reallocations - 1;
+        const ResizePolicy::Size allocated = policy.Allocated();
+        printf("%-8s %11llu %12llu %12.2f %5dx%-4d %9.2f MB\n", ModeName(mode), (unsigned long long)policy.GetStats().resizes,
+            (unsigned long long)firstTransition, (double)reallocations / transitions, allocated.width, allocated.height,
+            peakBytes / 1048576.0);
+
+        if (mode == ResizePolicy::Mode::Maximum && reallocations != 0) {
+            fprintf(stderr, "maximum: %llu reallocations, expected none\n", (unsigned long long)reallocations);
+            failures++;
+        }
+        if (mode == ResizePolicy::Mode::Buckets && firstTransition > 2) {
+            fprintf(stderr, "buckets: %llu reallocations in the first transition\n", (unsigned long long)firstTransition);
+            failures++;
+        }
+    }
+
+    // Invariants over random sizes
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> size(1, 2000);
+    for (const ResizePolicy::Mode mode : { ResizePolicy::Mode::Exact, ResizePolicy::Mode::Buckets, ResizePolicy::Mode::Maximum }) {
+        ResizePolicy::Options options;
+        options.mode = mode;
+        options.bucket = bucket;
+        options.maxWidth = 600;
+        options.maxHeight = Height;
+        ResizePolicy policy(options);
+        ResizePolicy::Size previous;
+        int violations = 0;
+        for (int i = 0; i < 100000; i++) {
+            const int width = size(rng);
+            const int height = size(rng);
+            const bool reallocated = policy.Resize(width, height);
+            const ResizePolicy::Size allocated = policy.Allocated();
+            if (allocated.width < width || allocated.height < height) violations++;
+            if (mode == ResizePolicy::Mode::Exact && (allocated.width != width || allocated.height != height)) violations++;
+            if (mode == ResizePolicy::Mode::Maximum && (allocated.width < previous.width || allocated.height < previous.height)) violations++;
+            if (!reallocated && (allocated.width != previous.width || allocated.height != previous.height)) violations++;
+            previous = allocated;
+        }
+        if (violations) {
+            fprintf(stderr, "%s: %d invariant violations over random sizes\n", ModeName(mode), violations);
+            failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
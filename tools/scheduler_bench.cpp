@@ -0,0 +1,166 @@
+// Frame scheduler benchmark
+//
+// Standalone Linux tool, built from the repository root with:
+//   g++ -O2 -std=c++17 tools/scheduler_bench.cpp -o scheduler_bench
+//
+//   scheduler_bench [--refresh HZ] [--settle N]
+//
+// Drives FrameScheduler through ImGuiApp::Step()'s loop on a virtual clock,
+// with each drawn frame taking one vsync. The scenarios mirror the app: the
+// login page left alone, the mouse passing over a button whose hover fade
+// eases in and back out, a focused text field whose caret blinks, the
+// loading spinner, and texture loads waking the loop. Reports how many
+// frames each drew against a loop that draws every vsync, and fails if the
+// scheduler drew when it had no reason to or missed a frame it owed.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../animator.h"
+#include "../frame_scheduler.h"
+
+struct Scenario {
+    const char* name;
+    double duration;
+    std::vector<double> events;  // times input or a wake arrives
+    // Draws one frame at now: requests what the app would
+    std::function<void(FrameScheduler&, double now)> draw;
+    // Bounds on the frames the scheduler should draw
+    uint64_t minFrames;
+    uint64_t maxFrames;
+    const float* fade{ nullptr };  // must have settled back to 0 at the end
+};
+
+struct Result {
+    FrameScheduler::Stats stats;
+    double longestGap{ 0.0 };  // seconds between frames
+};
+
+// ImGuiApp::Step() with the platform's wait and clock replaced by the
+// virtual one: WaitEvents() jumps to the next event or the timeout, and a
+// frame ends on the next vsync
+static Result Simulate(const Scenario& scenario, double refresh, int settleFrames) {
+    FrameScheduler scheduler(settleFrames);
+    Result result;
+    const double vsync = 1.0 / refresh;
+    double now = 0.0;
+    double lastFrame = 0.0;
+    size_t nextEvent = 0;
+
+    while (now < scenario.duration) {
+        const double wait = scheduler.WaitTime(now);
+        if (wait > 0.0) {
+            const double eventTime = nextEvent < scenario.events.size() ? scenario.events[nextEvent] : FrameScheduler::Forever;
+            now = std::min(std::max(now, std::min(eventTime, now + wait)), scenario.duration);
+            if (now >= scenario.duration) break;
+        }
+
+        bool received = false;
+        while (nextEvent < scenario.events.size() && scenario.events[nextEvent] <= now) {
+            nextEvent++;
+            received = true;
+        }
+        if (received) scheduler.OnInput();
+
+        if (scheduler.FrameDue(now)) {
+            scheduler.BeginFrame(now);
+            scenario.draw(scheduler, now);
+            if (result.stats.frames) result.longestGap = std::max(result.longestGap, now - lastFrame);
+            result.stats = scheduler.GetStats();
+            lastFrame = now;
+            now += vsync;
+        }
+    }
+    result.stats = scheduler.GetStats();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    double refresh = 60.0;
+    int settleFrames = 3;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--refresh" && hasValue) refresh = std::max(1.0, atof(argv[++i]));
+        else if (arg == "--settle" && hasValue) settleFrames = std::max(1, atoi(argv[++i]));
+        else {
+            fprintf(stderr, "usage: %s [--refresh HZ] [--settle N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Frames the app's hover fade takes to settle from one end to the other
+    // at this refresh rate
+    int fadeFrames = 0;
+    {
+        Animator fade;
+        const Animator::Handle handle = fade.Add(0.0f, Animator::Curve::Ease, 0.15f);
+        fade.SetTarget(handle, 1.0f);
+        do {
+            fadeFrames++;
+        } while (fade.Update((float)(1.0 / refresh)));
+    }
+
+    // stepped as ImGuiApp::DrawFrame() does, by the time since the last frame
+    Animator animator;
+    const Animator::Handle hover = animator.Add(0.0f, Animator::Curve::Ease, 0.15f);
+    double lastDraw = -1.0;
+    float hoverAlpha = 0.0f;
+    bool hovered = false;
+    double loadingStart = 0.0;
+    const uint64_t settle = (uint64_t)settleFrames;
+
+    std::vector<Scenario> scenarios;
+    scenarios.push_back({ "idle", 10.0, {}, [](FrameScheduler&, double) {}, 0, 0 });
+    // the cursor enters the button at 1s and leaves at 3s
+    scenarios.push_back({ "hover fade", 5.0, { 1.0, 3.0 }, [&](FrameScheduler& scheduler, double now) {
+            animator.Update(lastDraw < 0.0 ? (float)(1.0 / refresh) : (float)std::min(now - lastDraw, 0.25));
+            lastDraw = now;
+            hovered = now >= 1.0 && now < 3.0;
+            hoverAlpha = animator.Toward(hover, hovered ? 1.0f : 0.0f);
+            if (!animator.Settled()) scheduler.RequestAnimationFrame();
+        }, 2 * (uint64_t)fadeFrames, 2 * ((uint64_t)fadeFrames + settle), &hoverAlpha });
+    // a click focuses the field at 0.5s, the caret then blinks for 4.5s
+    scenarios.push_back({ "caret blink", 5.0, { 0.5 }, [](FrameScheduler& scheduler, double now) {
+            scheduler.RequestFrameAt(now + 0.2);
+        }, 20, 30 });
+    // login at 0.5s, the spinner turns for 2.5s and the menu settles
+    scenarios.push_back({ "loading", 5.0, { 0.5 }, [&](FrameScheduler& scheduler, double now) {
+            if (loadingStart == 0.0) loadingStart = now;
+            if (now - loadingStart < 2.5) scheduler.RequestAnimationFrame();
+        }, (uint64_t)(2.5 * refresh) - 1, (uint64_t)(2.5 * refresh) + settle + 1 });
+    // three textures land while the login page is idle
+    scenarios.push_back({ "texture wakes", 5.0, { 0.25, 0.4, 2.0 }, [](FrameScheduler&, double) {}, 3, 3 * settle });
+
+    int failures = 0;
+    printf("%-14s %8s %8s %8s %8s %8s %8s %10s %12s\n", "scenario", "seconds", "frames", "input", "anim", "timer", "vsyncs",
+        "saved", "longest gap");
+    for (const Scenario& scenario : scenarios) {
+        animator.Set(hover, 0.0f);
+        lastDraw = -1.0;
+        hoverAlpha = 0.0f;
+        loadingStart = 0.0;
+        const Result result = Simulate(scenario, refresh, settleFrames);
+        const FrameScheduler::Stats& stats = result.stats;
+        const double vsyncs = scenario.duration * refresh;
+        printf("%-14s %8.1f %8llu %8llu %8llu %8llu %8.0f %9.1f%% %10.3fs\n", scenario.name, scenario.duration,
+            (unsigned long long)stats.frames, (unsigned long long)stats.inputFrames, (unsigned long long)stats.animationFrames,
+            (unsigned long long)stats.timerFrames, vsyncs, 100.0 * (1.0 - stats.frames / vsyncs), result.longestGap);
+        if (stats.frames < scenario.minFrames || stats.frames > scenario.maxFrames) {
+            fprintf(stderr, "%s: drew %llu frames, expected %llu..%llu\n", scenario.name, (unsigned long long)stats.frames,
+                (unsigned long long)scenario.minFrames, (unsigned long long)scenario.maxFrames);
+            failures++;
+        }
+        if (scenario.fade && *scenario.fade != 0.0f) {
+            fprintf(stderr, "%s: the fade stopped at %f instead of 0\n", scenario.name, *scenario.fade);
+            failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
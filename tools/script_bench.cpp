@@ -0,0 +1,164 @@
+// Scripted end-to-end benchmark
+//
+// Standalone Linux tool. It needs ImGui's core sources (no backends) and
+// is built from the repository root with, IMGUI being the ImGui v1.91.3
+// checkout described in README.md:
+//   g++ -O2 -std=c++17 -pthread -I $IMGUI tools/script_bench.cpp $IMGUI/imgui*.cpp -o script_bench
+//
+//   script_bench [SCRIPT] [--assets DIR]... [--repeat N] [--step SECONDS] [--software [--threads N]]
+//
+// Plays an InputScript (input_script.h; default tools/scripts/full_flow.txt)
+// into ImGuiApp on HeadlessPlatform, drawing a frame every --step of
+// virtual time (default 1/60), with NullRenderer or, with --software,
+// SoftwareRenderer. Reports per script phase the frames drawn, their
+// p50/p95/p99/max CPU time and the heap allocations made on the UI thread
+// while drawing them: operator new and ImGui's allocator, counted per
+// frame. Allocations on the texture loader's workers are not counted.
+// Fails when a frame doesn't show the page an expect line names, so a
+// script that stops reaching its pages can't go on reporting timings.
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../headless.h"
+#include "../software_renderer.h"
+#include "../app.h"
+
+static thread_local uint64_t threadAllocations = 0;
+static thread_local uint64_t threadAllocatedBytes = 0;
+
+static void* CountedAlloc(size_t size) {
+    threadAllocations++;
+    threadAllocatedBytes += size;
+    return malloc(size ? size : 1);
+}
+
+void* operator new(size_t size) {
+    if (void* p = CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+static void* ImGuiAlloc(size_t size, void*) { return CountedAlloc(size); }
+static void ImGuiFree(void* p, void*) { free(p); }
+
+struct Phase {
+    std::string name;
+    std::vector<double> frameMs;
+    uint64_t allocations{ 0 };
+    uint64_t allocatedBytes{ 0 };
+    uint64_t maxAllocations{ 0 };
+};
+
+static double Percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+}
+
+int main(int argc, char** argv) {
+    HeadlessPlatform::Options options;
+    options.assetDirectories.clear();
+    std::string scriptPath;
+    int repeat = 1;
+    bool software = false;
+    unsigned threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--assets" && hasValue) options.assetDirectories.push_back(argv[++i]);
+        else if (arg == "--repeat" && hasValue) repeat = std::max(1, atoi(argv[++i]));
+        else if (arg == "--step" && hasValue) options.frameStep = std::max(0.001, atof(argv[++i]));
+        else if (arg == "--software") software = true;
+        else if (arg == "--threads" && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else if (scriptPath.empty() && arg[0] != '-') scriptPath = arg;
+        else {
+            fprintf(stderr, "usage: %s [SCRIPT] [--assets DIR]... [--repeat N] [--step SECONDS] [--software [--threads N]]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (options.assetDirectories.empty()) options.assetDirectories = { "assets/fonts", "assets/images" };
+    if (scriptPath.empty()) scriptPath = "tools/scripts/full_flow.txt";
+
+    InputScript::Script script;
+    std::string failureReason;
+    if (!InputScript::Load(scriptPath, script, failureReason)) {
+        fprintf(stderr, "%s: %s\n", scriptPath.c_str(), failureReason.c_str());
+        return 1;
+    }
+    ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree);
+
+    // frames before the script's first phase line are reported as "start"
+    std::vector<Phase> phases(script.phases.size() + 1);
+    phases[0].name = "start";
+    for (size_t i = 0; i < script.phases.size(); i++) phases[i + 1].name = script.phases[i];
+
+    int failures = 0;
+    for (int run = 0; run < repeat; run++) {
+        HeadlessPlatform platform(options);
+        NullRenderer nullRenderer;
+        std::unique_ptr<SoftwareRenderer> softwareRenderer;
+        if (software) softwareRenderer = std::make_unique<SoftwareRenderer>(threads);
+        IRenderer& renderer = software ? (IRenderer&)*softwareRenderer : nullRenderer;
+        ImGuiApp app(platform, renderer);
+        if (!app.Initialize()) {
+            fprintf(stderr, "initialization failed\n");
+            return 1;
+        }
+
+        ScriptPlayer player(platform, script);
+        if (!player.Start(failureReason)) {
+            fprintf(stderr, "%s: %s\n", scriptPath.c_str(), failureReason.c_str());
+            return 1;
+        }
+        while (!player.Done()) {
+            player.Feed();
+            Phase& phase = phases[player.Phase() + 1];
+            const uint64_t allocationsBefore = threadAllocations;
+            const uint64_t bytesBefore = threadAllocatedBytes;
+            const auto start = std::chrono::steady_clock::now();
+            app.Frame();
+            phase.frameMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            const uint64_t allocations = threadAllocations - allocationsBefore;
+            phase.allocations += allocations;
+            phase.allocatedBytes += threadAllocatedBytes - bytesBefore;
+            phase.maxAllocations = std::max(phase.maxAllocations, allocations);
+
+            for (const InputScript::Action* expect : player.Expectations()) {
+                if (expect->text == app.PageName()) continue;
+                fprintf(stderr, "%s line %d: expected the %s page at %.2f s, found %s\n", scriptPath.c_str(), expect->line,
+                    expect->text.c_str(), expect->time, app.PageName());
+                failures++;
+            }
+        }
+        app.Cleanup();
+        const size_t liveTextures = software ? softwareRenderer->LiveTextures() : nullRenderer.LiveTextures();
+        if (liveTextures != 0) {
+            fprintf(stderr, "%zu textures still alive after cleanup\n", liveTextures);
+            failures++;
+        }
+    }
+
+    printf("%-12s %7s %9s %9s %9s %9s %12s %11s %10s\n", "phase", "frames", "p50", "p95", "p99", "max", "allocs/frame",
+        "max allocs", "KB/frame");
+    for (const Phase& phase : phases) {
+        if (phase.frameMs.empty()) continue;
+        const double count = (double)phase.frameMs.size();
+        printf("%-12s %7.0f %7.3fms %7.3fms %7.3fms %7.3fms %12.1f %11llu %10.2f\n", phase.name.c_str(), count / repeat,
+            Percentile(phase.frameMs, 0.5), Percentile(phase.frameMs, 0.95), Percentile(phase.frameMs, 0.99),
+            Percentile(phase.frameMs, 1.0), phase.allocations / count, (unsigned long long)phase.maxAllocations,
+            phase.allocatedBytes / count / 1024.0);
+    }
+    return failures ? 1 : 0;
+}
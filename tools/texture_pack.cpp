@@ -0,0 +1,273 @@
+// Texture packer: any image stb_image reads -> DDS or KTX2 ready for upload
+//
+// Standalone tool, built from the repository root with:
+//   g++ -O2 -std=c++17 -pthread tools/texture_pack.cpp -o texture_pack
+//
+//   texture_pack INPUT OUTPUT.dds|OUTPUT.ktx2 [--format auto|bc1|bc3|bc7|rgba8]
+//                [--mips kaiser|box|none] [--premultiply]
+//
+// auto picks BC1 for opaque images and BC7 otherwise, and the full mip chain
+// is built with the Kaiser filter, matching what the loader does at runtime.
+// --premultiply stores colour multiplied by alpha and flags it in the file
+// (DX10 alpha mode, KTX2 descriptor flag) so the loader blends it to match. The written file is parsed back with
+// texture_container.h before the tool reports success.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../stb_image.h"
+#include "../image_decode.h"
+#include "../bc_encoder.h"
+#include "../texture_container.h"
+#include "../image_resample.h"
+
+using Bytes = std::vector<uint8_t>;
+using TextureContainer::Format;
+
+struct Level {
+    uint32_t width{ 0 };
+    uint32_t height{ 0 };
+    Bytes data;  // encoded in the output format
+};
+
+static void Put32(Bytes& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back((uint8_t)(v >> (i * 8)));
+}
+
+static void Put64(Bytes& out, uint64_t v) {
+    Put32(out, (uint32_t)v);
+    Put32(out, (uint32_t)(v >> 32));
+}
+
+static void Set32(Bytes& out, size_t at, uint32_t v) {
+    for (int i = 0; i < 4; i++) out[at + i] = (uint8_t)(v >> (i * 8));
+}
+
+static Bytes WriteDds(Format format, bool premultiplied, const std::vector<Level>& levels) {
+    uint32_t dxgiFormat = 28;
+    switch (format) {
+    case Format::BC1: dxgiFormat = 71; break;
+    case Format::BC3: dxgiFormat = 77; break;
+    case Format::BC7: dxgiFormat = 98; break;
+    default: break;
+    }
+    const bool compressed = TextureContainer::IsBlockCompressed(format);
+    const bool hasMips = levels.size() > 1;
+
+    Bytes out;
+    Put32(out, TextureContainer::FourCC('D', 'D', 'S', ' '));
+    Put32(out, 124);
+    Put32(out, 0x1 | 0x2 | 0x4 | 0x1000 | (hasMips ? 0x20000 : 0) | (compressed ? 0x80000 : 0x8));
+    Put32(out, levels[0].height);
+    Put32(out, levels[0].width);
+    Put32(out, compressed ? (uint32_t)levels[0].data.size() : TextureContainer::RowPitch(format, levels[0].width));
+    Put32(out, 0);
+    Put32(out, (uint32_t)levels.size());
+    for (int i = 0; i < 11; i++) Put32(out, 0);
+
+    Put32(out, 32);
+    Put32(out, 0x4);
+    Put32(out, TextureContainer::FourCC('D', 'X', '1', '0'));
+    for (int i = 0; i < 5; i++) Put32(out, 0);
+
+    Put32(out, 0x1000 | (hasMips ? 0x8 | 0x400000 : 0));
+    for (int i = 0; i < 4; i++) Put32(out, 0);
+
+    Put32(out, dxgiFormat);
+    Put32(out, 3);
+    Put32(out, 0);
+    Put32(out, 1);
+    Put32(out, premultiplied ? 2 : 0);  // DDS_ALPHA_MODE_PREMULTIPLIED
+
+    for (const Level& level : levels) out.insert(out.end(), level.data.begin(), level.data.end());
+    return out;
+}
+
+// Basic data format descriptor, which the KTX2 spec requires
+static Bytes Ktx2Descriptor(Format format, bool premultiplied) {
+    struct Sample { uint32_t bitOffset, bitLength, channel, upper; };
+    Sample samples[4] = {};
+    uint32_t sampleCount = 1;
+    uint32_t model = 1;  // RGBSDA
+    uint32_t blockDim = 0;
+    uint32_t bytesPlane0 = 4;
+    switch (format) {
+    case Format::BC1:
+        model = 128;
+        samples[0] = { 0, 64, 0, 0xffffffff };
+        break;
+    case Format::BC3:
+        model = 130;
+        samples[0] = { 0, 64, 15, 0xffffffff };
+        samples[1] = { 64, 64, 0, 0xffffffff };
+        sampleCount = 2;
+        break;
+    case Format::BC7:
+        model = 134;
+        samples[0] = { 0, 128, 0, 0xffffffff };
+        break;
+    default:
+        for (uint32_t c = 0; c < 4; c++) samples[c] = { c * 8, 8, c == 3 ? 15u : c, 255 };
+        sampleCount = 4;
+        break;
+    }
+    if (TextureContainer::IsBlockCompressed(format)) {
+        blockDim = 3 | 3 << 8;
+        bytesPlane0 = TextureContainer::BlockBytes(format);
+    }
+
+    const uint32_t blockSize = 24 + 16 * sampleCount;
+    Bytes out;
+    Put32(out, 4 + blockSize);
+    Put32(out, 0);                                     // vendor 0 (Khronos), basic descriptor
+    Put32(out, 2 | blockSize << 16);                   // version 1.3
+    Put32(out, model | 1 << 8 | 1 << 16 | (premultiplied ? 1u : 0u) << 24);  // BT.709 primaries, linear transfer, alpha flag
+    Put32(out, blockDim);
+    Put32(out, bytesPlane0);
+    Put32(out, 0);
+    for (uint32_t i = 0; i < sampleCount; i++) {
+        const Sample& s = samples[i];
+        Put32(out, s.bitOffset | (s.bitLength - 1) << 16 | s.channel << 24);
+        Put32(out, 0);
+        Put32(out, 0);
+        Put32(out, s.upper);
+    }
+    return out;
+}
+
+static Bytes WriteKtx2(Format format, bool premultiplied, const std::vector<Level>& levels) {
+    uint32_t vkFormat = 37;
+    switch (format) {
+    case Format::BC1: vkFormat = 131; break;
+    case Format::BC3: vkFormat = 137; break;
+    case Format::BC7: vkFormat = 145; break;
+    default: break;
+    }
+
+    Bytes out(TextureContainer::Ktx2Identifier, TextureContainer::Ktx2Identifier + 12);
+    Put32(out, vkFormat);
+    Put32(out, 1);
+    Put32(out, levels[0].width);
+    Put32(out, levels[0].height);
+    Put32(out, 0);
+    Put32(out, 0);
+    Put32(out, 1);
+    Put32(out, (uint32_t)levels.size());
+    Put32(out, 0);
+
+    const Bytes dfd = Ktx2Descriptor(format, premultiplied);
+    const size_t indexOffset = out.size() + 32;
+    const size_t dfdOffset = indexOffset + levels.size() * 24;
+    Put32(out, (uint32_t)dfdOffset);
+    Put32(out, (uint32_t)dfd.size());
+    Put32(out, 0);
+    Put32(out, 0);
+    Put64(out, 0);
+    Put64(out, 0);
+    out.resize(dfdOffset);
+    out.insert(out.end(), dfd.begin(), dfd.end());
+
+    // level data is stored smallest mip first, each aligned to the block size
+    const size_t alignment = TextureContainer::IsBlockCompressed(format) ? TextureContainer::BlockBytes(format) : 4;
+    for (size_t i = levels.size(); i-- > 0;) {
+        out.resize((out.size() + alignment - 1) / alignment * alignment);
+        const size_t entry = indexOffset + i * 24;
+        Set32(out, entry, (uint32_t)out.size());
+        Set32(out, entry + 8, (uint32_t)levels[i].data.size());
+        Set32(out, entry + 16, (uint32_t)levels[i].data.size());
+        out.insert(out.end(), levels[i].data.begin(), levels[i].data.end());
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    std::string formatName = "auto", mipsName = "kaiser";
+    bool premultiply = false;
+    bool usage = argc < 3;
+    for (int i = 3; i < argc && !usage; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--format") == 0 && hasValue) formatName = argv[++i];
+        else if (strcmp(argv[i], "--mips") == 0 && hasValue) mipsName = argv[++i];
+        else if (strcmp(argv[i], "--premultiply") == 0) premultiply = true;
+        else usage = true;
+    }
+    if (usage || (mipsName != "kaiser" && mipsName != "box" && mipsName != "none")) {
+        fprintf(stderr, "usage: %s INPUT OUTPUT.dds|OUTPUT.ktx2 [--format auto|bc1|bc3|bc7|rgba8] [--mips kaiser|box|none] [--premultiply]\n", argv[0]);
+        return 2;
+    }
+    const std::string input = argv[1], output = argv[2];
+    const bool ktx2 = output.size() >= 5 && output.compare(output.size() - 5, 5, ".ktx2") == 0;
+
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* pixels = stbi_load(input.c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        fprintf(stderr, "%s: %s\n", input.c_str(), stbi_failure_reason());
+        return 1;
+    }
+
+    Format format;
+    if (formatName == "bc1") format = Format::BC1;
+    else if (formatName == "bc3") format = Format::BC3;
+    else if (formatName == "bc7") format = Format::BC7;
+    else if (formatName == "rgba8") format = Format::RGBA8;
+    else if (formatName == "auto") format = BcEncoder::HasAlpha(pixels, width, height) ? Format::BC7 : Format::BC1;
+    else {
+        fprintf(stderr, "unknown format %s\n", formatName.c_str());
+        stbi_image_free(pixels);
+        return 2;
+    }
+
+    ThreadPool pool;
+    const ImageResample::Alpha alpha = premultiply ? ImageResample::Alpha::Premultiplied : ImageResample::Alpha::Straight;
+    if (premultiply) ImageDecode::Premultiply(pixels, (size_t)width * height);
+    std::vector<ImageResample::Level> mips;
+    if (mipsName != "none") {
+        const ImageResample::Filter filter = mipsName == "box" ? ImageResample::Filter::Box : ImageResample::Filter::Kaiser;
+        mips = ImageResample::BuildMipChain(pixels, width, height, filter, true, &pool, alpha);
+    }
+
+    std::vector<Level> levels(1 + mips.size());
+    for (size_t i = 0; i < levels.size(); i++) {
+        const int w = i ? mips[i - 1].width : width;
+        const int h = i ? mips[i - 1].height : height;
+        const uint8_t* rgba = i ? mips[i - 1].rgba.data() : pixels;
+        levels[i].width = (uint32_t)w;
+        levels[i].height = (uint32_t)h;
+        if (format == Format::RGBA8) {
+            levels[i].data.assign(rgba, rgba + (size_t)w * h * 4);
+        }
+        else {
+            const BcEncoder::Format bc = format == Format::BC1 ? BcEncoder::Format::BC1
+                : format == Format::BC3 ? BcEncoder::Format::BC3 : BcEncoder::Format::BC7;
+            levels[i].data = BcEncoder::Encode(rgba, w, h, bc, &pool);
+        }
+    }
+    stbi_image_free(pixels);
+
+    const Bytes bytes = ktx2 ? WriteKtx2(format, premultiply, levels) : WriteDds(format, premultiply, levels);
+    TextureContainer::Layout layout;
+    const char* failureReason = nullptr;
+    if (!TextureContainer::Parse(bytes.data(), bytes.size(), layout, failureReason)) {
+        fprintf(stderr, "%s: written container does not parse: %s\n", output.c_str(), failureReason);
+        return 1;
+    }
+    if (layout.premultiplied != premultiply) {
+        fprintf(stderr, "%s: written container lost its alpha mode\n", output.c_str());
+        return 1;
+    }
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    file.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+    if (!file) {
+        fprintf(stderr, "%s: cannot write\n", output.c_str());
+        return 1;
+    }
+
+    printf("%s -> %s (%dx%d, %s, %zu levels, %zu bytes)\n", input.c_str(), output.c_str(), width, height,
+        formatName.c_str(), layout.levels.size(), bytes.size());
+    return 0;
+}